@@ -0,0 +1,130 @@
+#!/bin/bash
+#
+# Run each entry of a benchmark suite with -bench and report the median
+# emulation speed, optionally against a baseline executable.
+#
+# Usage: bench.sh [-runs <n>] <suite> <native MESS executable> [<baseline executable>]
+#
+# <suite> is the name of a tests/bench/*.bench file. For an A/B comparison,
+# build the baseline from the commit before the change being measured, e.g.
+# in a `git worktree`, and pass its executable as the third argument.
+#
+# Every JSON report is printed as it arrives, so the subsystem
+# microbenchmarks that -bench runs after emulation stops are kept as well.
+# Files the runs write, such as WAVs, go to build/bench.
+#
+
+# Where are the suites, the BIOS directory and the run output, relative to
+# the top of jsmess?
+SUITES=tests/bench
+BIOSDIR=bios
+OUTDIR=build/bench
+
+cd `dirname $0`/..
+
+RUNS=3
+if [ "$1" == "-runs" ]
+   then
+   RUNS=$2
+   shift 2
+fi
+
+SUITE=$1
+EXE=$2
+BASE=$3
+
+if [ "$SUITE" == "" ] || [ "$EXE" == "" ]
+   then
+   echo "Usage: $0 [-runs <n>] <suite> <native MESS executable> [<baseline executable>]"
+   exit 1
+fi
+
+# Relative paths are relative to where we were run from
+case $EXE in
+   /*) ;;
+   *) EXE=$OLDPWD/$EXE ;;
+esac
+case $BASE in
+   /*|"") ;;
+   *) BASE=$OLDPWD/$BASE ;;
+esac
+
+if [ ! -f $SUITES/$SUITE.bench ]
+   then
+   echo "No suite $SUITE in $SUITES."
+   exit 1
+fi
+
+for CHECK in $EXE $BASE
+   do
+   if [ ! -x $CHECK ]
+      then
+      echo "$CHECK is not a native MESS executable."
+      exit 1
+   fi
+done
+
+# A suite is a list of runs, one per line:
+#   <label> <driver> [arguments...]
+# where %LABEL% in the arguments is replaced by the label and %OUT% by the
+# output directory, and
+# SECONDS=<n> sets how many emulated seconds each run lasts, 30 by default.
+SECONDS_TO_RUN=`grep "^SECONDS=" $SUITES/$SUITE.bench | cut -d= -f2`
+SECONDS_TO_RUN=${SECONDS_TO_RUN:-30}
+
+# run_one <executable> <label> <driver> [arguments...]
+# prints the median speed_percent over $RUNS runs
+run_one() {
+   local RUNEXE=$1
+   local LABEL=$2
+   shift 2
+   local SPEEDS=""
+   for RUN in `seq $RUNS`
+      do
+      # the main report, plus any that subsystems print along the way
+      local REPORTS=`$RUNEXE $* -rompath $BIOSDIR -bench $SECONDS_TO_RUN -skip_gameinfo < /dev/null 2>/dev/null | grep "^{ \""`
+      local REPORT=`echo "$REPORTS" | grep "^{ \"system\""`
+      if [ "$REPORT" == "" ]
+         then
+         echo "$LABEL: no report from $RUNEXE" >&2
+         return 1
+      fi
+      echo "$REPORTS" | sed "s/^/$LABEL: /" >&2
+      SPEEDS="$SPEEDS `echo $REPORT | sed 's/.*"speed_percent": \([0-9.]*\).*/\1/'`"
+   done
+   echo $SPEEDS | tr ' ' '\n' | sort -n | sed -n "$(( (RUNS + 1) / 2 ))p"
+}
+
+mkdir -p $OUTDIR
+RESULT=0
+SUMMARY=""
+while read LABEL DRIVER ARGS
+   do
+   case $LABEL in
+      ""|"#"*|SECONDS=*) continue ;;
+   esac
+   ARGS=`echo $ARGS | sed "s|%LABEL%|$LABEL|g; s|%OUT%|$OUTDIR|g"`
+
+   # Suites may cover several subtargets; skip drivers this build lacks
+   if ! $EXE -listfull $DRIVER 2>/dev/null | grep -q "^$DRIVER "
+      then
+      echo "$LABEL: $DRIVER is not in this build, skipped" >&2
+      continue
+   fi
+
+   SPEED=`run_one $EXE $LABEL $DRIVER $ARGS` || { RESULT=1; continue; }
+   if [ "$BASE" == "" ]
+      then
+      SUMMARY="$SUMMARY$LABEL: $SPEED%\n"
+      continue
+   fi
+
+   BASESPEED=`run_one $BASE $LABEL-baseline $DRIVER $ARGS` || { RESULT=1; continue; }
+   CHANGE=`echo "$SPEED $BASESPEED" | awk '{ printf "%+.1f", ($1 / $2 - 1) * 100 }'`
+   SUMMARY="$SUMMARY$LABEL: $BASESPEED% -> $SPEED% ($CHANGE%)\n"
+done < $SUITES/$SUITE.bench
+
+echo
+echo "$SUITE: median speed of $RUNS runs of $SECONDS_TO_RUN emulated seconds"
+printf "%b" "$SUMMARY"
+exit $RESULT
@@ -0,0 +1,162 @@
+#!/bin/bash
+#
+# Boot a system from a fixed input log and check the hashes of its
+# framebuffer and audio against the golden values in tests/golden.
+#
+# Usage: golden.sh [-write | -serial | -ref <reference executable>] <system> <native MESS executable>
+#
+# <system> is the name of a make/systems/*.mak file. The executable must
+# be a native build of that system's SUBTARGET, e.g. the one left in
+# mess/ by `make SYSTEM=<system> NATIVE_DEBUG=1`.
+#
+# With -write, the hashes of the current build are recorded as the new
+# golden values instead of being checked.
+#
+# With -ref, the golden values are recorded afresh by the reference
+# executable, e.g. a build of the commit before a change that must not
+# alter the output, and the run's WAV files must match byte for byte too.
+# The reference must be recent enough to support -hashwrite.
+#
+# With -serial, the executable itself is the reference, run with
+# -nosound_threads, so the parallel sound stream update is checked against
+# the serial one in the same way.
+#
+
+# Where are the system makefiles, the golden files and the BIOS directory,
+# relative to the top of jsmess?
+JSMESSMAKE=make/systems
+GOLDEN=tests/golden
+BIOSDIR=bios
+
+cd `dirname $0`/..
+
+MODE=-hashverify
+REF=""
+REFARGS=""
+SERIAL=0
+if [ "$1" == "-write" ]
+   then
+   MODE=-hashwrite
+   shift
+elif [ "$1" == "-serial" ]
+   then
+   SERIAL=1
+   shift
+elif [ "$1" == "-ref" ]
+   then
+   REF=$2
+   shift 2
+fi
+
+SYSTEM=$1
+EXE=$2
+
+if [ "$SYSTEM" == "" ] || [ "$EXE" == "" ]
+   then
+   echo "Usage: $0 [-write | -serial | -ref <reference executable>] <system> <native MESS executable>"
+   exit 1
+fi
+
+# Relative paths are relative to where we were run from
+case $EXE in
+   /*) ;;
+   *) EXE=$OLDPWD/$EXE ;;
+esac
+case $REF in
+   /*|"") ;;
+   *) REF=$OLDPWD/$REF ;;
+esac
+if [ $SERIAL -eq 1 ]
+   then
+   REF=$EXE
+   REFARGS=-nosound_threads
+fi
+
+if [ ! -f $JSMESSMAKE/$SYSTEM.mak ]
+   then
+   echo "No makefile for $SYSTEM in $JSMESSMAKE."
+   exit 1
+fi
+
+for CHECK in $EXE $REF
+   do
+   if [ ! -x $CHECK ]
+      then
+      echo "$CHECK is not a native MESS executable."
+      echo "Build one with: make SYSTEM=$SYSTEM NATIVE_DEBUG=1"
+      exit 1
+   fi
+done
+
+# The driver name is the first of the MESS_ARGS
+DRIVER=`grep "^MESS_ARGS" $JSMESSMAKE/$SYSTEM.mak | sed 's/[^"]*"\([^"]*\)".*/\1/'`
+
+# Each golden run is described by up to three files:
+#   <system>.args - extra arguments, e.g. media to mount, with paths
+#                   relative to the top of jsmess (optional)
+#   <system>.inp  - input log to play back, from -record (optional)
+#   <system>.hsh  - checkpoint hashes, from -hashwrite
+# plus SECONDS=<n> in <system>.args to set how long the run lasts.
+SECONDS_TO_RUN=30
+ARGS=""
+if [ -f $GOLDEN/$SYSTEM.args ]
+   then
+   SECONDS_TO_RUN=`grep "^SECONDS=" $GOLDEN/$SYSTEM.args | cut -d= -f2`
+   SECONDS_TO_RUN=${SECONDS_TO_RUN:-30}
+   ARGS=`grep -v "^SECONDS=\|^#" $GOLDEN/$SYSTEM.args`
+fi
+
+PLAYBACK=""
+if [ -f $GOLDEN/$SYSTEM.inp ]
+   then
+   PLAYBACK="-playback $SYSTEM.inp"
+fi
+
+# -nosound keeps the full sample rate when hashing, so the audio hash
+# does not depend on whether the host has a sound card.
+# run <executable> <hash mode> <hash file> [extra arguments...]
+run() {
+   local RUNEXE=$1
+   local RUNMODE=$2
+   local RUNHASH=$3
+   shift 3
+   # osdmini builds have no -video option, and no window to keep closed
+   local VIDEO=""
+   if $RUNEXE -showconfig 2>/dev/null | grep -q "^video "
+      then
+      VIDEO="-video none"
+   fi
+   $RUNEXE $DRIVER -rompath $BIOSDIR -input_directory $GOLDEN $PLAYBACK \
+        $RUNMODE $RUNHASH -seconds_to_run $SECONDS_TO_RUN \
+        -nothrottle $VIDEO -nosound -skip_gameinfo $ARGS $*
+}
+
+if [ "$REF" != "" ]
+   then
+   # Hash files live in the input directory, so keep the reference run's
+   # hashes in the golden directory only for as long as this takes
+   REFTMP=`mktemp -d`
+   trap "rm -rf $REFTMP $GOLDEN/$SYSTEM-ref.hsh" EXIT
+   run $REF -hashwrite $SYSTEM-ref.hsh -wavwrite $REFTMP/ref.wav $REFARGS || { echo "$SYSTEM: reference run FAILED"; exit 1; }
+   run $EXE -hashverify $SYSTEM-ref.hsh -wavwrite $REFTMP/test.wav
+   RESULT=$?
+   if [ $RESULT -eq 0 ] && ! cmp -s $REFTMP/ref.wav $REFTMP/test.wav
+      then
+      echo "$SYSTEM: WAV output differs from the reference"
+      RESULT=1
+   fi
+elif [ "$MODE" == "-hashverify" ] && [ ! -f $GOLDEN/$SYSTEM.hsh ]
+   then
+   echo "No golden hashes for $SYSTEM; record them with: $0 -write $SYSTEM $2"
+   exit 1
+else
+   run $EXE $MODE $SYSTEM.hsh
+   RESULT=$?
+fi
+
+if [ $RESULT -ne 0 ]
+   then
+   echo "$SYSTEM: FAILED ($RESULT)"
+   exit $RESULT
+fi
+echo "$SYSTEM: OK"
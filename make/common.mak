@@ -53,6 +53,14 @@ TEMPLATE_FILES := $(foreach TFILE,$(TEMPLATE_FILES),$(TEMPLATE_DIR)/$(TFILE))
 # The name of the bitcode executable produced by making mess.
 MESS_EXE := mess$(SUBTARGET)
 
+# The native executable from a NATIVE_DEBUG build; MESS appends 64 to the name
+# on 64-bit hosts.
+ifeq ($(IS_64_BIT),1)
+NATIVE_EXE := mess/$(MESS_EXE)64
+else
+NATIVE_EXE := mess/$(MESS_EXE)
+endif
+
 ifeq ($(IS_64_BIT),1)
 NATIVE_OBJ := $(CURDIR)/mess/obj/sdl/nativemame64
 else
@@ -78,6 +78,7 @@ public:
 	drccodeptr near() const { return m_near; }
 	drccodeptr base() const { return m_base; }
 	drccodeptr top() const { return m_top; }
+	size_t size() const { return m_size; }
 
 	// pointer checking
 	bool contains_pointer(const void *ptr) const { return ((const drccodeptr)ptr >= m_near && (const drccodeptr)ptr < m_near + m_size); }
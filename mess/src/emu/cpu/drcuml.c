@@ -64,6 +64,7 @@
 ***************************************************************************/
 
 #include "emu.h"
+#include "emuopts.h"
 #include "drcuml.h"
 #include "drcbec.h"
 #include "drcbex86.h"
@@ -155,11 +156,30 @@ drcuml_state::drcuml_state(device_t &device, drc_cache &cache, UINT32 flags, int
 			*static_cast<drcbe_interface *>(auto_alloc(device.machine(), drcbe_native(*this, device, cache, flags, modes, addrbits, ignorebits)))),
 	  m_umllog(NULL),
 	  m_blocklist(device.machine().respool()),
-	  m_symlist(device.machine().respool())
+	  m_symlist(device.machine().respool()),
+	  m_profile(device.machine().options().drc_profile()),
+	  m_statslist(device.machine().respool()),
+	  m_curblock(NULL),
+	  m_compile_start(0),
+	  m_compile_ticks(0),
+	  m_compiles(0),
+	  m_aborts(0),
+	  m_flushes(0),
+	  m_flush_bytes(0)
 {
+	memset(m_statshash, 0, sizeof(m_statshash));
+
 	// if we're to log, create the logfile
 	if (flags & DRCUML_OPTION_LOG_UML)
 		m_umllog = fopen("drcuml.asm", "w");
+
+	// if we're profiling, report at exit while the device is still around
+	if (m_profile)
+		device.machine().add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(FUNC(drcuml_state::profile_report), this));
+
+	// otherwise, time the back-ends once if we are benchmarking
+	else if (device.machine().options().bench() > 0)
+		benchmark_backends();
 }
 
 
@@ -188,6 +208,13 @@ void drcuml_state::reset()
 	// if we error here, we are screwed
 	try
 	{
+		// note how full the cache was if this is a real flush
+		if (m_profile && m_cache.top() != m_cache.base())
+		{
+			m_flushes++;
+			m_flush_bytes += m_cache.top() - m_cache.base();
+		}
+
 		// flush the cache
 		m_cache.flush();
 
@@ -233,6 +260,11 @@ drcuml_block *drcuml_state::begin_block(UINT32 maxinst)
 		bestblock = &m_blocklist.append(*auto_alloc(m_device.machine(), drcuml_block(*this, maxinst * 3/2)));
 
 	// start the block
+	if (m_profile)
+	{
+		m_curblock = NULL;
+		m_compile_start = osd_ticks();
+	}
 	bestblock->begin();
 	return bestblock;
 }
@@ -289,6 +321,173 @@ const char *drcuml_state::symbol_find(void *base, UINT32 *offset)
 }
 
 
+//-------------------------------------------------
+//  profile_counter - find or create the statistics
+//  for a mode/pc entry point and return a pointer
+//  to its execution counter
+//-------------------------------------------------
+
+UINT64 *drcuml_state::profile_counter(UINT32 mode, UINT32 pc, bool blockstart)
+{
+	// look up the entry in the hash
+	block_stats **bucket = &m_statshash[(pc ^ (pc >> 12) ^ (mode << 8)) % STATS_HASH_SIZE];
+	block_stats *stats;
+	for (stats = *bucket; stats != NULL; stats = stats->m_hashnext)
+		if (stats->m_pc == pc && stats->m_mode == mode)
+			break;
+
+	// allocate a new one if not found; these live outside the cache so they survive flushes
+	if (stats == NULL)
+	{
+		stats = &m_statslist.append(*auto_alloc(m_device.machine(), block_stats(mode, pc)));
+		stats->m_hashnext = *bucket;
+		*bucket = stats;
+	}
+
+	// the first entry point in a block is charged with its compile
+	if (blockstart)
+	{
+		stats->m_compiles++;
+		m_curblock = stats;
+	}
+	return &stats->m_executions;
+}
+
+
+//-------------------------------------------------
+//  profile_block_end - account for the time spent
+//  compiling the current block
+//-------------------------------------------------
+
+void drcuml_state::profile_block_end(bool aborted)
+{
+	osd_ticks_t elapsed = osd_ticks() - m_compile_start;
+
+	m_compile_ticks += elapsed;
+	if (aborted)
+		m_aborts++;
+	else
+		m_compiles++;
+	if (m_curblock != NULL)
+		m_curblock->m_compile_ticks += elapsed;
+	m_curblock = NULL;
+}
+
+
+//-------------------------------------------------
+//  profile_compare - qsort callback to order
+//  statistics by descending execution count
+//-------------------------------------------------
+
+int drcuml_state::profile_compare(const void *item1, const void *item2)
+{
+	const block_stats *stats1 = *(const block_stats * const *)item1;
+	const block_stats *stats2 = *(const block_stats * const *)item2;
+	if (stats1->m_executions != stats2->m_executions)
+		return (stats1->m_executions > stats2->m_executions) ? -1 : 1;
+	return (stats1->m_compiles > stats2->m_compiles) ? -1 : (stats1->m_compiles < stats2->m_compiles) ? 1 : 0;
+}
+
+
+//-------------------------------------------------
+//  profile_report - print a summary of cache
+//  usage and the hottest entry points
+//-------------------------------------------------
+
+void drcuml_state::profile_report()
+{
+	const int MAX_REPORTED = 20;
+	double tps = (double)osd_ticks_per_second();
+
+	// summary line
+	mame_printf_info("DRC profile for '%s': %d blocks compiled in %.3f sec, %d aborted, %d cache flushes",
+			m_device.tag(), m_compiles, (double)m_compile_ticks / tps, m_aborts, m_flushes);
+	if (m_flushes != 0)
+		mame_printf_info(" (average %d of %d bytes in use)", (int)(m_flush_bytes / m_flushes), (int)m_cache.size());
+	mame_printf_info(", %d bytes in use at exit\n", (int)(m_cache.top() - m_cache.base()));
+
+	// gather and sort the entry points
+	int count = m_statslist.count();
+	if (count == 0)
+		return;
+	block_stats **sorted = global_alloc_array(block_stats *, count);
+	int index = 0;
+	for (block_stats *stats = m_statslist.first(); stats != NULL; stats = stats->next())
+		sorted[index++] = stats;
+	qsort(sorted, count, sizeof(sorted[0]), profile_compare);
+
+	// print the hottest ones, along with how often they were recompiled
+	mame_printf_info("  %-10s %-8s %12s %8s %12s\n", "mode", "pc", "executions", "compiles", "compile ms");
+	for (index = 0; index < count && index < MAX_REPORTED; index++)
+	{
+		const block_stats &stats = *sorted[index];
+		mame_printf_info("  %-10X %08X %12" I64FMT "u %8u %12.3f\n", stats.m_mode, stats.m_pc, stats.m_executions, stats.m_compiles, (double)stats.m_compile_ticks * 1000.0 / tps);
+	}
+	global_free(sorted);
+}
+
+
+//-------------------------------------------------
+//  benchmark_backends - report how fast the C
+//  and native back-ends run the same UML, as a
+//  line of JSON; done once per process, before
+//  the -bench timing starts
+//-------------------------------------------------
+
+void drcuml_state::benchmark_backends()
+{
+	static bool benchmarked = false;
+	if (benchmarked)
+		return;
+	benchmarked = true;
+
+	astring report;
+	report.printf("{ \"uml_instructions_per_second\": { \"c\": %.0f", benchmark_backend(DRCUML_OPTION_USE_C));
+#ifdef NATIVE_DRC
+	report.catprintf(", \"native\": %.0f", benchmark_backend(0));
+#endif
+	mame_printf_info("%s } }\n", report.cstr());
+}
+
+
+//-------------------------------------------------
+//  benchmark_backend - time a loop of common
+//  integer operations, ending in the compare and
+//  branch pair that the front-ends emit most, on
+//  a private cache and back-end
+//-------------------------------------------------
+
+double drcuml_state::benchmark_backend(UINT32 flags)
+{
+	const UINT32 iterations = 10000000;
+	const int instructions = 7;
+	drc_cache cache(4 * 1024 * 1024);
+	drcuml_state drcuml(m_device, cache, flags, 1, 32, 1);
+	drcuml.reset();
+
+	code_handle *entry = drcuml.handle_alloc("benchmark");
+	drcuml_block *block = drcuml.begin_block(16);
+	block->append().handle(*entry);
+	block->append().mov(I0, iterations);
+	block->append().mov(I1, 1);
+	block->append().label(1);
+	block->append().add(I1, I1, I0);
+	block->append()._xor(I2, I1, 0x5a5a5a5a);
+	block->append().shl(I2, I2, 3);
+	block->append()._and(I1, I1, I2);
+	block->append().sub(I0, I0, 1);
+	block->append().cmp(I0, 0);
+	block->append().jmp(COND_NZ, 1);
+	block->append().exit(0);
+	block->end();
+
+	osd_ticks_t start = osd_ticks();
+	drcuml.execute(*entry);
+	osd_ticks_t ticks = osd_ticks() - start;
+	return (ticks > 0) ? (double)iterations * instructions * (double)osd_ticks_per_second() / (double)ticks : 0;
+}
+
+
 //-------------------------------------------------
 //  log_printf - directly printf to the UML log
 //  if generated
@@ -364,6 +563,10 @@ void drcuml_block::end()
 	// optimize the resulting code first
 	optimize();
 
+	// if we're profiling, add execution counters
+	if (m_drcuml.profiling())
+		instrument();
+
 	// if we have a logfile, generate a disassembly of the block
 	if (m_drcuml.logging())
 		disassemble();
@@ -373,6 +576,8 @@ void drcuml_block::end()
 
 	// block is no longer in use
 	m_inuse = false;
+	if (m_drcuml.profiling())
+		m_drcuml.profile_block_end(false);
 }
 
 
@@ -386,6 +591,8 @@ void drcuml_block::abort()
 
 	// block is no longer in use
 	m_inuse = false;
+	if (m_drcuml.profiling())
+		m_drcuml.profile_block_end(true);
 
 	// unwind
 	throw abort_compilation();
@@ -479,6 +686,43 @@ void drcuml_block::optimize()
 }
 
 
+//-------------------------------------------------
+//  instrument - follow each hash table entry
+//  point with an increment of its execution
+//  counter
+//-------------------------------------------------
+
+void drcuml_block::instrument()
+{
+	// count the entry points; if there isn't room for the counters, leave the block alone
+	int entries = 0;
+	for (int instnum = 0; instnum < m_nextinst; instnum++)
+		if (m_inst[instnum].opcode() == OP_HASH)
+			entries++;
+	if (entries == 0 || m_nextinst + entries > m_maxinst)
+		return;
+
+	// work backwards, spreading the instructions out as we go
+	int total = m_nextinst + entries;
+	int dest = total;
+	for (int instnum = m_nextinst - 1; instnum >= 0; instnum--)
+	{
+		const instruction &inst = m_inst[instnum];
+		if (inst.opcode() == OP_HASH)
+		{
+			// counters never feed flags to anything downstream
+			UINT64 *counter = m_drcuml.profile_counter(inst.param(0).immediate(), inst.param(1).immediate(), --entries == 0);
+			instruction &count = m_inst[--dest];
+			count.dadd(parameter::make_memory(counter), parameter::make_memory(counter), 1);
+			count.set_flags(0);
+		}
+		m_inst[--dest] = inst;
+	}
+	assert(dest == 0);
+	m_nextinst = total;
+}
+
+
 //-------------------------------------------------
 //  disassemble - disassemble a block of
 //  instructions to the log
@@ -153,6 +153,7 @@ private:
 	// internal helpers
 	void optimize();
 	void disassemble();
+	void instrument();
 	const char *get_comment_text(const uml::instruction &inst, astring &comment);
 
 	// internal state
@@ -227,7 +228,53 @@ public:
 	void log_printf(const char *format, ...);
 	void log_flush() { if (logging()) fflush(m_umllog); }
 
+	// profiling
+	bool profiling() const { return m_profile; }
+	UINT64 *profile_counter(UINT32 mode, UINT32 pc, bool blockstart);
+	void profile_block_end(bool aborted);
+
 private:
+	// per-entry-point statistics, kept across cache flushes
+	class block_stats
+	{
+		friend class drcuml_state;
+		friend class simple_list<block_stats>;
+
+		// construction/destruction
+		block_stats(UINT32 mode, UINT32 pc)
+			: m_next(NULL),
+			  m_hashnext(NULL),
+			  m_mode(mode),
+			  m_pc(pc),
+			  m_executions(0),
+			  m_compiles(0),
+			  m_compile_ticks(0) { }
+
+	public:
+		// getters
+		block_stats *next() const { return m_next; }
+
+	private:
+		// internal state
+		block_stats *			m_next;				// link to the next entry
+		block_stats *			m_hashnext;			// link to the next entry in the hash bucket
+		UINT32					m_mode;				// mode of the entry point
+		UINT32					m_pc;				// PC of the entry point
+		UINT64					m_executions;		// number of times entered; updated by generated code
+		UINT32					m_compiles;			// number of times a block starting here was compiled
+		osd_ticks_t				m_compile_ticks;	// total time spent compiling those blocks
+	};
+
+	static const int STATS_HASH_SIZE = 4096;
+
+	// profiling helpers
+	static int profile_compare(const void *item1, const void *item2);
+	void profile_report();
+
+	// benchmarking helpers
+	void benchmark_backends();
+	double benchmark_backend(UINT32 flags);
+
 	// symbol class
 	class symbol
 	{
@@ -261,6 +308,18 @@ private:
 	simple_list<drcuml_block>	m_blocklist;		// list of active blocks
 	simple_list<uml::code_handle> m_handlelist;		// list of active handles
 	simple_list<symbol>			m_symlist;			// list of symbols
+
+	// profiling
+	bool						m_profile;			// are we profiling?
+	simple_list<block_stats>	m_statslist;		// list of per-entry statistics
+	block_stats *				m_statshash[STATS_HASH_SIZE]; // hash of per-entry statistics by mode/pc
+	block_stats *				m_curblock;			// statistics for the block being compiled
+	osd_ticks_t					m_compile_start;	// start time of the block being compiled
+	osd_ticks_t					m_compile_ticks;	// total time spent compiling
+	UINT32						m_compiles;			// total number of blocks compiled
+	UINT32						m_aborts;			// number of compiles aborted for lack of space
+	UINT32						m_flushes;			// number of times the cache was flushed
+	size_t						m_flush_bytes;		// total bytes in use at the time of those flushes
 };
 
 
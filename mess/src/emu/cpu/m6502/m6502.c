@@ -71,6 +71,7 @@ struct _m6502_Regs
 	device_irq_callback irq_callback;
 	legacy_cpu_device *device;
 	address_space *space;
+	fast_address_space<UINT8, ENDIANNESS_LITTLE> fastspace;
 	direct_read_data *direct;
 	address_space *io;
 	int		int_occured;
@@ -138,6 +139,7 @@ static void m6502_common_init(legacy_cpu_device *device, device_irq_callback irq
 	cpustate->irq_callback = irqcallback;
 	cpustate->device = device;
 	cpustate->space = device->space(AS_PROGRAM);
+	cpustate->fastspace.bind(*cpustate->space);
 	cpustate->direct = &cpustate->space->direct();
 	cpustate->subtype = subtype;
 	cpustate->insn = insn;
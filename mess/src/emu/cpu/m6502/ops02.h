@@ -81,12 +81,12 @@
 /***************************************************************
  *  RDMEM   read memory
  ***************************************************************/
-#define RDMEM(addr) cpustate->space->read_byte(addr); cpustate->icount -= 1
+#define RDMEM(addr) cpustate->fastspace.read_byte(addr); cpustate->icount -= 1
 
 /***************************************************************
  *  WRMEM   write memory
  ***************************************************************/
-#define WRMEM(addr,data) cpustate->space->write_byte(addr,data); cpustate->icount -= 1
+#define WRMEM(addr,data) cpustate->fastspace.write_byte(addr,data); cpustate->icount -= 1
 
 /***************************************************************
  *  BRA  branch relative
@@ -1079,6 +1079,7 @@ UINT16 m68k_memory_interface::m68008_read_immediate_16(offs_t address)
 void m68k_memory_interface::init8(address_space &space)
 {
 	m_space = &space;
+	use_fast16 = false;
 	m_direct = &space.direct();
 	m_cpustate = get_safe_token(&space.device());
 	opcode_xor = 0;
@@ -1109,6 +1110,8 @@ UINT16 m68k_memory_interface::simple_read_immediate_16(offs_t address)
 void m68k_memory_interface::init16(address_space &space)
 {
 	m_space = &space;
+	use_fast16 = true;
+	fast16.bind(space);
 	m_direct = &space.direct();
 	m_cpustate = get_safe_token(&space.device());
 	opcode_xor = 0;
@@ -1130,6 +1133,7 @@ void m68k_memory_interface::init16(address_space &space)
 void m68k_memory_interface::init32(address_space &space)
 {
 	m_space = &space;
+	use_fast16 = false;
 	m_direct = &space.direct();
 	m_cpustate = get_safe_token(&space.device());
 	opcode_xor = WORD_XOR_BE(0);
@@ -1348,6 +1352,7 @@ void m68k_memory_interface::writelong_d32_mmu(offs_t address, UINT32 data)
 void m68k_memory_interface::init32mmu(address_space &space)
 {
 	m_space = &space;
+	use_fast16 = false;
 	m_direct = &space.direct();
 	m_cpustate = get_safe_token(&space.device());
 	opcode_xor = WORD_XOR_BE(0);
@@ -1475,6 +1480,7 @@ void m68k_memory_interface::writelong_d32_hmmu(offs_t address, UINT32 data)
 void m68k_memory_interface::init32hmmu(address_space &space)
 {
 	m_space = &space;
+	use_fast16 = false;
 	m_direct = &space.direct();
 	m_cpustate = get_safe_token(&space.device());
 	opcode_xor = WORD_XOR_BE(0);
@@ -572,6 +572,9 @@ public:
 	m68k_write16_delegate write16;
 	m68k_write32_delegate write32;
 
+	bool	use_fast16;						// 16-bit bus: use the inlined accessors below
+	fast_address_space<UINT16, ENDIANNESS_BIG> fast16;
+
 private:
 	UINT16 m68008_read_immediate_16(offs_t address);
 	UINT16 read_immediate_16(offs_t address);
@@ -1001,6 +1004,8 @@ INLINE UINT32 m68ki_read_8_fc(m68ki_cpu_core *m68k, UINT32 address, UINT32 fc)
 {
 	m68k->mmu_tmp_fc = fc;
 	m68k->mmu_tmp_rw = 1;
+	if (m68k->memory.use_fast16)
+		return m68k->memory.fast16.read_byte(address);
 	return m68k->memory.read8(address);
 }
 INLINE UINT32 m68ki_read_16_fc(m68ki_cpu_core *m68k, UINT32 address, UINT32 fc)
@@ -1011,6 +1016,8 @@ INLINE UINT32 m68ki_read_16_fc(m68ki_cpu_core *m68k, UINT32 address, UINT32 fc)
 	}
 	m68k->mmu_tmp_fc = fc;
 	m68k->mmu_tmp_rw = 1;
+	if (m68k->memory.use_fast16)
+		return m68k->memory.fast16.read_word(address);
 	return m68k->memory.read16(address);
 }
 INLINE UINT32 m68ki_read_32_fc(m68ki_cpu_core *m68k, UINT32 address, UINT32 fc)
@@ -1021,6 +1028,8 @@ INLINE UINT32 m68ki_read_32_fc(m68ki_cpu_core *m68k, UINT32 address, UINT32 fc)
 	}
 	m68k->mmu_tmp_fc = fc;
 	m68k->mmu_tmp_rw = 1;
+	if (m68k->memory.use_fast16)
+		return m68k->memory.fast16.read_dword(address);
 	return m68k->memory.read32(address);
 }
 
@@ -1028,7 +1037,10 @@ INLINE void m68ki_write_8_fc(m68ki_cpu_core *m68k, UINT32 address, UINT32 fc, UI
 {
 	m68k->mmu_tmp_fc = fc;
 	m68k->mmu_tmp_rw = 0;
-	m68k->memory.write8(address, value);
+	if (m68k->memory.use_fast16)
+		m68k->memory.fast16.write_byte(address, value);
+	else
+		m68k->memory.write8(address, value);
 }
 INLINE void m68ki_write_16_fc(m68ki_cpu_core *m68k, UINT32 address, UINT32 fc, UINT32 value)
 {
@@ -1038,7 +1050,10 @@ INLINE void m68ki_write_16_fc(m68ki_cpu_core *m68k, UINT32 address, UINT32 fc, U
 	}
 	m68k->mmu_tmp_fc = fc;
 	m68k->mmu_tmp_rw = 0;
-	m68k->memory.write16(address, value);
+	if (m68k->memory.use_fast16)
+		m68k->memory.fast16.write_word(address, value);
+	else
+		m68k->memory.write16(address, value);
 }
 INLINE void m68ki_write_32_fc(m68ki_cpu_core *m68k, UINT32 address, UINT32 fc, UINT32 value)
 {
@@ -1048,7 +1063,10 @@ INLINE void m68ki_write_32_fc(m68ki_cpu_core *m68k, UINT32 address, UINT32 fc, U
 	}
 	m68k->mmu_tmp_fc = fc;
 	m68k->mmu_tmp_rw = 0;
-	m68k->memory.write32(address, value);
+	if (m68k->memory.use_fast16)
+		m68k->memory.fast16.write_dword(address, value);
+	else
+		m68k->memory.write32(address, value);
 }
 
 /* Special call to simulate undocumented 68k behavior when move.l with a
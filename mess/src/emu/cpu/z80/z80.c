@@ -158,7 +158,13 @@ struct _z80_state
 	device_irq_callback irq_callback;
 	legacy_cpu_device *device;
 	address_space *program;
+	fast_address_space<UINT8, ENDIANNESS_LITTLE> fastprogram;
 	direct_read_data *direct;
+	const UINT8 *	opdecrypted;		/* opdecrypted[pc] is the opcode at pc within the window */
+	const UINT8 *	opraw;				/* opraw[pc] is the argument at pc within the window */
+	offs_t			opstart;			/* first address of the resolved opcode window */
+	offs_t			opend;				/* last address of the resolved opcode window */
+	UINT32			opgeneration;		/* direct region generation the window was resolved from */
 	address_space *io;
 	int				icount;
 	z80_daisy_chain daisy;
@@ -613,7 +619,7 @@ INLINE void BURNODD(z80_state *z80, int cycles, int opcodes, int cyclesum)
 /***************************************************************
  * Read a byte from given memory location
  ***************************************************************/
-#define RM(Z,addr)			(Z)->program->read_byte(addr)
+#define RM(Z,addr)			(Z)->fastprogram.read_byte(addr)
 
 /***************************************************************
  * Read a word from given memory location
@@ -627,7 +633,7 @@ INLINE void RM16(z80_state *z80, UINT32 addr, PAIR *r)
 /***************************************************************
  * Write a byte to given memory location
  ***************************************************************/
-#define WM(Z,addr,value)	(Z)->program->write_byte(addr, value)
+#define WM(Z,addr,value)	(Z)->fastprogram.write_byte(addr, value)
 
 /***************************************************************
  * Write a word to given memory location
@@ -638,28 +644,68 @@ INLINE void WM16(z80_state *z80, UINT32 addr, PAIR *r)
 	WM(z80, (addr+1)&0xffff, r->b.h);
 }
 
+/***************************************************************
+ * Resolve the opcode window around pc: the run of addresses
+ * that map linearly onto the current direct region, so that
+ * fetches inside it are a single host pointer access. Returns
+ * FALSE (and an empty window) if pc is not directly readable.
+ ***************************************************************/
+static int update_opwindow(z80_state *z80, unsigned pc)
+{
+	direct_read_data *direct = z80->direct;
+	const UINT8 *decrypted = (const UINT8 *)direct->read_decrypted_ptr(pc);
+	if (decrypted == NULL)
+	{
+		z80->opstart = 1;
+		z80->opend = 0;
+		return FALSE;
+	}
+
+	/* the region is linear until the byte mask wraps */
+	offs_t mask = direct->bytemask();
+	z80->opstart = MAX(direct->bytestart(), pc & ~mask);
+	z80->opend = MIN(direct->byteend(), pc | mask);
+	z80->opdecrypted = decrypted - pc;
+	z80->opraw = (const UINT8 *)direct->read_raw_ptr(pc) - pc;
+	z80->opgeneration = direct->generation();
+	return TRUE;
+}
+
 /***************************************************************
  * ROP() is identical to RM() except it is used for
  * reading opcodes. In case of system with memory mapped I/O,
- * this function can be used to greatly speed up emulation
+ * this function can be used to greatly speed up emulation.
+ * The window is revalidated here on every opcode, so a bank
+ * switch is always seen by the next instruction.
  ***************************************************************/
 INLINE UINT8 ROP(z80_state *z80)
 {
 	unsigned pc = z80->PCD;
 	z80->PC++;
-	return z80->direct->read_decrypted_byte(pc);
+	if (EXPECTED(pc >= z80->opstart && pc <= z80->opend && z80->opgeneration == z80->direct->generation()))
+		return z80->opdecrypted[pc];
+	if (update_opwindow(z80, pc))
+		return z80->opdecrypted[pc];
+
+	/* not directly readable; the region was just looked up, so go straight to the handlers */
+	return z80->program->read_byte(pc);
 }
 
 /****************************************************************
  * ARG(z80) is identical to ROP() except it is used
  * for reading opcode arguments. This difference can be used to
  * support systems that use different encoding mechanisms for
- * opcodes and opcode arguments
+ * opcodes and opcode arguments.
+ * Arguments are always fetched after their opcode and before
+ * the instruction touches memory or I/O, so the window checked
+ * by ROP() is still current and only the bounds are tested.
  ***************************************************************/
 INLINE UINT8 ARG(z80_state *z80)
 {
 	unsigned pc = z80->PCD;
 	z80->PC++;
+	if (EXPECTED(pc >= z80->opstart && pc <= z80->opend))
+		return z80->opraw[pc];
 	return z80->direct->read_raw_byte(pc);
 }
 
@@ -667,6 +713,8 @@ INLINE UINT32 ARG16(z80_state *z80)
 {
 	unsigned pc = z80->PCD;
 	z80->PC += 2;
+	if (EXPECTED(pc >= z80->opstart && pc < z80->opend))
+		return z80->opraw[pc] | (z80->opraw[pc + 1] << 8);
 	return z80->direct->read_raw_byte(pc) | (z80->direct->read_raw_byte((pc+1)&0xffff) << 8);
 }
 
@@ -3482,7 +3530,10 @@ static CPU_INIT( z80 )
 	z80->irq_callback = irqcallback;
 	z80->device = device;
 	z80->program = device->space(AS_PROGRAM);
+	z80->fastprogram.bind(*z80->program);
 	z80->direct = &z80->program->direct();
+	z80->opstart = 1;
+	z80->opend = 0;
 	z80->io = device->space(AS_IO);
 	z80->IX = z80->IY = 0xffff; /* IX and IY are FFFF after a reset! */
 	z80->F = ZF;			/* Zero flag is set */
@@ -89,6 +89,7 @@ EMUOBJS = \
 	$(EMUOBJ)/rendfont.o \
 	$(EMUOBJ)/rendlay.o \
 	$(EMUOBJ)/rendutil.o \
+	$(EMUOBJ)/rewind.o \
 	$(EMUOBJ)/romload.o \
 	$(EMUOBJ)/save.o \
 	$(EMUOBJ)/schedule.o \
@@ -81,26 +81,36 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_SNAPSHOT_DIRECTORY,                         "snap",      OPTION_STRING,     "directory to save screenshots" },
 	{ OPTION_DIFF_DIRECTORY,                             "diff",      OPTION_STRING,     "directory to save hard drive image difference files" },
 	{ OPTION_COMMENT_DIRECTORY,                          "comments",  OPTION_STRING,     "directory to save debugger comments" },
+	{ OPTION_INDEX_DIRECTORY,                            "index",     OPTION_STRING,     "directory to save precompiled software list and hash file indexes" },
 
 	// state/playback options
 	{ NULL,                                              NULL,        OPTION_HEADER,     "CORE STATE/PLAYBACK OPTIONS" },
 	{ OPTION_STATE,                                      NULL,        OPTION_STRING,     "saved state to load" },
 	{ OPTION_AUTOSAVE,                                   "0",         OPTION_BOOLEAN,    "enable automatic restore at startup, and automatic save at exit time" },
+	{ OPTION_STATE_DELTAS "(0-255)",                     "0",         OPTION_INTEGER,    "number of saves over the same state that write only what changed before writing it in full again" },
 	{ OPTION_PLAYBACK ";pb",                             NULL,        OPTION_STRING,     "playback an input file" },
 	{ OPTION_RECORD ";rec",                              NULL,        OPTION_STRING,     "record an input file" },
 	{ OPTION_MNGWRITE,                                   NULL,        OPTION_STRING,     "optional filename to write a MNG movie of the current session" },
 	{ OPTION_AVIWRITE,                                   NULL,        OPTION_STRING,     "optional filename to write an AVI movie of the current session" },
 	{ OPTION_WAVWRITE,                                   NULL,        OPTION_STRING,     "optional filename to write a WAV file of the current session" },
+	{ OPTION_HASHWRITE,                                  NULL,        OPTION_STRING,     "optional filename to write framebuffer and audio hashes of the current session" },
+	{ OPTION_HASHVERIFY,                                 NULL,        OPTION_STRING,     "optional filename of hashes written by -hashwrite to check the current session against" },
+	{ OPTION_HASH_INTERVAL "(1-3600)",                   "1",         OPTION_INTEGER,    "number of emulated seconds between output hashes" },
 	{ OPTION_SNAPNAME,                                   "%g/%i",     OPTION_STRING,     "override of the default snapshot/movie naming; %g == gamename, %i == index" },
 	{ OPTION_SNAPSIZE,                                   "auto",      OPTION_STRING,     "specify snapshot/movie resolution (<width>x<height>) or 'auto' to use minimal size " },
 	{ OPTION_SNAPVIEW,                                   "internal",  OPTION_STRING,     "specify snapshot/movie view or 'internal' to use internal pixel-aspect views" },
 	{ OPTION_BURNIN,                                     "0",         OPTION_BOOLEAN,    "create burn-in snapshots for each screen" },
+	{ OPTION_REWIND,                                     "0",         OPTION_BOOLEAN,    "keep a history of recent states that can be stepped back through" },
+	{ OPTION_REWIND_MEMORY "(1-2047)",                   "32",        OPTION_INTEGER,    "memory, in megabytes, to devote to the rewind history" },
+	{ OPTION_REWIND_INTERVAL,                            "1",         OPTION_INTEGER,    "number of frames between rewind snapshots" },
+	{ OPTION_REWIND_COMPRESSION "(0-9)",                 "1",         OPTION_INTEGER,    "zlib compression level for rewind snapshots, 0-9" },
 
 	// performance options
 	{ NULL,                                              NULL,        OPTION_HEADER,     "CORE PERFORMANCE OPTIONS" },
 	{ OPTION_AUTOFRAMESKIP ";afs",                       "0",         OPTION_BOOLEAN,    "enable automatic frameskip selection" },
 	{ OPTION_FRAMESKIP ";fs(0-10)",                      "0",         OPTION_INTEGER,    "set frameskip to fixed value, 0-10 (autoframeskip must be disabled)" },
 	{ OPTION_SECONDS_TO_RUN ";str",                      "0",         OPTION_INTEGER,    "number of emulated seconds to run before automatically exiting" },
+	{ OPTION_BENCH,                                      "0",         OPTION_INTEGER,    "benchmark for the given number of emulated seconds and print a JSON timing report; implies -nothrottle -nosound. The profile breakdown is null unless built with PROFILER=1 (the default for DEBUG builds)" },
 	{ OPTION_THROTTLE,                                   "1",         OPTION_BOOLEAN,    "enable throttling to keep game running in sync with real time" },
 	{ OPTION_SLEEP,                                      "1",         OPTION_BOOLEAN,    "enable sleeping, which gives time back to other applications when idle" },
 	{ OPTION_SPEED "(0.01-100)",                         "1.0",       OPTION_FLOAT,      "controls the speed of gameplay, relative to realtime; smaller numbers are slower" },
@@ -145,6 +155,8 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_SAMPLERATE ";sr(1000-1000000)",             "48000",     OPTION_INTEGER,    "set sound output sample rate" },
 	{ OPTION_SAMPLES,                                    "1",         OPTION_BOOLEAN,    "enable the use of external samples if available" },
 	{ OPTION_VOLUME ";vol",                              "0",         OPTION_INTEGER,    "sound volume in decibels (-32 min, 0 max)" },
+	{ OPTION_RESAMPLE_QUALITY "(0-3)",                   "0",         OPTION_INTEGER,    "sound resampling quality: 0 for simple interpolation, 1-3 for band-limited filters of increasing length" },
+	{ OPTION_SOUND_THREADS,                              "1",         OPTION_BOOLEAN,    "update independent sound streams in parallel; -nosound_threads gives the serial update" },
 
 	// input options
 	{ NULL,                                              NULL,        OPTION_HEADER,     "CORE INPUT OPTIONS" },
@@ -181,6 +193,7 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_DEBUG ";d",                                 "0",         OPTION_BOOLEAN,    "enable/disable debugger" },
 	{ OPTION_DEBUGSCRIPT,                                NULL,        OPTION_STRING,     "script for debugger" },
 	{ OPTION_DEBUG_INTERNAL ";di",                       "0",         OPTION_BOOLEAN,    "use the internal debugger for debugging" },
+	{ OPTION_DRC_PROFILE,                                "0",         OPTION_BOOLEAN,    "count executions of recompiled blocks and report hot blocks, compile time and cache flushes at exit" },
 
 	// misc options
 	{ NULL,                                              NULL,        OPTION_HEADER,     "CORE MISC OPTIONS" },
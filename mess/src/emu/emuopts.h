@@ -95,24 +95,34 @@ enum
 #define OPTION_SNAPSHOT_DIRECTORY	"snapshot_directory"
 #define OPTION_DIFF_DIRECTORY		"diff_directory"
 #define OPTION_COMMENT_DIRECTORY	"comment_directory"
+#define OPTION_INDEX_DIRECTORY		"index_directory"
 
 // core state/playback options
 #define OPTION_STATE				"state"
 #define OPTION_AUTOSAVE				"autosave"
+#define OPTION_STATE_DELTAS			"state_deltas"
 #define OPTION_PLAYBACK				"playback"
 #define OPTION_RECORD				"record"
 #define OPTION_MNGWRITE				"mngwrite"
 #define OPTION_AVIWRITE				"aviwrite"
 #define OPTION_WAVWRITE				"wavwrite"
+#define OPTION_HASHWRITE			"hashwrite"
+#define OPTION_HASHVERIFY			"hashverify"
+#define OPTION_HASH_INTERVAL		"hash_interval"
 #define OPTION_SNAPNAME				"snapname"
 #define OPTION_SNAPSIZE				"snapsize"
 #define OPTION_SNAPVIEW				"snapview"
 #define OPTION_BURNIN				"burnin"
+#define OPTION_REWIND				"rewind"
+#define OPTION_REWIND_MEMORY		"rewind_memory"
+#define OPTION_REWIND_INTERVAL		"rewind_interval"
+#define OPTION_REWIND_COMPRESSION	"rewind_compression"
 
 // core performance options
 #define OPTION_AUTOFRAMESKIP		"autoframeskip"
 #define OPTION_FRAMESKIP			"frameskip"
 #define OPTION_SECONDS_TO_RUN		"seconds_to_run"
+#define OPTION_BENCH				"bench"
 #define OPTION_THROTTLE				"throttle"
 #define OPTION_SLEEP				"sleep"
 #define OPTION_SPEED				"speed"
@@ -152,6 +162,8 @@ enum
 #define OPTION_SAMPLERATE			"samplerate"
 #define OPTION_SAMPLES				"samples"
 #define OPTION_VOLUME				"volume"
+#define OPTION_RESAMPLE_QUALITY		"resample_quality"
+#define OPTION_SOUND_THREADS		"sound_threads"
 
 // core input options
 #define OPTION_COIN_LOCKOUT			"coin_lockout"
@@ -185,6 +197,7 @@ enum
 #define OPTION_DEBUG				"debug"
 #define OPTION_DEBUG_INTERNAL		"debug_internal"
 #define OPTION_DEBUGSCRIPT			"debugscript"
+#define OPTION_DRC_PROFILE			"drcprofile"
 
 // core misc options
 #define OPTION_BIOS					"bios"
@@ -246,24 +259,34 @@ public:
 	const char *snapshot_directory() const { return value(OPTION_SNAPSHOT_DIRECTORY); }
 	const char *diff_directory() const { return value(OPTION_DIFF_DIRECTORY); }
 	const char *comment_directory() const { return value(OPTION_COMMENT_DIRECTORY); }
+	const char *index_directory() const { return value(OPTION_INDEX_DIRECTORY); }
 
 	// core state/playback options
 	const char *state() const { return value(OPTION_STATE); }
 	bool autosave() const { return bool_value(OPTION_AUTOSAVE); }
+	int state_deltas() const { return int_value(OPTION_STATE_DELTAS); }
 	const char *playback() const { return value(OPTION_PLAYBACK); }
 	const char *record() const { return value(OPTION_RECORD); }
 	const char *mng_write() const { return value(OPTION_MNGWRITE); }
 	const char *avi_write() const { return value(OPTION_AVIWRITE); }
 	const char *wav_write() const { return value(OPTION_WAVWRITE); }
+	const char *hash_write() const { return value(OPTION_HASHWRITE); }
+	const char *hash_verify() const { return value(OPTION_HASHVERIFY); }
+	int hash_interval() const { return int_value(OPTION_HASH_INTERVAL); }
 	const char *snap_name() const { return value(OPTION_SNAPNAME); }
 	const char *snap_size() const { return value(OPTION_SNAPSIZE); }
 	const char *snap_view() const { return value(OPTION_SNAPVIEW); }
 	bool burnin() const { return bool_value(OPTION_BURNIN); }
+	bool rewind() const { return bool_value(OPTION_REWIND); }
+	int rewind_memory() const { return int_value(OPTION_REWIND_MEMORY); }
+	int rewind_interval() const { return int_value(OPTION_REWIND_INTERVAL); }
+	int rewind_compression() const { return int_value(OPTION_REWIND_COMPRESSION); }
 
 	// core performance options
 	bool auto_frameskip() const { return bool_value(OPTION_AUTOFRAMESKIP); }
 	int frameskip() const { return int_value(OPTION_FRAMESKIP); }
 	int seconds_to_run() const { return int_value(OPTION_SECONDS_TO_RUN); }
+	int bench() const { return int_value(OPTION_BENCH); }
 	bool throttle() const { return bool_value(OPTION_THROTTLE); }
 	bool sleep() const { return bool_value(OPTION_SLEEP); }
 	float speed() const { return float_value(OPTION_SPEED); }
@@ -303,6 +326,8 @@ public:
 	int sample_rate() const { return int_value(OPTION_SAMPLERATE); }
 	bool samples() const { return bool_value(OPTION_SAMPLES); }
 	int volume() const { return int_value(OPTION_VOLUME); }
+	int resample_quality() const { return int_value(OPTION_RESAMPLE_QUALITY); }
+	bool sound_threads() const { return bool_value(OPTION_SOUND_THREADS); }
 
 	// core input options
 	bool coin_lockout() const { return bool_value(OPTION_COIN_LOCKOUT); }
@@ -334,6 +359,7 @@ public:
 	bool debug_internal() const { return bool_value(OPTION_DEBUG_INTERNAL); }
 	const char *debug_script() const { return value(OPTION_DEBUGSCRIPT); }
 	bool update_in_pause() const { return bool_value(OPTION_UPDATEINPAUSE); }
+	bool drc_profile() const { return bool_value(OPTION_DRC_PROFILE); }
 
 	// core misc options
 	const char *bios() const { return value(OPTION_BIOS); }
@@ -670,20 +670,24 @@ file_error emu_file::attempt_zipped()
 		if (ziperr != ZIPERR_NONE)
 			continue;
 
-		// see if we can find a file with the right name and (if available) crc
-		const zip_file_header *header;
-		for (header = zip_file_first_file(zip); header != NULL; header = zip_file_next_file(zip))
-			if (zip_filename_match(*header, filename) && (!(m_openflags & OPEN_FLAG_HAS_CRC) || header->crc == m_crc))
-				break;
-
-		// if that failed, look for a file with the right crc, but the wrong filename
-		if (header == NULL && (m_openflags & OPEN_FLAG_HAS_CRC))
-			for (header = zip_file_first_file(zip); header != NULL; header = zip_file_next_file(zip))
-				if (header->crc == m_crc && !zip_header_is_path(*header))
+		// see if we can find a file with the right name and (if available) crc; the
+		// crc searches only walk the entries that share our crc
+		const zip_file_header *header = NULL;
+		if (m_openflags & OPEN_FLAG_HAS_CRC)
+		{
+			for (header = zip_file_first_crc(zip, m_crc); header != NULL; header = zip_file_next_crc(zip))
+				if (zip_filename_match(*header, filename))
 					break;
 
-		// if that failed, look for a file with the right name; reporting a bad checksum
-		// is more helpful and less confusing than reporting "rom not found"
+			// if that failed, look for a file with the right crc, but the wrong filename
+			if (header == NULL)
+				for (header = zip_file_first_crc(zip, m_crc); header != NULL; header = zip_file_next_crc(zip))
+					if (!zip_header_is_path(*header))
+						break;
+		}
+
+		// if that failed (or we have no crc), look for a file with the right name; reporting
+		// a bad checksum is more helpful and less confusing than reporting "rom not found"
 		if (header == NULL)
 			for (header = zip_file_first_file(zip); header != NULL; header = zip_file_next_file(zip))
 				if (zip_filename_match(*header, filename))
@@ -714,19 +718,14 @@ file_error emu_file::attempt_zipped()
 file_error emu_file::load_zipped_file()
 {
 	assert(m_file == NULL);
-	assert(m_zipdata == NULL);
 	assert(m_zipfile != NULL);
 
-	// allocate some memory
-	m_zipdata = global_alloc_array(UINT8, m_ziplength);
-
-	// read the data into our buffer and return
-	zip_error ziperr = zip_file_decompress(m_zipfile, m_zipdata, m_ziplength);
-	if (ziperr != ZIPERR_NONE)
+	// decompress the data unless a worker already did
+	if (m_zipdata == NULL)
 	{
-		global_free(m_zipdata);
-		m_zipdata = NULL;
-		return FILERR_FAILURE;
+		file_error filerr = inflate();
+		if (filerr != FILERR_NONE)
+			return filerr;
 	}
 
 	// convert to RAM file
@@ -745,6 +744,33 @@ file_error emu_file::load_zipped_file()
 }
 
 
+//-------------------------------------------------
+//  inflate - decompress a ZIPped file opened
+//  with OPEN_FLAG_NO_PRELOAD into memory; this
+//  touches only our own zip handle, so files can
+//  be inflated in parallel
+//-------------------------------------------------
+
+file_error emu_file::inflate()
+{
+	assert(m_zipdata == NULL);
+	assert(m_zipfile != NULL);
+
+	// allocate some memory
+	m_zipdata = global_alloc_array(UINT8, m_ziplength);
+
+	// read the data into our buffer and return
+	zip_error ziperr = zip_file_decompress(m_zipfile, m_zipdata, m_ziplength);
+	if (ziperr != ZIPERR_NONE)
+	{
+		global_free(m_zipdata);
+		m_zipdata = NULL;
+		return FILERR_FAILURE;
+	}
+	return FILERR_NONE;
+}
+
+
 //-------------------------------------------------
 //  zip_filename_match - compare zip filename
 //  to expected filename, ignoring any directory
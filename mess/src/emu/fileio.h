@@ -139,6 +139,10 @@ public:
 	file_error open_ram(const void *data, UINT32 length);
 	void close();
 
+	// deferred ZIP loading; inflate() may run on a worker thread
+	bool needs_inflate() const { return (m_zipfile != NULL && m_zipdata == NULL); }
+	file_error inflate();
+
 	// control
 	file_error compress(int compress);
 	int seek(INT64 offset, int whence);
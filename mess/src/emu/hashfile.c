@@ -11,6 +11,7 @@
 #include "expat.h"
 #include "emuopts.h"
 #include "hash.h"
+#include <zlib.h>
 
 
 /***************************************************************************
@@ -20,7 +21,7 @@
 typedef struct _hash_info hash_info;
 struct _hash_info
 {
-	hash_collection *hashes;
+	const char *hashes;			/* internal hash string */
 	const char *extrainfo;
 };
 
@@ -43,10 +44,57 @@ void hashfile_close(hash_file *hashfile);
 /* looks up information in a hash file */
 const hash_info *hashfile_lookup(hash_file *hashfile, const hash_collection *hashes);
 
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+#define HASHFILE_INDEX_MAGIC		0x58534948	/* 'HISX' */
+#define HASHFILE_INDEX_VERSION		1
+#define HASHFILE_INDEX_PAGE_SIZE	4096
+
+#define HASHFILE_ENTRY_HAS_CRC		0x01
+
+
+
 /***************************************************************************
     TYPE DEFINITIONS
 ***************************************************************************/
 
+/*
+    The compiled index lives in the index directory as <system>.hsx and is
+    keyed on the size and modification time of the .hsi it came from, or on
+    a CRC of its contents where the OSD reports no time. It
+    holds a header, a table of CRC buckets, one fixed-size record per hash
+    entry (chained per bucket, newest first) and a string table. Lookups
+    read only the pages they touch.
+*/
+typedef struct _hashfile_index_header hashfile_index_header;
+struct _hashfile_index_header
+{
+	UINT32		magic;				/* HASHFILE_INDEX_MAGIC; also catches byte order */
+	UINT32		version;			/* HASHFILE_INDEX_VERSION */
+	UINT64		xml_size;			/* size of the source .hsi */
+	UINT64		xml_modified;		/* modification time of the source .hsi, or top bit | CRC */
+	UINT32		total_size;			/* size of the whole index */
+	UINT32		entry_count;		/* number of entries */
+	UINT32		bucket_count;		/* number of CRC buckets (power of 2) */
+	UINT32		nocrc_head;			/* chain of entries without a CRC (index + 1) */
+	UINT32		buckets_offset;		/* offsets of each section from the start */
+	UINT32		entries_offset;
+	UINT32		strings_offset;
+	UINT32		strings_size;
+};
+
+typedef struct _hashfile_index_entry hashfile_index_entry;
+struct _hashfile_index_entry
+{
+	UINT32		crc;				/* CRC, if HASHFILE_ENTRY_HAS_CRC */
+	UINT32		flags;				/* HASHFILE_ENTRY_* */
+	UINT32		next;				/* next entry in this chain (index + 1) */
+	UINT32		hashes;				/* internal hash string (string offset) */
+	UINT32		extrainfo;			/* extra info, or 0 (string offset) */
+};
+
 struct _hash_file
 {
 	emu_file *file;
@@ -57,6 +105,18 @@ struct _hash_file
 	int preloaded_hash_count;
 
 	void (*error_proc)(const char *message);
+
+	/* compiled index, read a page at a time */
+	emu_options *options;
+	const char *sysname;
+	emu_file *index;
+	hashfile_index_header index_header;
+	UINT8 **index_pages;
+
+	/* entries from an index build that could not be written or used */
+	hash_info **parsed_hashes;
+	UINT32 parsed_hash_count;
+	int parsed;
 };
 
 
@@ -84,6 +144,7 @@ struct hash_parse_state
 	enum hash_parse_position pos;
 	char **text_dest;
 	hash_info *hi;
+	int error_count;
 };
 
 
@@ -111,6 +172,7 @@ static void ATTR_PRINTF(2,3) parse_error(struct hash_parse_state *state, const c
 	char buf[256];
 	va_list va;
 
+	state->error_count++;
 	if (state->error_proc)
 	{
 		va_start(va, fmt);
@@ -177,6 +239,7 @@ static void start_handler(void *data, const char *tagname, const char **attribut
 	char **text_dest;
 	hash_collection hashes;
 	astring all_functions;
+	astring tempstr;
 	char functions;
 //  iodevice_t device;
 	int i;
@@ -257,7 +320,7 @@ static void start_handler(void *data, const char *tagname, const char **attribut
 						return;
 					memset(hi, 0, sizeof(*hi));
 
-					hi->hashes = &hashes;
+					hi->hashes = pool_strdup_lib(state->hashfile->pool, hashes.internal_string(tempstr));
 					state->hi = hi;
 				}
 			}
@@ -350,10 +413,11 @@ static void data_handler(void *data, const XML_Char *s, int len)
 
 
 /*-------------------------------------------------
-    hashfile_parse
+    hashfile_parse - returns the number of
+    errors seen
 -------------------------------------------------*/
 
-static void hashfile_parse(hash_file *hashfile,
+static int hashfile_parse(hash_file *hashfile,
 	int (*selector_proc)(hash_file *hashfile, void *param, const char *name, const hash_collection *hashes),
 	void (*use_proc)(hash_file *hashfile, void *param, hash_info *hi),
 	void (*error_proc)(const char *message),
@@ -402,6 +466,7 @@ static void hashfile_parse(hash_file *hashfile,
 done:
 	if (state.parser)
 		XML_ParserFree(state.parser);
+	return (state.parser != NULL) ? state.error_count : 1;
 }
 
 
@@ -425,6 +490,384 @@ static void preload_use_proc(hash_file *hashfile, void *param, hash_info *hi)
 
 
 
+/***************************************************************************
+    COMPILED INDEX
+***************************************************************************/
+
+/*-------------------------------------------------
+    index_xml_stamp - get the size and
+    modification time of the .hsi
+-------------------------------------------------*/
+
+static int index_xml_stamp(hash_file *hashfile, UINT64 *size, UINT64 *modified)
+{
+	osd_directory_entry *entry = osd_stat(hashfile->file->fullpath());
+
+	if (entry == NULL)
+		return FALSE;
+
+	*size = entry->size;
+	*modified = entry->last_modified;
+	osd_free(entry);
+
+	/* without a timestamp (e.g. osdmini), key on a CRC of the contents; the top bit keeps it apart from real times */
+	if (*modified == 0)
+	{
+		UINT8 buf[4096];
+		UINT32 crc = 0, len;
+
+		hashfile->file->seek(0, SEEK_SET);
+		while ((len = hashfile->file->read(buf, sizeof(buf))) != 0)
+			crc = crc32(crc, buf, len);
+		hashfile->file->seek(0, SEEK_SET);
+		*modified = U64(0x8000000000000000) | crc;
+	}
+	return TRUE;
+}
+
+
+
+/*-------------------------------------------------
+    index_collect_use_proc - gather every entry
+    for building the index
+-------------------------------------------------*/
+
+struct index_build_params
+{
+	hash_info **entries;
+	UINT32 count;
+};
+
+static void index_collect_use_proc(hash_file *hashfile, void *param, hash_info *hi)
+{
+	struct index_build_params *params = (struct index_build_params *) param;
+	hash_info **new_entries;
+
+	new_entries = (hash_info **)pool_realloc_lib(hashfile->pool, params->entries, (params->count + 1) * sizeof(*new_entries));
+	if (!new_entries)
+		return;
+
+	params->entries = new_entries;
+	params->entries[params->count++] = hi;
+}
+
+
+
+/*-------------------------------------------------
+    index_add_string - copy a string into the
+    string table, returning its offset
+-------------------------------------------------*/
+
+static UINT32 index_add_string(UINT8 *base, const hashfile_index_header *header, UINT32 *used, const char *string)
+{
+	UINT32 offset = *used;
+	UINT32 length;
+
+	if (string == NULL)
+		return 0;
+
+	length = strlen(string) + 1;
+	if (base != NULL)
+		memcpy(base + header->strings_offset + offset, string, length);
+	*used += length;
+	return offset;
+}
+
+
+
+/*-------------------------------------------------
+    index_build - parse the whole .hsi once and
+    write its index; the parsed entries are kept
+    on the hash file in case the index cannot be
+    used, so that nothing parses it again
+-------------------------------------------------*/
+
+static void index_build(hash_file *hashfile)
+{
+	struct index_build_params params;
+	hashfile_index_header header;
+	UINT64 xml_size, xml_modified;
+	UINT32 strings = 1, bucket_count = 16;
+	UINT32 entrynum;
+	UINT8 *base;
+
+	if (!index_xml_stamp(hashfile, &xml_size, &xml_modified))
+		return;
+
+	/* only a clean parse is worth writing out */
+	memset(&params, 0, sizeof(params));
+	hashfile->parsed = TRUE;
+	if (hashfile_parse(hashfile, NULL, index_collect_use_proc, hashfile->error_proc, &params) != 0)
+	{
+		hashfile->parsed_hashes = params.entries;
+		hashfile->parsed_hash_count = params.count;
+		return;
+	}
+
+	/* size the string table; offset 0 is reserved for NULL */
+	memset(&header, 0, sizeof(header));
+	for (entrynum = 0; entrynum < params.count; entrynum++)
+	{
+		index_add_string(NULL, &header, &strings, params.entries[entrynum]->hashes);
+		index_add_string(NULL, &header, &strings, params.entries[entrynum]->extrainfo);
+	}
+	while (bucket_count < params.count)
+		bucket_count *= 2;
+
+	header.magic = HASHFILE_INDEX_MAGIC;
+	header.version = HASHFILE_INDEX_VERSION;
+	header.xml_size = xml_size;
+	header.xml_modified = xml_modified;
+	header.entry_count = params.count;
+	header.bucket_count = bucket_count;
+	header.buckets_offset = sizeof(header);
+	header.entries_offset = header.buckets_offset + bucket_count * sizeof(UINT32);
+	header.strings_offset = header.entries_offset + params.count * sizeof(hashfile_index_entry);
+	header.strings_size = strings;
+	header.total_size = header.strings_offset + strings;
+
+	base = global_alloc_array_clear(UINT8, header.total_size);
+	UINT32 *buckets = (UINT32 *)(base + header.buckets_offset);
+	hashfile_index_entry *entries = (hashfile_index_entry *)(base + header.entries_offset);
+
+	/* fill in the entries, pushing each onto the front of its chain so the
+       last one in the file is found first, as a full parse would return it */
+	strings = 1;
+	for (entrynum = 0; entrynum < params.count; entrynum++)
+	{
+		hashfile_index_entry *entry = &entries[entrynum];
+		hash_collection hashes(params.entries[entrynum]->hashes);
+		UINT32 *head;
+
+		entry->hashes = index_add_string(base, &header, &strings, params.entries[entrynum]->hashes);
+		entry->extrainfo = index_add_string(base, &header, &strings, params.entries[entrynum]->extrainfo);
+		if (hashes.crc(entry->crc))
+		{
+			entry->flags = HASHFILE_ENTRY_HAS_CRC;
+			head = &buckets[entry->crc & (bucket_count - 1)];
+		}
+		else
+			head = &header.nocrc_head;
+		entry->next = *head;
+		*head = entrynum + 1;
+	}
+	memcpy(base, &header, sizeof(header));
+
+	/* a truncated write is caught by the size check on load */
+	emu_file file(hashfile->options->index_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	if (file.open(hashfile->sysname, ".hsx") == FILERR_NONE)
+		file.write(base, header.total_size);
+	global_free(base);
+
+	hashfile->parsed_hashes = params.entries;
+	hashfile->parsed_hash_count = params.count;
+}
+
+
+
+/*-------------------------------------------------
+    index_open - open the index if it is current
+    for the .hsi; only the header is read
+-------------------------------------------------*/
+
+static int index_open(hash_file *hashfile)
+{
+	hashfile_index_header *header = &hashfile->index_header;
+	UINT64 xml_size, xml_modified;
+	UINT32 pages;
+
+	if (!index_xml_stamp(hashfile, &xml_size, &xml_modified))
+		return FALSE;
+
+	hashfile->index = global_alloc(emu_file(hashfile->options->index_directory(), OPEN_FLAG_READ));
+	if (hashfile->index->open(hashfile->sysname, ".hsx") != FILERR_NONE ||
+		hashfile->index->read(header, sizeof(*header)) != sizeof(*header) ||
+		header->magic != HASHFILE_INDEX_MAGIC || header->version != HASHFILE_INDEX_VERSION ||
+		header->xml_size != xml_size || header->xml_modified != xml_modified ||
+		header->total_size != hashfile->index->size() ||
+		header->bucket_count == 0 || (header->bucket_count & (header->bucket_count - 1)) != 0 ||
+		header->buckets_offset + (UINT64)header->bucket_count * sizeof(UINT32) > header->entries_offset ||
+		header->entries_offset + (UINT64)header->entry_count * sizeof(hashfile_index_entry) > header->strings_offset ||
+		header->strings_offset + (UINT64)header->strings_size != header->total_size)
+	{
+		global_free(hashfile->index);
+		hashfile->index = NULL;
+		return FALSE;
+	}
+
+	pages = (header->total_size + HASHFILE_INDEX_PAGE_SIZE - 1) / HASHFILE_INDEX_PAGE_SIZE;
+	hashfile->index_pages = (UINT8 **)pool_malloc_lib(hashfile->pool, pages * sizeof(*hashfile->index_pages));
+	if (!hashfile->index_pages)
+	{
+		global_free(hashfile->index);
+		hashfile->index = NULL;
+		return FALSE;
+	}
+	memset(hashfile->index_pages, 0, pages * sizeof(*hashfile->index_pages));
+	return TRUE;
+}
+
+
+
+/*-------------------------------------------------
+    index_page - return a page of the index,
+    reading it in the first time
+-------------------------------------------------*/
+
+static const UINT8 *index_page(hash_file *hashfile, UINT32 pagenum)
+{
+	UINT8 *page = hashfile->index_pages[pagenum];
+
+	if (page == NULL)
+	{
+		page = (UINT8 *)pool_malloc_lib(hashfile->pool, HASHFILE_INDEX_PAGE_SIZE);
+		if (!page)
+			return NULL;
+		memset(page, 0, HASHFILE_INDEX_PAGE_SIZE);
+		hashfile->index->seek(pagenum * HASHFILE_INDEX_PAGE_SIZE, SEEK_SET);
+		hashfile->index->read(page, HASHFILE_INDEX_PAGE_SIZE);
+		hashfile->index_pages[pagenum] = page;
+	}
+	return page;
+}
+
+
+
+/*-------------------------------------------------
+    index_read - copy bytes out of the index
+-------------------------------------------------*/
+
+static int index_read(hash_file *hashfile, UINT32 offset, void *buffer, UINT32 length)
+{
+	UINT8 *dest = (UINT8 *)buffer;
+
+	if (offset + (UINT64)length > hashfile->index_header.total_size)
+		return FALSE;
+
+	while (length > 0)
+	{
+		const UINT8 *page = index_page(hashfile, offset / HASHFILE_INDEX_PAGE_SIZE);
+		UINT32 pageoffs = offset % HASHFILE_INDEX_PAGE_SIZE;
+		UINT32 chunk = MIN(length, HASHFILE_INDEX_PAGE_SIZE - pageoffs);
+
+		if (page == NULL)
+			return FALSE;
+		memcpy(dest, page + pageoffs, chunk);
+		dest += chunk;
+		offset += chunk;
+		length -= chunk;
+	}
+	return TRUE;
+}
+
+
+
+/*-------------------------------------------------
+    index_string - read a string from the index
+    into the pool
+-------------------------------------------------*/
+
+static const char *index_string(hash_file *hashfile, UINT32 offset)
+{
+	const hashfile_index_header *header = &hashfile->index_header;
+	astring string;
+	char c;
+
+	if (offset == 0 || offset >= header->strings_size)
+		return NULL;
+
+	for (offset += header->strings_offset; index_read(hashfile, offset, &c, 1) && c != 0; offset++)
+		string.cat(c);
+	return pool_strdup_lib(hashfile->pool, string);
+}
+
+
+
+/*-------------------------------------------------
+    index_entry_matches - compare an entry's
+    hashes the way a full parse would
+-------------------------------------------------*/
+
+static int index_entry_matches(hash_file *hashfile, const hashfile_index_entry *entry, const hash_collection *hashes)
+{
+	const char *string = index_string(hashfile, entry->hashes);
+
+	return (string != NULL && hash_collection(string) == *hashes);
+}
+
+
+
+/*-------------------------------------------------
+    index_lookup - find the entry a full parse
+    would have returned: the last one in the
+    file that matches
+-------------------------------------------------*/
+
+static const hash_info *index_lookup(hash_file *hashfile, const hash_collection *hashes)
+{
+	const hashfile_index_header *header = &hashfile->index_header;
+	hashfile_index_entry entry;
+	UINT32 best = 0, entrynum, crc;
+	hash_info *hi;
+	int chain;
+
+	/* with a CRC we only need its bucket plus the entries that have none */
+	if (hashes->crc(crc))
+	{
+		for (chain = 0; chain < 2; chain++)
+		{
+			if (chain == 0)
+			{
+				if (!index_read(hashfile, header->buckets_offset + (crc & (header->bucket_count - 1)) * sizeof(UINT32), &entrynum, sizeof(entrynum)))
+					return NULL;
+			}
+			else
+				entrynum = header->nocrc_head;
+
+			/* chains run from the end of the file backwards, so stop at the first match */
+			for ( ; entrynum != 0 && entrynum <= header->entry_count && entrynum > best; entrynum = entry.next)
+			{
+				if (!index_read(hashfile, header->entries_offset + (entrynum - 1) * sizeof(entry), &entry, sizeof(entry)))
+					return NULL;
+				if ((entry.flags & HASHFILE_ENTRY_HAS_CRC) && entry.crc != crc)
+					continue;
+				if (index_entry_matches(hashfile, &entry, hashes))
+				{
+					best = entrynum;
+					break;
+				}
+			}
+		}
+	}
+
+	/* otherwise every entry is a candidate */
+	else
+	{
+		for (entrynum = header->entry_count; entrynum > 0 && best == 0; entrynum--)
+		{
+			if (!index_read(hashfile, header->entries_offset + (entrynum - 1) * sizeof(entry), &entry, sizeof(entry)))
+				return NULL;
+			if (index_entry_matches(hashfile, &entry, hashes))
+				best = entrynum;
+		}
+	}
+
+	if (best == 0)
+		return NULL;
+
+	/* build the result from the winning entry */
+	if (!index_read(hashfile, header->entries_offset + (best - 1) * sizeof(entry), &entry, sizeof(entry)))
+		return NULL;
+	hi = (hash_info*)pool_malloc_lib(hashfile->pool, sizeof(hash_info));
+	if (!hi)
+		return NULL;
+	hi->hashes = index_string(hashfile, entry.hashes);
+	hi->extrainfo = index_string(hashfile, entry.extrainfo);
+	return hi;
+}
+
+
+
 /*-------------------------------------------------
     hashfile_open
 -------------------------------------------------*/
@@ -450,6 +893,8 @@ hash_file *hashfile_open(emu_options &options, const char *sysname, int is_prelo
 	memset(hashfile, 0, sizeof(*hashfile));
 	hashfile->pool = pool;
 	hashfile->error_proc = error_proc;
+	hashfile->options = &options;
+	hashfile->sysname = pool_strdup_lib(pool, sysname);
 
 	/* open a file */
 	hashfile->file = global_alloc(emu_file(options.hash_path(), OPEN_FLAG_READ));
@@ -461,6 +906,9 @@ hash_file *hashfile_open(emu_options &options, const char *sysname, int is_prelo
 		goto error;
 	}
 
+	/* a current index saves parsing the whole file on every lookup */
+	index_open(hashfile);
+
 	if (is_preload)
 		hashfile_parse(hashfile, NULL, preload_use_proc, hashfile->error_proc, NULL);
 
@@ -480,6 +928,8 @@ error:
 
 void hashfile_close(hash_file *hashfile)
 {
+	if (hashfile->index != NULL)
+		global_free(hashfile->index);
 	global_free(hashfile->file);
 	pool_free_lib(hashfile->pool);
 }
@@ -531,10 +981,35 @@ const hash_info *hashfile_lookup(hash_file *hashfile, const hash_collection *has
 
 	for (i = 0; i < hashfile->preloaded_hash_count; i++)
 	{
-		if (singular_selector_proc(hashfile, &param, NULL, hashfile->preloaded_hashes[i]->hashes))
+		hash_collection preloaded(hashfile->preloaded_hashes[i]->hashes);
+		if (singular_selector_proc(hashfile, &param, NULL, &preloaded))
 			return hashfile->preloaded_hashes[i];
 	}
 
+	/* build the index the first time a file is looked up in */
+	if (hashfile->index == NULL && !hashfile->parsed)
+	{
+		index_build(hashfile);
+		index_open(hashfile);
+	}
+	if (hashfile->index != NULL)
+		return index_lookup(hashfile, hashes);
+
+	/* if it could not be built or opened, answer from what the build parsed;
+       like a full parse, the last match in the file wins */
+	if (hashfile->parsed)
+	{
+		UINT32 entrynum;
+
+		for (entrynum = hashfile->parsed_hash_count; entrynum > 0; entrynum--)
+		{
+			hash_collection parsed(hashfile->parsed_hashes[entrynum - 1]->hashes);
+			if (singular_selector_proc(hashfile, &param, NULL, &parsed))
+				return hashfile->parsed_hashes[entrynum - 1];
+		}
+		return NULL;
+	}
+
 	hashfile_parse(hashfile, singular_selector_proc, singular_use_proc,
 		hashfile->error_proc, (void *) &param);
 	return param.hi;
@@ -109,6 +109,7 @@
 #include "profiler.h"
 #include "render.h"
 #include "cheat.h"
+#include "rewind.h"
 #include "ui.h"
 #include "uimenu.h"
 #include "uiinput.h"
@@ -122,17 +123,56 @@
 #ifdef SDLMAME_EMSCRIPTEN
 #include <emscripten.h>
 
+// emulated time per callback is clamped to this range, so a stalled tab
+// doesn't try to catch up all at once
+#define JSMESS_MIN_SLICE_HZ		240
+#define JSMESS_MAX_SLICE_HZ		15
+
+// and each callback stops working after this much real time
+#define JSMESS_MAX_WORK_HZ		30
+
 static device_scheduler * scheduler;
+static osd_ticks_t last_ticks;
 
 void jsmess_main_loop() {
-  attotime stoptime = scheduler->time() + attotime(0,HZ_TO_ATTOSECONDS(60));
-  while (scheduler->time() < stoptime) {
-	  scheduler->timeslice();
-  }
+	running_machine &machine = scheduler->machine();
+	osd_ticks_t ticks_per_second = osd_ticks_per_second();
+	osd_ticks_t start_ticks = osd_ticks();
+
+	// advance emulated time by the real time since the last callback, scaled by the speed setting
+	attoseconds_t budget = HZ_TO_ATTOSECONDS(60);
+	if (last_ticks != 0)
+	{
+		// clamp the gap first; a tab that was in the background for seconds would overflow the multiply
+		osd_ticks_t elapsed = MIN(start_ticks - last_ticks, ticks_per_second / JSMESS_MAX_SLICE_HZ);
+		budget = elapsed * (ATTOSECONDS_PER_SECOND / ticks_per_second);
+	}
+	last_ticks = start_ticks;
+	budget = MIN(MAX(budget, HZ_TO_ATTOSECONDS(JSMESS_MIN_SLICE_HZ)), HZ_TO_ATTOSECONDS(JSMESS_MAX_SLICE_HZ));
+	budget = budget / 100 * machine.video().speed_factor();
+
+	// when paused, just pump a video update through
+	if (machine.paused()) {
+		machine.video().frame_update();
+		machine.rewind().update();
+		return;
+	}
+
+	// run until we've covered the budget or used up our share of real time; any
+	// shortfall shows up in the measured speed, which drives autoframeskip
+	attotime stoptime = scheduler->time() + attotime(0, budget);
+	osd_ticks_t deadline = start_ticks + ticks_per_second / JSMESS_MAX_WORK_HZ;
+	while ((machine.video().fastforward() || scheduler->time() < stoptime) && osd_ticks() < deadline) {
+		scheduler->timeslice();
+		machine.rewind().update();
+	}
 }
 
 void jsmess_set_main_loop(device_scheduler &sched) {
 	scheduler = &sched;
+
+	// the browser calls us back at its own refresh rate; we keep time ourselves
+	sched.machine().video().set_external_pacing();
 	emscripten_set_main_loop(&jsmess_main_loop, 0, 1);
 }
 #endif
@@ -184,6 +224,7 @@ running_machine::running_machine(const machine_config &_config, osd_interface &o
 	  m_save(*this),
 	  m_scheduler(*this),
 	  m_cheat(NULL),
+	  m_rewind(NULL),
 	  m_render(NULL),
 	  m_input(NULL),
 	  m_sound(NULL),
@@ -352,6 +393,9 @@ void running_machine::start()
 
 	// disallow save state registrations starting here
 	m_save.allow_registration(false);
+
+	// set up rewind now that the state layout is fixed
+	m_rewind = auto_alloc(*this, rewind_manager(*this));
 }
 
 
@@ -420,6 +464,14 @@ int running_machine::run(bool firstrun)
 		// perform a soft reset -- this takes us to the running phase
 		soft_reset();
 
+		// if we are benchmarking, start profiling and timing from here
+		osd_ticks_t benchstart = 0;
+		if (options().bench() > 0)
+		{
+			g_profiler.enable(true);
+			benchstart = osd_ticks();
+		}
+
 		// run the CPUs until a reset or exit
 		m_hard_reset_pending = false;
 		while ((!m_hard_reset_pending && !m_exit_pending) || m_saveload_schedule != SLS_NONE)
@@ -442,9 +494,20 @@ int running_machine::run(bool firstrun)
 			if (m_saveload_schedule != SLS_NONE)
 				handle_saveload();
 
+			// capture or restore rewind snapshots
+			m_rewind->update();
+
 			g_profiler.stop();
 		}
 
+		// report the benchmark results
+		if (options().bench() > 0)
+			print_benchmark(osd_ticks() - benchstart);
+
+		// fail a -hashverify run that did not reach all of its checkpoints
+		if (m_exit_pending)
+			m_video->finish_output_hash();
+
 		// and out via the exit phase
 		m_current_phase = MACHINE_PHASE_EXIT;
 
@@ -801,6 +864,8 @@ void running_machine::handle_saveload()
 	const char *opnamed = (m_saveload_schedule == SLS_LOAD) ? "loaded" : "saved";
 	const char *opname = (m_saveload_schedule == SLS_LOAD) ? "load" : "save";
 	file_error filerr = FILERR_NONE;
+	astring filename;
+	bool delta;
 
 	// if no name, bail
 	emu_file file(m_saveload_searchpath, openflags);
@@ -820,12 +885,32 @@ void running_machine::handle_saveload()
 		return;
 	}
 
+	// with -state_deltas, saving over the state we last saved or loaded only
+	// writes what has changed since, to <name>.1, <name>.2 and so on
+	delta = (m_saveload_schedule == SLS_SAVE && m_save.delta_ready() && m_saveload_delta_base == m_saveload_pending_file);
+	filename.cpy(m_saveload_pending_file);
+	if (delta)
+		filename.catprintf(".%d", m_save.delta_sequence() + 1);
+
 	// open the file
-	filerr = file.open(m_saveload_pending_file);
+	filerr = file.open(filename);
 	if (filerr == FILERR_NONE)
 	{
 		// read/write the save state
-		save_error saverr = (m_saveload_schedule == SLS_LOAD) ? m_save.read_file(file) : m_save.write_file(file);
+		save_error saverr;
+		if (m_saveload_schedule == SLS_LOAD)
+			saverr = load_state_chain(file);
+		else if (delta)
+			saverr = m_save.write_delta_file(file);
+		else
+		{
+			saverr = m_save.write_file(file);
+			remove_state_deltas();
+		}
+
+		// a full save or any load gives the deltas that follow a new base
+		if (!delta)
+			m_saveload_delta_base.cpy((saverr == STATERR_NONE) ? m_saveload_pending_file.cstr() : "");
 
 		// handle the result
 		switch (saverr)
@@ -873,6 +958,163 @@ cancel:
 }
 
 
+//-------------------------------------------------
+//  load_state_chain - load a state along with any
+//  deltas that were saved on top of it
+//-------------------------------------------------
+
+save_error running_machine::load_state_chain(emu_file &base)
+{
+	emu_file *deltas[255];
+	int deltacount = 0;
+
+	// open <name>.1, <name>.2 and so on until one is missing
+	while (deltacount < ARRAY_LENGTH(deltas))
+	{
+		astring filename;
+		filename.printf("%s.%d", m_saveload_pending_file.cstr(), deltacount + 1);
+		deltas[deltacount] = global_alloc(emu_file(m_saveload_searchpath, OPEN_FLAG_READ));
+		if (deltas[deltacount]->open(filename) != FILERR_NONE)
+		{
+			global_free(deltas[deltacount]);
+			break;
+		}
+		deltacount++;
+	}
+
+	// a plain state goes through the normal path
+	save_error saverr;
+	if (deltacount == 0)
+		saverr = m_save.read_file(base);
+	else
+		saverr = m_save.read_delta_chain(base, deltas, deltacount);
+
+	for (int deltanum = 0; deltanum < deltacount; deltanum++)
+		global_free(deltas[deltanum]);
+	return saverr;
+}
+
+
+//-------------------------------------------------
+//  remove_state_deltas - remove the deltas left
+//  over from an earlier chain after writing a
+//  full state over it
+//-------------------------------------------------
+
+void running_machine::remove_state_deltas()
+{
+	for (int deltanum = 1; ; deltanum++)
+	{
+		astring filename;
+		filename.printf("%s.%d", m_saveload_pending_file.cstr(), deltanum);
+		emu_file file(m_saveload_searchpath, OPEN_FLAG_READ);
+		if (file.open(filename) != FILERR_NONE)
+			break;
+		file.remove_on_close();
+	}
+}
+
+
+//-------------------------------------------------
+//  print_benchmark - report the results of a
+//  -bench run as a single line of JSON
+//-------------------------------------------------
+
+void running_machine::print_benchmark(osd_ticks_t realticks)
+{
+	double emulated = time().as_double();
+	double wall = (double)realticks / (double)osd_ticks_per_second();
+	double speed = (wall > 0) ? (emulated * 100.0 / wall) : 0;
+
+	astring profile;
+	g_profiler.json(*this, wall, profile);
+	g_profiler.enable(false);
+
+	// emulated cycles per wall-clock second for each CPU, for comparing CPU cores between builds
+	astring cycles;
+	device_execute_interface *exec = NULL;
+	for (bool gotone = devicelist().first(exec); gotone; gotone = exec->next(exec))
+		cycles.catprintf("%s\"%s\": %.0f", (cycles.len() == 0) ? "" : ", ", exec->device().tag(), (wall > 0) ? (double)exec->total_cycles() / wall : 0);
+
+	// now that emulation has stopped, time the scheduler with 10, 100 and 1000 extra live timers
+	astring timers;
+	for (int count = 10; count <= 1000; count *= 10)
+		timers.catprintf("%s\"%d\": %.0f", (count == 10) ? "" : ", ", count, m_scheduler.benchmark_timers(count, 100000));
+
+	// and the cost of saving and loading the whole state
+	astring states;
+	benchmark_states(states);
+
+	// and the software renderer's quad kernels
+	astring render;
+	m_video->benchmark_render(render);
+
+	mame_printf_info("{ \"system\": \"%s\", \"emulated_seconds\": %.6f, \"wall_seconds\": %.6f, \"speed_percent\": %.2f, \"profile\": %s, \"cycles_per_second\": { %s }, \"timer_adjusts_per_second\": { %s }, \"states\": %s, \"render_megapixels_per_second\": { %s } }\n",
+			basename(), emulated, wall, speed, profile.cstr(), cycles.cstr(), timers.cstr(), states.cstr(), render.cstr());
+
+	// keep the JSON line clean, but say why the breakdown is missing
+	if (strcmp(profile.cstr(), "null") == 0)
+		mame_printf_warning("No profile breakdown: rebuild with PROFILER=1 (the default for DEBUG builds) to get one\n");
+}
+
+
+//-------------------------------------------------
+//  benchmark_states - time whole-state saves and
+//  loads through the in-memory buffer calls and,
+//  for comparison, saves through a compressed
+//  file as -state and the UI make them
+//-------------------------------------------------
+
+void running_machine::benchmark_states(astring &string)
+{
+	UINT32 size = m_save.state_size();
+	if (size == 0 || !m_scheduler.can_save())
+	{
+		string.cpy("null");
+		return;
+	}
+
+	// loading back what was just saved leaves the machine as it was
+	UINT8 *buffer = global_alloc_array(UINT8, size);
+	const int iterations = 100;
+	osd_ticks_t start = osd_ticks();
+	for (int iter = 0; iter < iterations; iter++)
+		m_save.write_buffer(buffer, size);
+	osd_ticks_t saveticks = osd_ticks() - start;
+
+	start = osd_ticks();
+	for (int iter = 0; iter < iterations; iter++)
+		m_save.read_buffer(buffer, size);
+	osd_ticks_t loadticks = osd_ticks() - start;
+	global_free(buffer);
+
+	// fewer file saves, since each one opens, compresses and closes a file
+	const int fileiterations = 10;
+	osd_ticks_t fileticks = 0;
+	for (int iter = 0; iter < fileiterations; iter++)
+	{
+		emu_file file(options().state_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+		start = osd_ticks();
+		if (file.open(basename(), PATH_SEPARATOR "bench.sta") != FILERR_NONE || m_save.write_file(file) != STATERR_NONE)
+		{
+			fileticks = 0;
+			break;
+		}
+		file.close();
+		fileticks += osd_ticks() - start;
+	}
+
+	// then tidy up the scratch file
+	emu_file file(options().state_directory(), OPEN_FLAG_READ);
+	if (file.open(basename(), PATH_SEPARATOR "bench.sta") == FILERR_NONE)
+		file.remove_on_close();
+
+	double tps = (double)osd_ticks_per_second();
+	string.printf("{ \"bytes\": %d, \"buffer_saves_per_second\": %.0f, \"buffer_loads_per_second\": %.0f, \"file_saves_per_second\": %.0f }",
+			size, (saveticks > 0) ? iterations * tps / saveticks : 0, (loadticks > 0) ? iterations * tps / loadticks : 0, (fileticks > 0) ? fileiterations * tps / fileticks : 0);
+}
+
+
 //-------------------------------------------------
 //  soft_reset - actually perform a soft-reset
 //  of the system
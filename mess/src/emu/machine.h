@@ -172,6 +172,7 @@ const int DEBUG_FLAG_OSD_ENABLED	= 0x00001000;		// The OSD debugger is enabled
 class gfx_element;
 class colortable_t;
 class cheat_manager;
+class rewind_manager;
 class render_manager;
 class sound_manager;
 class video_manager;
@@ -335,6 +336,7 @@ public:
 	device_scheduler &scheduler() { return m_scheduler; }
 	save_manager &save() { return m_save; }
 	cheat_manager &cheat() const { assert(m_cheat != NULL); return *m_cheat; }
+	rewind_manager &rewind() const { assert(m_rewind != NULL); return *m_rewind; }
 	render_manager &render() const { assert(m_render != NULL); return *m_render; }
 	input_manager &input() const { assert(m_input != NULL); return *m_input; }
 	sound_manager &sound() const { assert(m_sound != NULL); return *m_sound; }
@@ -442,7 +444,11 @@ private:
 	void set_saveload_filename(const char *filename);
 	void fill_systime(system_time &systime, time_t t);
 	void handle_saveload();
+	save_error load_state_chain(emu_file &base);
+	void remove_state_deltas();
 	void soft_reset(void *ptr = NULL, INT32 param = 0);
+	void print_benchmark(osd_ticks_t realticks);
+	void benchmark_states(astring &string);
 
 	// internal callbacks
 	static void logfile_callback(running_machine &machine, const char *buffer);
@@ -459,6 +465,7 @@ private:
 
 	// managers
 	cheat_manager *			m_cheat;				// internal data from cheat.c
+	rewind_manager *		m_rewind;				// internal data from rewind.c
 	render_manager *		m_render;				// internal data from render.c
 	input_manager *			m_input;				// internal data from input.c
 	sound_manager *			m_sound;				// internal data from sound.c
@@ -497,6 +504,7 @@ private:
 	attotime				m_saveload_schedule_time;
 	astring					m_saveload_pending_file;
 	const char *			m_saveload_searchpath;
+	astring					m_saveload_delta_base;	// state file the save manager's delta base came from
 
 	// notifier callbacks
 	struct notifier_callback_item
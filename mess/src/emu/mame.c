@@ -163,6 +163,16 @@ int mame_execute(emu_options &options, osd_interface &osd)
 			options.parse_standard_inis(errors);
 		}
 
+		// if we are benchmarking, run unthrottled and silent for a fixed time
+		if (options.bench() > 0)
+		{
+			astring error_string;
+			options.set_value(OPTION_THROTTLE, false, OPTION_PRIORITY_MAXIMUM, error_string);
+			options.set_value(OPTION_SOUND, false, OPTION_PRIORITY_MAXIMUM, error_string);
+			options.set_value(OPTION_SECONDS_TO_RUN, options.bench(), OPTION_PRIORITY_MAXIMUM, error_string);
+			assert(!error_string);
+		}
+
 		// create the machine configuration
 		machine_config config(*system, options);
 
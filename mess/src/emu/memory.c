@@ -788,7 +788,7 @@ class address_table
 
 public:
 	// construction/destruction
-	address_table(address_space &space, bool large);
+	address_table(address_space &space, bool large, memory_page_cache &cache);
 	virtual ~address_table();
 
 	// getters
@@ -815,8 +815,15 @@ public:
 		return entry;
 	}
 
-	// enable watchpoints by swapping in the watchpoint table
-	void enable_watchpoints(bool enable = true) { m_live_lookup = enable ? s_watchpoint_table : m_table; }
+	// return a direct pointer for a cached RAM/ROM/bank page, or NULL if not cached
+	UINT8 *page_cache_lookup(offs_t byteaddress) const { return m_page_cache.lookup(byteaddress); }
+
+	// page cache management
+	void page_cache_fill(offs_t byteaddress, UINT32 entry);
+	void invalidate_page_cache() { m_page_cache.invalidate(); }
+
+	// enable watchpoints by swapping in the watchpoint table; the page cache is bypassed while they are on
+	void enable_watchpoints(bool enable = true) { m_live_lookup = enable ? s_watchpoint_table : m_table; m_page_cache.m_enabled = !enable; invalidate_page_cache(); }
 
 	// table mapping helpers
 	void map_range(offs_t bytestart, offs_t byteend, offs_t bytemask, offs_t bytemirror, UINT8 staticentry);
@@ -868,6 +875,7 @@ protected:
 	};
 	subtable_data *			m_subtable;					// info about each subtable
 	UINT8					m_subtable_alloc;			// number of subtables allocated
+	memory_page_cache &		m_page_cache;				// direct-mapped cache of RAM/ROM/bank pages
 
 	// static global read-only watchpoint table
 	static UINT8			s_watchpoint_table[1 << LEVEL1_BITS];
@@ -1248,6 +1256,11 @@ public:
 	// native read
 	_NativeType read_native(offs_t offset, _NativeType mask)
 	{
+		// fast path: a cached page of RAM/ROM/bank needs no handler dispatch
+		UINT8 *cached = m_read.page_cache_lookup(offset & m_bytemask);
+		if (cached != NULL)
+			return *reinterpret_cast<_NativeType *>(cached);
+
 		g_profiler.start(PROFILER_MEMREAD);
 
 		if (TEST_HANDLER) printf("[r%X,%s]", offset, core_i64_hex_format(mask, sizeof(_NativeType) * 2));
@@ -1260,7 +1273,11 @@ public:
 		// either read directly from RAM, or call the delegate
 		offset = handler.byteoffset(byteaddress);
 		_NativeType result;
-		if (entry <= STATIC_BANKMAX) result = *reinterpret_cast<_NativeType *>(handler.ramptr(offset));
+		if (entry <= STATIC_BANKMAX)
+		{
+			m_read.page_cache_fill(byteaddress, entry);
+			result = *reinterpret_cast<_NativeType *>(handler.ramptr(offset));
+		}
 		else if (sizeof(_NativeType) == 1) result = handler.read8(*this, offset, mask);
 		else if (sizeof(_NativeType) == 2) result = handler.read16(*this, offset >> 1, mask);
 		else if (sizeof(_NativeType) == 4) result = handler.read32(*this, offset >> 2, mask);
@@ -1273,6 +1290,11 @@ public:
 	// mask-less native read
 	_NativeType read_native(offs_t offset)
 	{
+		// fast path: a cached page of RAM/ROM/bank needs no handler dispatch
+		UINT8 *cached = m_read.page_cache_lookup(offset & m_bytemask);
+		if (cached != NULL)
+			return *reinterpret_cast<_NativeType *>(cached);
+
 		g_profiler.start(PROFILER_MEMREAD);
 
 		if (TEST_HANDLER) printf("[r%X]", offset);
@@ -1285,7 +1307,11 @@ public:
 		// either read directly from RAM, or call the delegate
 		offset = handler.byteoffset(byteaddress);
 		_NativeType result;
-		if (entry <= STATIC_BANKMAX) result = *reinterpret_cast<_NativeType *>(handler.ramptr(offset));
+		if (entry <= STATIC_BANKMAX)
+		{
+			m_read.page_cache_fill(byteaddress, entry);
+			result = *reinterpret_cast<_NativeType *>(handler.ramptr(offset));
+		}
 		else if (sizeof(_NativeType) == 1) result = handler.read8(*this, offset, 0xff);
 		else if (sizeof(_NativeType) == 2) result = handler.read16(*this, offset >> 1, 0xffff);
 		else if (sizeof(_NativeType) == 4) result = handler.read32(*this, offset >> 2, 0xffffffff);
@@ -1298,6 +1324,15 @@ public:
 	// native write
 	void write_native(offs_t offset, _NativeType data, _NativeType mask)
 	{
+		// fast path: a cached page of RAM/bank needs no handler dispatch
+		UINT8 *cached = m_write.page_cache_lookup(offset & m_bytemask);
+		if (cached != NULL)
+		{
+			_NativeType *dest = reinterpret_cast<_NativeType *>(cached);
+			*dest = (*dest & ~mask) | (data & mask);
+			return;
+		}
+
 		g_profiler.start(PROFILER_MEMWRITE);
 
 		// look up the handler
@@ -1309,6 +1344,7 @@ public:
 		offset = handler.byteoffset(byteaddress);
 		if (entry <= STATIC_BANKMAX)
 		{
+			m_write.page_cache_fill(byteaddress, entry);
 			_NativeType *dest = reinterpret_cast<_NativeType *>(handler.ramptr(offset));
 			*dest = (*dest & ~mask) | (data & mask);
 		}
@@ -1323,6 +1359,14 @@ public:
 	// mask-less native write
 	void write_native(offs_t offset, _NativeType data)
 	{
+		// fast path: a cached page of RAM/bank needs no handler dispatch
+		UINT8 *cached = m_write.page_cache_lookup(offset & m_bytemask);
+		if (cached != NULL)
+		{
+			*reinterpret_cast<_NativeType *>(cached) = data;
+			return;
+		}
+
 		g_profiler.start(PROFILER_MEMWRITE);
 
 		// look up the handler
@@ -1332,7 +1376,11 @@ public:
 
 		// either write directly to RAM, or call the delegate
 		offset = handler.byteoffset(byteaddress);
-		if (entry <= STATIC_BANKMAX) *reinterpret_cast<_NativeType *>(handler.ramptr(offset)) = data;
+		if (entry <= STATIC_BANKMAX)
+		{
+			m_write.page_cache_fill(byteaddress, entry);
+			*reinterpret_cast<_NativeType *>(handler.ramptr(offset)) = data;
+		}
 		else if (sizeof(_NativeType) == 1) handler.write8(*this, offset, data, 0xff);
 		else if (sizeof(_NativeType) == 2) handler.write16(*this, offset >> 1, data, 0xffff);
 		else if (sizeof(_NativeType) == 4) handler.write32(*this, offset >> 2, data, 0xffffffff);
@@ -3289,13 +3337,14 @@ memory_bank &address_space::bank_find_or_allocate(const char *tag, offs_t addrst
 //  address_table - constructor
 //-------------------------------------------------
 
-address_table::address_table(address_space &space, bool large)
+address_table::address_table(address_space &space, bool large, memory_page_cache &cache)
 	: m_table(auto_alloc_array(space.machine(), UINT8, 1 << LEVEL1_BITS)),
 	  m_live_lookup(m_table),
 	  m_space(space),
 	  m_large(large),
 	  m_subtable(auto_alloc_array(space.machine(), subtable_data, SUBTABLE_COUNT)),
-	  m_subtable_alloc(0)
+	  m_subtable_alloc(0),
+	  m_page_cache(cache)
 {
 	// make our static table all watchpoints
 	if (s_watchpoint_table[0] != STATIC_WATCHPOINT)
@@ -3355,6 +3404,7 @@ void address_table::map_range(offs_t addrstart, offs_t addrend, offs_t addrmask,
 
 	// recompute any direct access on this space if it is a read modification
 	m_space.m_direct.force_update(entry);
+	invalidate_page_cache();
 
 	//  verify_reference_counts();
 }
@@ -3385,6 +3435,9 @@ void address_table::setup_range(offs_t addrstart, offs_t addrend, offs_t addrmas
 		setup_range_solid(addrstart, addrend, addrmask, addrmirror, entries);
 	else
 		setup_range_masked(addrstart, addrend, addrmask, addrmirror, mask, entries);
+
+	// the mapping has changed, so nothing we have cached can be trusted
+	invalidate_page_cache();
 }
 
 //-------------------------------------------------
@@ -3858,6 +3911,54 @@ void address_table::mask_all_handlers(offs_t mask)
 	// we don't loop over map entries because the mask applies to static handlers as well
 	for (int entrynum = 0; entrynum < ENTRY_COUNT; entrynum++)
 		handler(entrynum).apply_mask(mask);
+	invalidate_page_cache();
+}
+
+
+//-------------------------------------------------
+//  page_cache_fill - add the page containing the
+//  given address to the page cache, if it maps
+//  linearly onto a single RAM/ROM/bank entry
+//-------------------------------------------------
+
+void address_table::page_cache_fill(offs_t byteaddress, UINT32 entry)
+{
+	// only banks qualify, and nothing is cached while watchpoints are live
+	if (!m_page_cache.m_enabled || entry < STATIC_BANK1 || entry > STATIC_BANKMAX)
+		return;
+
+	// don't rescan a page we've already turned down
+	offs_t pagestart = byteaddress & ~memory_page_cache::PAGE_MASK;
+	memory_page_cache::page_entry &page = m_page_cache.m_entry[(pagestart >> memory_page_cache::PAGE_BITS) & (memory_page_cache::ENTRIES - 1)];
+	if (page.m_rejected == pagestart)
+		return;
+	page.m_rejected = pagestart;
+
+	// the handler must map the page linearly: no mask bits within the page and a page-aligned start
+	const handler_entry &curentry = handler(entry);
+	if ((curentry.bytemask() & memory_page_cache::PAGE_MASK) != memory_page_cache::PAGE_MASK || ((pagestart - curentry.bytestart()) & memory_page_cache::PAGE_MASK) != 0)
+		return;
+	if (curentry.ramptr() == NULL)
+		return;
+
+	// every byte in the page must resolve to the same entry; a level 1 entry always covers a whole page
+	UINT8 l1entry = m_table[level1_index(pagestart)];
+	if (m_large && l1entry < SUBTABLE_BASE)
+	{
+		if (l1entry != entry)
+			return;
+	}
+	else
+	{
+		for (offs_t byteoffs = 0; byteoffs < memory_page_cache::PAGE_SIZE; byteoffs++)
+			if (m_table[m_large ? level2_index(l1entry, pagestart + byteoffs) : level1_index(pagestart + byteoffs)] != entry)
+				return;
+	}
+
+	// fill in the slot
+	page.m_pagestart = pagestart;
+	page.m_rejected = memory_page_cache::INVALID;
+	page.m_base = curentry.ramptr(curentry.byteoffset(pagestart));
 }
 
 
@@ -4140,7 +4241,7 @@ const char *address_table::handler_name(UINT8 entry) const
 //-------------------------------------------------
 
 address_table_read::address_table_read(address_space &space, bool large)
-	: address_table(space, large)
+	: address_table(space, large, space.m_read_cache)
 {
 	// allocate handlers for each entry, prepopulating the bankptrs for banks
 	for (int entrynum = 0; entrynum < ARRAY_LENGTH(m_handlers); entrynum++)
@@ -4216,7 +4317,7 @@ handler_entry &address_table_read::handler(UINT32 index) const
 //-------------------------------------------------
 
 address_table_write::address_table_write(address_space &space, bool large)
-	: address_table(space, large)
+	: address_table(space, large, space.m_write_cache)
 {
 	// allocate handlers for each entry, prepopulating the bankptrs for banks
 	for (int entrynum = 0; entrynum < ARRAY_LENGTH(m_handlers); entrynum++)
@@ -4303,7 +4404,8 @@ direct_read_data::direct_read_data(address_space &space)
 	  m_bytemask(space.bytemask()),
 	  m_bytestart(1),
 	  m_byteend(0),
-	  m_entry(STATIC_UNMAP)
+	  m_entry(STATIC_UNMAP),
+	  m_generation(0)
 {
 }
 
@@ -4323,6 +4425,28 @@ direct_read_data::~direct_read_data()
 //-------------------------------------------------
 
 bool direct_read_data::set_direct_region(offs_t &byteaddress)
+{
+	// remember the live region; anyone caching a pointer into it must
+	// refetch only if it actually changes
+	UINT8 *oldraw = m_raw;
+	UINT8 *olddecrypted = m_decrypted;
+	offs_t oldbytemask = m_bytemask;
+	offs_t oldbytestart = m_bytestart;
+	offs_t oldbyteend = m_byteend;
+
+	bool result = update_direct_region(byteaddress);
+	if (m_raw != oldraw || m_decrypted != olddecrypted || m_bytemask != oldbytemask || m_bytestart != oldbytestart || m_byteend != oldbyteend)
+		m_generation++;
+	return result;
+}
+
+
+//-------------------------------------------------
+//  update_direct_region - recompute the live
+//  region for the given address
+//-------------------------------------------------
+
+bool direct_read_data::update_direct_region(offs_t &byteaddress)
 {
 	// allow overrides
 	offs_t overrideaddress = byteaddress;
@@ -4604,9 +4728,13 @@ void memory_bank::add_reference(address_space &space, read_or_write readorwrite)
 
 void memory_bank::invalidate_references()
 {
-	// invalidate all the direct references to any referenced address spaces
+	// invalidate all the direct references and cached pages of any referenced address spaces
 	for (bank_reference *ref = m_reflist.first(); ref != NULL; ref = ref->next())
+	{
 		ref->space().direct().force_update();
+		ref->space().read().invalidate_page_cache();
+		ref->space().write().invalidate_page_cache();
+	}
 }
 
 
@@ -206,12 +206,16 @@ public:
 	address_space &space() const { return m_space; }
 	UINT8 *raw() const { return m_raw; }
 	UINT8 *decrypted() const { return m_decrypted; }
+	offs_t bytemask() const { return m_bytemask; }
+	offs_t bytestart() const { return m_bytestart; }
+	offs_t byteend() const { return m_byteend; }
+	UINT32 generation() const { return m_generation; }
 
 	// see if an address is within bounds, or attempt to update it if not
 	bool address_is_valid(offs_t byteaddress) { return EXPECTED(byteaddress >= m_bytestart && byteaddress <= m_byteend) || set_direct_region(byteaddress); }
 
 	// force a recomputation on the next read
-	void force_update() { m_byteend = 0; m_bytestart = 1; }
+	void force_update() { m_byteend = 0; m_bytestart = 1; m_generation++; }
 	void force_update(UINT8 if_match) { if (m_entry == if_match) force_update(); }
 
 	// custom update callbacks and configuration
@@ -235,6 +239,7 @@ public:
 private:
 	// internal helpers
 	bool set_direct_region(offs_t &byteaddress);
+	bool update_direct_region(offs_t &byteaddress);
 	direct_range *find_range(offs_t byteaddress, UINT8 &entry);
 	void remove_intersecting_ranges(offs_t bytestart, offs_t byteend);
 
@@ -246,12 +251,69 @@ private:
 	offs_t						m_bytestart;			// minimum valid byte address
 	offs_t						m_byteend;				// maximum valid byte address
 	UINT8						m_entry;				// live entry
+	UINT32						m_generation;			// bumped whenever the live region changes
 	simple_list<direct_range>	m_rangelist[256];		// list of ranges for each entry
 	simple_list<direct_range>	m_freerangelist;		// list of recycled range entries
 	direct_update_delegate		m_directupdate;			// fast direct-access update callback
 };
 
 
+// ======================> memory_page_cache
+
+// memory_page_cache is a small direct-mapped cache of address space pages that
+// map straight onto RAM, ROM or bank memory; it is filled and invalidated by
+// the address tables, and read by anyone wanting to skip handler dispatch
+class memory_page_cache
+{
+	friend class address_table;
+
+public:
+	// page cache definitions
+	static const int PAGE_BITS = 8;							// number of address bits in a cached page
+	static const offs_t PAGE_SIZE = 1 << PAGE_BITS;			// number of bytes in a cached page
+	static const offs_t PAGE_MASK = PAGE_SIZE - 1;			// mask of the offset within a cached page
+	static const int ENTRIES = 256;							// number of pages in the cache (power of 2)
+
+	// construction
+	memory_page_cache() : m_enabled(true) { invalidate(); }
+
+	// return a direct pointer for a cached page, or NULL if not cached
+	UINT8 *lookup(offs_t byteaddress) const
+	{
+		const page_entry &page = m_entry[(byteaddress >> PAGE_BITS) & (ENTRIES - 1)];
+		if (EXPECTED(page.m_pagestart == (byteaddress & ~PAGE_MASK)))
+			return page.m_base + (byteaddress & PAGE_MASK);
+		return NULL;
+	}
+
+	// forget everything; called whenever the mapping or a bank base changes
+	void invalidate()
+	{
+		for (int pagenum = 0; pagenum < ENTRIES; pagenum++)
+		{
+			m_entry[pagenum].m_pagestart = INVALID;
+			m_entry[pagenum].m_base = NULL;
+			m_entry[pagenum].m_rejected = INVALID;
+		}
+	}
+
+private:
+	static const offs_t INVALID = 1;						// tag that never matches a page start
+
+	// page_entry maps a single page of the address space directly onto memory
+	struct page_entry
+	{
+		offs_t				m_pagestart;				// byte address of the start of the page
+		UINT8 *				m_base;						// pointer to the memory backing the page
+		offs_t				m_rejected;					// byte address of a page known not to qualify
+	};
+
+	// internal state
+	bool					m_enabled;					// can we add pages to the cache?
+	page_entry				m_entry[ENTRIES];			// the cached pages
+};
+
+
 // ======================> address_space_config
 
 // describes an address space and provides basic functions to map addresses to bytes
@@ -297,6 +359,7 @@ class address_space
 	friend class address_table_read;
 	friend class address_table_write;
 	friend class direct_read_data;
+	friend class memory_bank;
 	friend class simple_list<address_space>;
 	friend resource_pool_object<address_space>::~resource_pool_object();
 
@@ -318,6 +381,8 @@ public:
 	address_map *map() const { return m_map; }
 
 	direct_read_data &direct() const { return m_direct; }
+	const memory_page_cache &read_page_cache() const { return m_read_cache; }
+	const memory_page_cache &write_page_cache() const { return m_write_cache; }
 
 	int data_width() const { return m_config.data_width(); }
 	int addr_width() const { return m_config.addr_width(); }
@@ -390,6 +455,7 @@ public:
 	// direct access
 	direct_update_delegate set_direct_update_handler(direct_update_delegate function) { return m_direct.set_direct_update(function); }
 	bool set_direct_region(offs_t &byteaddress);
+	bool update_direct_region(offs_t &byteaddress);
 
 	// umap ranges (short form)
 	void unmap_read(offs_t addrstart, offs_t addrend) { unmap_read(addrstart, addrend, 0, 0); }
@@ -549,6 +615,8 @@ protected:
 	bool					m_debugger_access;	// treat accesses as coming from the debugger
 	bool					m_log_unmap;		// log unmapped accesses in this space?
 	direct_read_data &		m_direct;			// fast direct-access read info
+	memory_page_cache		m_read_cache;		// pages that can be read without dispatch
+	memory_page_cache		m_write_cache;		// pages that can be written without dispatch
 	const char *			m_name;				// friendly name of the address space
 	UINT8					m_addrchars;		// number of characters to use for physical addresses
 	UINT8					m_logaddrchars;		// number of characters to use for logical addresses
@@ -558,6 +626,116 @@ private:
 };
 
 
+// ======================> fast_address_space
+
+// fast_address_space binds a CPU core to an address space of a known width and
+// endianness at compile time; accesses to cached RAM/ROM/bank pages are inlined
+// into the caller, and everything else goes through the regular address space
+template<typename _NativeType, endianness_t _Endian>
+class fast_address_space
+{
+	// constants describing the native size
+	static const UINT32 NATIVE_BYTES = sizeof(_NativeType);
+	static const offs_t BYTE_XOR = (_Endian == ENDIANNESS_NATIVE) ? 0 : NATIVE_BYTES - 1;
+
+public:
+	// bind to a space; this is a plain struct so it can live in legacy CPU tokens
+	void bind(address_space &space)
+	{
+		if (space.data_width() != 8 * NATIVE_BYTES || space.endianness() != _Endian)
+			throw emu_fatalerror("fast_address_space: space '%s' is %d-bit, %s endian", space.name(), space.data_width(), (space.endianness() == ENDIANNESS_LITTLE) ? "little" : "big");
+		m_space = &space;
+		m_bytemask = space.bytemask();
+		m_read = &space.read_page_cache();
+		m_write = &space.write_page_cache();
+	}
+
+	// getters
+	address_space &space() const { return *m_space; }
+
+	// byte accessors
+	UINT8 read_byte(offs_t byteaddress)
+	{
+		UINT8 *ptr = m_read->lookup((byteaddress ^ BYTE_XOR) & m_bytemask);
+		if (EXPECTED(ptr != NULL))
+			return *ptr;
+		return m_space->read_byte(byteaddress);
+	}
+
+	void write_byte(offs_t byteaddress, UINT8 data)
+	{
+		UINT8 *ptr = m_write->lookup((byteaddress ^ BYTE_XOR) & m_bytemask);
+		if (EXPECTED(ptr != NULL))
+			*ptr = data;
+		else
+			m_space->write_byte(byteaddress, data);
+	}
+
+	// word accessors; only aligned native words are inlined
+	UINT16 read_word(offs_t byteaddress)
+	{
+		if (NATIVE_BYTES == 2 && (byteaddress & 1) == 0)
+		{
+			UINT8 *ptr = m_read->lookup(byteaddress & m_bytemask);
+			if (EXPECTED(ptr != NULL))
+				return *reinterpret_cast<UINT16 *>(ptr);
+		}
+		return m_space->read_word(byteaddress);
+	}
+
+	void write_word(offs_t byteaddress, UINT16 data)
+	{
+		if (NATIVE_BYTES == 2 && (byteaddress & 1) == 0)
+		{
+			UINT8 *ptr = m_write->lookup(byteaddress & m_bytemask);
+			if (EXPECTED(ptr != NULL))
+			{
+				*reinterpret_cast<UINT16 *>(ptr) = data;
+				return;
+			}
+		}
+		m_space->write_word(byteaddress, data);
+	}
+
+	// dword accessors; on a 16-bit bus these are two word accesses in bus order
+	UINT32 read_dword(offs_t byteaddress)
+	{
+		if (NATIVE_BYTES != 2)
+			return m_space->read_dword(byteaddress);
+		if (_Endian == ENDIANNESS_BIG)
+		{
+			UINT32 result = read_word(byteaddress & ~1) << 16;
+			return result | read_word((byteaddress & ~1) + 2);
+		}
+		UINT32 result = read_word(byteaddress & ~1);
+		return result | (read_word((byteaddress & ~1) + 2) << 16);
+	}
+
+	void write_dword(offs_t byteaddress, UINT32 data)
+	{
+		if (NATIVE_BYTES != 2)
+			m_space->write_dword(byteaddress, data);
+		else if (_Endian == ENDIANNESS_BIG)
+		{
+			write_word(byteaddress & ~1, data >> 16);
+			write_word((byteaddress & ~1) + 2, data);
+		}
+		else
+		{
+			write_word(byteaddress & ~1, data);
+			write_word((byteaddress & ~1) + 2, data >> 16);
+		}
+	}
+
+private:
+	// internal state
+	address_space *			m_space;			// the space we are bound to
+	offs_t					m_bytemask;			// byte-converted physical address mask
+	const memory_page_cache *m_read;			// read page cache of the space
+	const memory_page_cache *m_write;			// write page cache of the space
+};
+
+
 
 //**************************************************************************
 //  MACROS
@@ -101,10 +101,12 @@ real_profiler_state::real_profiler_state()
 	: m_enabled(false),
 	  m_dataready(false),
 	  m_filoindex(0),
-	  m_dataindex(0)
+	  m_dataindex(0),
+	  m_total_switches(0)
 {
 	memset(m_filo, 0, sizeof(m_filo));
 	memset(m_data, 0, sizeof(m_data));
+	memset(m_totals, 0, sizeof(m_totals));
 }
 
 
@@ -194,6 +196,7 @@ const char *real_profiler_state::text(running_machine &machine, astring &string)
 		{ PROFILER_TIMER_CALLBACK,   "Timer Callbacks" },
 		{ PROFILER_INPUT,            "Input Processing" },
 		{ PROFILER_MOVIE_REC,        "Movie Recording" },
+		{ PROFILER_REWIND,           "Rewind Snapshots" },
 		{ PROFILER_LOGERROR,         "Error Logging" },
 		{ PROFILER_EXTRA,            "Unaccounted/Overhead" },
 		{ PROFILER_USER1,            "User 1" },
@@ -275,8 +278,11 @@ const char *real_profiler_state::text(running_machine &machine, astring &string)
 		string.catprintf("%d CPU switches\n", switches / (int) ARRAY_LENGTH(m_data));
 	}
 
-	// advance to the next dataset and reset it to 0
+	// advance to the next dataset, retire it into the totals, and reset it to 0
 	m_dataindex = (m_dataindex + 1) % ARRAY_LENGTH(m_data);
+	for (curtype = PROFILER_DEVICE_FIRST; curtype < PROFILER_TOTAL; curtype++)
+		m_totals[curtype] += m_data[m_dataindex].duration[curtype];
+	m_total_switches += m_data[m_dataindex].context_switches;
 	memset(&m_data[m_dataindex], 0, sizeof(m_data[m_dataindex]));
 
 	// we are ready once we have wrapped around
@@ -286,3 +292,74 @@ const char *real_profiler_state::text(running_machine &machine, astring &string)
 	g_profiler.stop();
 	return string;
 }
+
+
+//-------------------------------------------------
+//  accumulated - return the total ticks spent in
+//  the given type since the profiler was enabled
+//-------------------------------------------------
+
+osd_ticks_t real_profiler_state::accumulated(profile_type type) const
+{
+	osd_ticks_t result = m_totals[type];
+	for (int curmem = 0; curmem < ARRAY_LENGTH(m_data); curmem++)
+		result += m_data[curmem].duration[type];
+	return result;
+}
+
+
+//-------------------------------------------------
+//  json - return everything accumulated since the
+//  profiler was enabled as a JSON object, with
+//  each bucket expressed in seconds out of the
+//  given wall-clock time
+//-------------------------------------------------
+
+const char *real_profiler_state::json(running_machine &machine, double seconds, astring &string)
+{
+	// the profile ticks may not be in osd_ticks units, so scale by fraction
+	// of the total tracked time rather than converting them directly
+	osd_ticks_t total = 0;
+	for (profile_type curtype = PROFILER_DEVICE_FIRST; curtype < PROFILER_TOTAL; curtype++)
+		total += accumulated(curtype);
+	if (total == 0)
+		return string.cpy("null");
+	double scale = seconds / (double)total;
+
+	// group the buckets into broad categories
+	osd_ticks_t devices = 0;
+	for (profile_type curtype = PROFILER_DEVICE_FIRST; curtype <= PROFILER_DEVICE_MAX; curtype++)
+		devices += accumulated(curtype);
+	osd_ticks_t memory = accumulated(PROFILER_MEMREAD) + accumulated(PROFILER_MEMWRITE) + accumulated(PROFILER_MEM_REMAP);
+	osd_ticks_t video = accumulated(PROFILER_VIDEO) + accumulated(PROFILER_DRAWGFX) + accumulated(PROFILER_COPYBITMAP) +
+			accumulated(PROFILER_TILEMAP_DRAW) + accumulated(PROFILER_TILEMAP_DRAW_ROZ) + accumulated(PROFILER_TILEMAP_UPDATE) +
+			accumulated(PROFILER_BLIT);
+	osd_ticks_t timers = accumulated(PROFILER_TIMER_CALLBACK);
+	osd_ticks_t sound = accumulated(PROFILER_SOUND);
+	osd_ticks_t idle = accumulated(PROFILER_IDLE);
+	osd_ticks_t other = total - devices - memory - video - timers - sound - idle;
+
+	string.printf("{ \"cpu\": %.6f, \"memory\": %.6f, \"timers\": %.6f, \"sound\": %.6f, \"video\": %.6f, \"idle\": %.6f, \"other\": %.6f",
+			devices * scale, memory * scale, timers * scale, sound * scale, video * scale, idle * scale, other * scale);
+
+	// followed by each device that did any work
+	string.cat(", \"devices\": {");
+	const char *separator = " ";
+	for (profile_type curtype = PROFILER_DEVICE_FIRST; curtype <= PROFILER_DEVICE_MAX; curtype++)
+	{
+		osd_ticks_t computed = accumulated(curtype);
+		device_t *device = machine.devicelist().find(curtype - PROFILER_DEVICE_FIRST);
+		if (computed != 0 && device != NULL)
+		{
+			string.catprintf("%s\"%s\": %.6f", separator, device->tag(), computed * scale);
+			separator = ", ";
+		}
+	}
+
+	// and the context switch count
+	UINT64 switches = m_total_switches;
+	for (int curmem = 0; curmem < ARRAY_LENGTH(m_data); curmem++)
+		switches += m_data[curmem].context_switches;
+	string.catprintf(" }, \"cpu_switches\": %u }", (UINT32)switches);
+	return string;
+}
@@ -80,6 +80,7 @@ enum profile_type
 	PROFILER_TIMER_CALLBACK,
 	PROFILER_INPUT,				// input.c and inptport.c
 	PROFILER_MOVIE_REC,			// movie recording
+	PROFILER_REWIND,			// rewind snapshots
 	PROFILER_LOGERROR,			// logerror
 	PROFILER_EXTRA,				// everything else
 
@@ -120,6 +121,7 @@ public:
 	// getters
 	bool enabled() const { return m_enabled; }
 	const char *text(running_machine &machine, astring &string);
+	const char *json(running_machine &machine, double seconds, astring &string);
 
 	// enable/disable
 	void enable(bool state = true)
@@ -131,6 +133,9 @@ public:
 			{
 				m_dataready = false;
 				m_filoindex = m_dataindex = 0;
+				memset(m_data, 0, sizeof(m_data));
+				memset(m_totals, 0, sizeof(m_totals));
+				m_total_switches = 0;
 			}
 		}
 	}
@@ -142,6 +147,7 @@ public:
 private:
 	void real_start(profile_type type);
 	void real_stop();
+	osd_ticks_t accumulated(profile_type type) const;
 
 	// an entry in the FILO
 	struct filo_entry
@@ -164,6 +170,8 @@ private:
 	UINT8				m_dataindex;				// current data index
 	filo_entry			m_filo[16];					// array of FILO entries
 	history_data		m_data[16];					// array of data
+	osd_ticks_t			m_totals[PROFILER_TOTAL];	// totals retired from the data array since enable
+	UINT64				m_total_switches;			// context switches retired from the data array
 };
 
 
@@ -178,6 +186,7 @@ public:
 	// getters
 	bool enabled() const { return false; }
 	const char *text(running_machine &machine, astring &string) { return string.cpy(""); }
+	const char *json(running_machine &machine, double seconds, astring &string) { return string.cpy("null"); }
 
 	// enable/disable
 	void enable(bool state = true) { }
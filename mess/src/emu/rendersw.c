@@ -14,6 +14,11 @@
     rasterizers that are optimized for a given output format. See
     windows/rendsoft.c for an example.
 
+    Besides the required macros, an instantiation may define
+    NO_DEST_READ, BILINEAR_FILTER, VARIABLE_SHIFT, NO_SIMD to use only
+    the scalar span loops, and QUADS_ONLY to generate nothing but
+    setup_and_draw_textured_quad and the quad rasterizers it calls.
+
 ***************************************************************************/
 
 
@@ -46,6 +51,14 @@
 #define BILINEAR_FILTER 0
 #endif
 
+#if !defined(NO_SIMD)
+#define NO_SIMD 0
+#endif
+
+#if !defined(QUADS_ONLY)
+#define QUADS_ONLY 0
+#endif
+
 
 
 /***************************************************************************
@@ -76,6 +89,18 @@
 
 
 
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+/* targets are split into at most this many bands when a work queue is given */
+#define MAX_BANDS			16
+
+/* and each band is at least this many rows tall */
+#define MIN_BAND_HEIGHT		32
+
+
+
 /***************************************************************************
     TYPE DEFINITIONS
 ***************************************************************************/
@@ -90,6 +115,18 @@ struct _quad_setup_data
 };
 
 
+/* a horizontal band of the target, rendered as one work item */
+typedef struct _band_work_data band_work_data;
+struct _band_work_data
+{
+	const render_primitive_list *primlist;
+	void *			dstdata;
+	INT32			width, height;
+	UINT32			pitch;
+	INT32			top, bottom;
+};
+
+
 
 /***************************************************************************
     GLOBAL VARIABLES
@@ -114,6 +151,22 @@ INLINE float round_nearest(float f)
 }
 
 
+/*-------------------------------------------------
+    init_cosine_table - build up the cosine table
+    used for antialiased lines if we haven't yet
+-------------------------------------------------*/
+
+INLINE void init_cosine_table(void)
+{
+	if (cosine_table[0] == 0)
+	{
+		int entry;
+		for (entry = 0; entry <= 2048; entry++)
+			cosine_table[entry] = (int)((double)(1.0 / cos(atan((double)(entry) / 2048.0))) * 0x10000000 + 0.5);
+	}
+}
+
+
 /*------------------------------------------------------------------------
     ycc_to_rgb - convert YCC to RGB; the YCC pixel
     contains Y in the LSB, Cb << 8, and Cr << 16
@@ -472,6 +525,184 @@ INLINE UINT32 get_texel_argb32_bilinear(const render_texinfo *texture, INT32 cur
 }
 
 
+
+/***************************************************************************
+    SIMD SPAN HELPERS
+***************************************************************************/
+
+/*
+    These process four xRGB pixels at a time, widening each channel to
+    16 bits. Callers only use them when no intermediate can exceed 16
+    bits, so the results match the scalar loops exactly. The alpha byte
+    of the result is always cleared, as DEST_ASSEMBLE_RGB would.
+*/
+
+#if defined(__SSE2__)
+
+#include <emmintrin.h>
+
+#define RENDER_SIMD			1
+
+typedef __m128i render_simd_scale;
+
+
+/*-------------------------------------------------
+    render_simd_make_scale - build a per-channel
+    scale vector for two pixels
+-------------------------------------------------*/
+
+INLINE render_simd_scale render_simd_make_scale(UINT32 r, UINT32 g, UINT32 b)
+{
+	return _mm_set_epi16(0, r, g, b, 0, r, g, b);
+}
+
+
+/*-------------------------------------------------
+    render_simd_modulate4 - scale four source
+    pixels by a color
+-------------------------------------------------*/
+
+INLINE void render_simd_modulate4(UINT32 *dest, const UINT32 *src, render_simd_scale scale)
+{
+	__m128i zero = _mm_setzero_si128();
+	__m128i pix = _mm_loadu_si128((const __m128i *)src);
+	__m128i lo = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(pix, zero), scale), 8);
+	__m128i hi = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(pix, zero), scale), 8);
+	_mm_storeu_si128((__m128i *)dest, _mm_packus_epi16(lo, hi));
+}
+
+
+/*-------------------------------------------------
+    render_simd_blend4 - blend four source pixels
+    over the destination with constant scales
+-------------------------------------------------*/
+
+INLINE void render_simd_blend4(UINT32 *dest, const UINT32 *src, render_simd_scale scale, render_simd_scale invscale)
+{
+	__m128i zero = _mm_setzero_si128();
+	__m128i pix = _mm_loadu_si128((const __m128i *)src);
+	__m128i dpix = _mm_loadu_si128((const __m128i *)dest);
+	__m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(pix, zero), scale), _mm_mullo_epi16(_mm_unpacklo_epi8(dpix, zero), invscale));
+	__m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(pix, zero), scale), _mm_mullo_epi16(_mm_unpackhi_epi8(dpix, zero), invscale));
+	_mm_storeu_si128((__m128i *)dest, _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8)));
+}
+
+
+/*-------------------------------------------------
+    render_simd_alpha_blend4 - blend four ARGB
+    source pixels over the destination using
+    their own alpha; fully transparent pixels
+    leave the destination untouched
+-------------------------------------------------*/
+
+INLINE void render_simd_alpha_blend4(UINT32 *dest, const UINT32 *src)
+{
+	__m128i zero = _mm_setzero_si128();
+	__m128i pix = _mm_loadu_si128((const __m128i *)src);
+	__m128i dpix = _mm_loadu_si128((const __m128i *)dest);
+
+	/* replicate each pixel's alpha across its four 16-bit lanes */
+	__m128i alpha = _mm_srli_epi32(pix, 24);
+	__m128i transparent = _mm_cmpeq_epi32(alpha, zero);
+	alpha = _mm_or_si128(alpha, _mm_slli_epi32(alpha, 16));
+	__m128i alo = _mm_unpacklo_epi32(alpha, alpha);
+	__m128i ahi = _mm_unpackhi_epi32(alpha, alpha);
+	__m128i full = _mm_set1_epi16(0x100);
+
+	__m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(pix, zero), alo), _mm_mullo_epi16(_mm_unpacklo_epi8(dpix, zero), _mm_sub_epi16(full, alo)));
+	__m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(pix, zero), ahi), _mm_mullo_epi16(_mm_unpackhi_epi8(dpix, zero), _mm_sub_epi16(full, ahi)));
+	__m128i result = _mm_and_si128(_mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8)), _mm_set1_epi32(0x00ffffff));
+	result = _mm_or_si128(_mm_and_si128(transparent, dpix), _mm_andnot_si128(transparent, result));
+	_mm_storeu_si128((__m128i *)dest, result);
+}
+
+#elif (defined(__ARM_NEON__) || defined(__ARM_NEON)) && defined(LSB_FIRST)
+
+#include <arm_neon.h>
+
+#define RENDER_SIMD			1
+
+typedef uint16x8_t render_simd_scale;
+
+
+/*-------------------------------------------------
+    render_simd_make_scale - build a per-channel
+    scale vector for two pixels
+-------------------------------------------------*/
+
+INLINE render_simd_scale render_simd_make_scale(UINT32 r, UINT32 g, UINT32 b)
+{
+	const UINT16 lanes[8] = { b, g, r, 0, b, g, r, 0 };
+	return vld1q_u16(lanes);
+}
+
+
+/*-------------------------------------------------
+    render_simd_modulate4 - scale four source
+    pixels by a color
+-------------------------------------------------*/
+
+INLINE void render_simd_modulate4(UINT32 *dest, const UINT32 *src, render_simd_scale scale)
+{
+	uint8x16_t pix = vld1q_u8((const UINT8 *)src);
+	uint16x8_t lo = vshrq_n_u16(vmulq_u16(vmovl_u8(vget_low_u8(pix)), scale), 8);
+	uint16x8_t hi = vshrq_n_u16(vmulq_u16(vmovl_u8(vget_high_u8(pix)), scale), 8);
+	vst1q_u8((UINT8 *)dest, vcombine_u8(vmovn_u16(lo), vmovn_u16(hi)));
+}
+
+
+/*-------------------------------------------------
+    render_simd_blend4 - blend four source pixels
+    over the destination with constant scales
+-------------------------------------------------*/
+
+INLINE void render_simd_blend4(UINT32 *dest, const UINT32 *src, render_simd_scale scale, render_simd_scale invscale)
+{
+	uint8x16_t pix = vld1q_u8((const UINT8 *)src);
+	uint8x16_t dpix = vld1q_u8((const UINT8 *)dest);
+	uint16x8_t lo = vmlaq_u16(vmulq_u16(vmovl_u8(vget_low_u8(pix)), scale), vmovl_u8(vget_low_u8(dpix)), invscale);
+	uint16x8_t hi = vmlaq_u16(vmulq_u16(vmovl_u8(vget_high_u8(pix)), scale), vmovl_u8(vget_high_u8(dpix)), invscale);
+	vst1q_u8((UINT8 *)dest, vcombine_u8(vshrn_n_u16(lo, 8), vshrn_n_u16(hi, 8)));
+}
+
+
+/*-------------------------------------------------
+    render_simd_alpha_blend4 - blend four ARGB
+    source pixels over the destination using
+    their own alpha; fully transparent pixels
+    leave the destination untouched
+-------------------------------------------------*/
+
+INLINE void render_simd_alpha_blend4(UINT32 *dest, const UINT32 *src)
+{
+	uint32x4_t pix32 = vld1q_u32(src);
+	uint32x4_t dpix32 = vld1q_u32(dest);
+	uint8x16_t pix = vreinterpretq_u8_u32(pix32);
+	uint8x16_t dpix = vreinterpretq_u8_u32(dpix32);
+
+	/* replicate each pixel's alpha across its four 16-bit lanes */
+	uint32x4_t alpha = vshrq_n_u32(pix32, 24);
+	uint32x4_t transparent = vceqq_u32(alpha, vdupq_n_u32(0));
+	alpha = vorrq_u32(alpha, vshlq_n_u32(alpha, 16));
+	uint32x4x2_t zipped = vzipq_u32(alpha, alpha);
+	uint16x8_t alo = vreinterpretq_u16_u32(zipped.val[0]);
+	uint16x8_t ahi = vreinterpretq_u16_u32(zipped.val[1]);
+	uint16x8_t full = vdupq_n_u16(0x100);
+
+	uint16x8_t lo = vmlaq_u16(vmulq_u16(vmovl_u8(vget_low_u8(pix)), alo), vmovl_u8(vget_low_u8(dpix)), vsubq_u16(full, alo));
+	uint16x8_t hi = vmlaq_u16(vmulq_u16(vmovl_u8(vget_high_u8(pix)), ahi), vmovl_u8(vget_high_u8(dpix)), vsubq_u16(full, ahi));
+	uint32x4_t result = vreinterpretq_u32_u8(vcombine_u8(vshrn_n_u16(lo, 8), vshrn_n_u16(hi, 8)));
+	result = vandq_u32(result, vdupq_n_u32(0x00ffffff));
+	vst1q_u32(dest, vbslq_u32(transparent, dpix32, result));
+}
+
+#else
+
+#define RENDER_SIMD			0
+
+#endif
+
+
 #endif
 
 
@@ -520,6 +751,13 @@ INLINE UINT32 get_texel_argb32_bilinear(const render_texinfo *texture, INT32 cur
 #endif
 #endif
 
+/* the SIMD span helpers only handle plain 32-bit xRGB destinations */
+#if RENDER_SIMD && !NO_SIMD && !defined(VARIABLE_SHIFT) && (SRCSHIFT_R == 0) && (SRCSHIFT_G == 0) && (SRCSHIFT_B == 0) && (DSTSHIFT_R == 16) && (DSTSHIFT_G == 8) && (DSTSHIFT_B == 0)
+#define SIMD_DEST32			1
+#else
+#define SIMD_DEST32			0
+#endif
+
 /* texel functions */
 #undef GET_TEXEL
 #if BILINEAR_FILTER
@@ -530,6 +768,8 @@ INLINE UINT32 get_texel_argb32_bilinear(const render_texinfo *texture, INT32 cur
 
 
 
+#if !QUADS_ONLY
+
 /***************************************************************************
     LINE RASTERIZERS
 ***************************************************************************/
@@ -559,7 +799,7 @@ INLINE void FUNC_PREFIX(draw_aa_pixel)(void *dstdata, UINT32 pitch, int x, int y
     draw_line - draw a line or point
 -------------------------------------------------*/
 
-static void FUNC_PREFIX(draw_line)(const render_primitive *prim, void *dstdata, INT32 width, INT32 height, UINT32 pitch)
+static void FUNC_PREFIX(draw_line)(const render_primitive *prim, void *dstdata, INT32 width, INT32 height, UINT32 pitch, INT32 top, INT32 bottom)
 {
 	int dx,dy,sx,sy,cx,cy,bwidth;
 	UINT8 a1;
@@ -580,12 +820,7 @@ static void FUNC_PREFIX(draw_line)(const render_primitive *prim, void *dstdata,
 	if (PRIMFLAG_GET_ANTIALIAS(prim->flags))
 	{
 		/* build up the cosine table if we haven't yet */
-		if (cosine_table[0] == 0)
-		{
-			int entry;
-			for (entry = 0; entry <= 2048; entry++)
-				cosine_table[entry] = (int)((double)(1.0 / cos(atan((double)(entry) / 2048.0))) * 0x10000000 + 0.5);
-		}
+		init_cosine_table();
 
 		beam = prim->width * 65536.0f;
 		if (beam < 0x00010000)
@@ -611,7 +846,7 @@ static void FUNC_PREFIX(draw_line)(const render_primitive *prim, void *dstdata,
 				{
 					dx = bwidth;    /* init diameter of beam */
 					dy = y1 >> 16;
-					if (dy >= 0 && dy < height)
+					if (dy >= top && dy < bottom)
 						FUNC_PREFIX(draw_aa_pixel)(dstdata, pitch, x1, dy, Tinten(0xff & (~y1 >> 8), col));
 					dy++;
 					dx -= 0x10000 - (0xffff & y1); /* take off amount plotted */
@@ -619,11 +854,11 @@ static void FUNC_PREFIX(draw_line)(const render_primitive *prim, void *dstdata,
 					dx >>= 16;                   /* adjust to pixel (solid) count */
 					while (dx--)                 /* plot rest of pixels */
 					{
-						if (dy >= 0 && dy < height)
+						if (dy >= top && dy < bottom)
 							FUNC_PREFIX(draw_aa_pixel)(dstdata, pitch, x1, dy, col);
 						dy++;
 					}
-					if (dy >= 0 && dy < height)
+					if (dy >= top && dy < bottom)
 						FUNC_PREFIX(draw_aa_pixel)(dstdata, pitch, x1, dy, Tinten(a1,col));
 				}
 				if (x1 == xx) break;
@@ -643,7 +878,7 @@ static void FUNC_PREFIX(draw_line)(const render_primitive *prim, void *dstdata,
 			x1 -= bwidth >> 1; /* start back half the width */
 			for (;;)
 			{
-				if (y1 >= 0 && y1 < height)
+				if (y1 >= top && y1 < bottom)
 				{
 					dy = bwidth;    /* calc diameter of beam */
 					dx = x1 >> 16;
@@ -686,7 +921,7 @@ static void FUNC_PREFIX(draw_line)(const render_primitive *prim, void *dstdata,
 		{
 			for (;;)
 			{
-				if (x1 >= 0 && x1 < width && y1 >= 0 && y1 < height)
+				if (x1 >= 0 && x1 < width && y1 >= top && y1 < bottom)
 					FUNC_PREFIX(draw_aa_pixel)(dstdata, pitch, x1, y1, col);
 				if (x1 == x2) break;
 				x1 += sx;
@@ -702,7 +937,7 @@ static void FUNC_PREFIX(draw_line)(const render_primitive *prim, void *dstdata,
 		{
 			for (;;)
 			{
-				if (x1 >= 0 && x1 < width && y1 >= 0 && y1 < height)
+				if (x1 >= 0 && x1 < width && y1 >= top && y1 < bottom)
 					FUNC_PREFIX(draw_aa_pixel)(dstdata, pitch, x1, y1, col);
 				if (y1 == y2) break;
 				y1 += sy;
@@ -727,7 +962,7 @@ static void FUNC_PREFIX(draw_line)(const render_primitive *prim, void *dstdata,
     draw_rect - draw a solid rectangle
 -------------------------------------------------*/
 
-static void FUNC_PREFIX(draw_rect)(const render_primitive *prim, void *dstdata, INT32 width, INT32 height, UINT32 pitch)
+static void FUNC_PREFIX(draw_rect)(const render_primitive *prim, void *dstdata, INT32 width, INT32 height, UINT32 pitch, INT32 top, INT32 bottom)
 {
 	render_bounds fpos = prim->bounds;
 	INT32 startx, starty, endx, endy;
@@ -752,6 +987,10 @@ static void FUNC_PREFIX(draw_rect)(const render_primitive *prim, void *dstdata,
 	if (endy < 0) endy = 0;
 	if (endy >= height) endy = height;
 
+	/* clip to the band */
+	if (starty < top) starty = top;
+	if (endy > bottom) endy = bottom;
+
 	/* bail if nothing left */
 	if (fpos.x0 > fpos.x1 || fpos.y0 > fpos.y1)
 		return;
@@ -825,6 +1064,8 @@ static void FUNC_PREFIX(draw_rect)(const render_primitive *prim, void *dstdata,
 	}
 }
 
+#endif	/* !QUADS_ONLY */
+
 
 
 /***************************************************************************
@@ -879,6 +1120,10 @@ static void FUNC_PREFIX(draw_quad_palette16_none)(const render_primitive *prim,
 		if (sg > 0x100) { if ((INT32)sg < 0) sg = 0; else sg = 0x100; }
 		if (sb > 0x100) { if ((INT32)sb < 0) sb = 0; else sb = 0x100; }
 
+#if SIMD_DEST32
+		render_simd_scale simd_scale = render_simd_make_scale(sr, sg, sb);
+#endif
+
 		/* loop over rows */
 		for (y = setup->starty; y < setup->endy; y++)
 		{
@@ -886,8 +1131,24 @@ static void FUNC_PREFIX(draw_quad_palette16_none)(const render_primitive *prim,
 			INT32 curu = setup->startu + (y - setup->starty) * setup->dudy;
 			INT32 curv = setup->startv + (y - setup->starty) * setup->dvdy;
 
+			x = setup->startx;
+#if SIMD_DEST32
+			/* four pixels at a time */
+			for ( ; x + 4 <= endx; x += 4, dest += 4)
+			{
+				UINT32 pix[4];
+				for (int pixnum = 0; pixnum < 4; pixnum++)
+				{
+					pix[pixnum] = GET_TEXEL(palette16)(&prim->texture, curu, curv);
+					curu += dudx;
+					curv += dvdx;
+				}
+				render_simd_modulate4(dest, pix, simd_scale);
+			}
+#endif
+
 			/* loop over cols */
-			for (x = setup->startx; x < endx; x++)
+			for ( ; x < endx; x++)
 			{
 				UINT32 pix = GET_TEXEL(palette16)(&prim->texture, curu, curv);
 				UINT32 r = (SOURCE32_R(pix) * sr) >> 8;
@@ -915,6 +1176,13 @@ static void FUNC_PREFIX(draw_quad_palette16_none)(const render_primitive *prim,
 		if (sb > 0x100) { if ((INT32)sb < 0) sb = 0; else sb = 0x100; }
 		if (invsa > 0x100) { if ((INT32)invsa < 0) invsa = 0; else invsa = 0x100; }
 
+#if SIMD_DEST32
+		/* the SIMD helpers keep 16-bit intermediates, which is exact while the scales sum to 256 or less */
+		render_simd_scale simd_scale = render_simd_make_scale(sr, sg, sb);
+		render_simd_scale simd_invscale = render_simd_make_scale(invsa, invsa, invsa);
+		int simd_ok = (!NO_DEST_READ && MAX(sr, MAX(sg, sb)) + invsa <= 0x100);
+#endif
+
 		/* loop over rows */
 		for (y = setup->starty; y < setup->endy; y++)
 		{
@@ -922,8 +1190,24 @@ static void FUNC_PREFIX(draw_quad_palette16_none)(const render_primitive *prim,
 			INT32 curu = setup->startu + (y - setup->starty) * setup->dudy;
 			INT32 curv = setup->startv + (y - setup->starty) * setup->dvdy;
 
+			x = setup->startx;
+#if SIMD_DEST32
+			/* four pixels at a time */
+			for ( ; simd_ok && x + 4 <= endx; x += 4, dest += 4)
+			{
+				UINT32 pix[4];
+				for (int pixnum = 0; pixnum < 4; pixnum++)
+				{
+					pix[pixnum] = GET_TEXEL(palette16)(&prim->texture, curu, curv);
+					curu += dudx;
+					curv += dvdx;
+				}
+				render_simd_blend4(dest, pix, simd_scale, simd_invscale);
+			}
+#endif
+
 			/* loop over cols */
-			for (x = setup->startx; x < endx; x++)
+			for ( ; x < endx; x++)
 			{
 				UINT32 pix = GET_TEXEL(palette16)(&prim->texture, curu, curv);
 				UINT32 dpix = NO_DEST_READ ? 0 : *dest;
@@ -1194,6 +1478,10 @@ static void FUNC_PREFIX(draw_quad_yuy16_none)(const render_primitive *prim, void
 		if (sg > 0x100) { if ((INT32)sg < 0) sg = 0; else sg = 0x100; }
 		if (sb > 0x100) { if ((INT32)sb < 0) sb = 0; else sb = 0x100; }
 
+#if SIMD_DEST32
+		render_simd_scale simd_scale = render_simd_make_scale(sr, sg, sb);
+#endif
+
 		/* loop over rows */
 		for (y = setup->starty; y < setup->endy; y++)
 		{
@@ -1204,8 +1492,24 @@ static void FUNC_PREFIX(draw_quad_yuy16_none)(const render_primitive *prim, void
 			/* no lookup case */
 			if (palbase == NULL)
 			{
+				x = setup->startx;
+#if SIMD_DEST32
+				/* four pixels at a time */
+				for ( ; x + 4 <= endx; x += 4, dest += 4)
+				{
+					UINT32 pix[4];
+					for (int pixnum = 0; pixnum < 4; pixnum++)
+					{
+						pix[pixnum] = ycc_to_rgb(GET_TEXEL(yuy16)(&prim->texture, curu, curv));
+						curu += dudx;
+						curv += dvdx;
+					}
+					render_simd_modulate4(dest, pix, simd_scale);
+				}
+#endif
+
 				/* loop over cols */
-				for (x = setup->startx; x < endx; x++)
+				for ( ; x < endx; x++)
 				{
 					UINT32 pix = ycc_to_rgb(GET_TEXEL(yuy16)(&prim->texture, curu, curv));
 					UINT32 r = (SOURCE32_R(pix) * sr) >> 8;
@@ -1221,8 +1525,24 @@ static void FUNC_PREFIX(draw_quad_yuy16_none)(const render_primitive *prim, void
 			/* lookup case */
 			else
 			{
+				x = setup->startx;
+#if SIMD_DEST32
+				/* four pixels at a time */
+				for ( ; x + 4 <= endx; x += 4, dest += 4)
+				{
+					UINT32 pix[4];
+					for (int pixnum = 0; pixnum < 4; pixnum++)
+					{
+						pix[pixnum] = ycc_to_rgb(GET_TEXEL(yuy16)(&prim->texture, curu, curv));
+						curu += dudx;
+						curv += dvdx;
+					}
+					render_simd_modulate4(dest, pix, simd_scale);
+				}
+#endif
+
 				/* loop over cols */
-				for (x = setup->startx; x < endx; x++)
+				for ( ; x < endx; x++)
 				{
 					UINT32 pix = ycc_to_rgb(GET_TEXEL(yuy16)(&prim->texture, curu, curv));
 					UINT32 r = (SOURCE32_R(pix) * sr) >> 8;
@@ -1251,6 +1571,13 @@ static void FUNC_PREFIX(draw_quad_yuy16_none)(const render_primitive *prim, void
 		if (sb > 0x100) { if ((INT32)sb < 0) sb = 0; else sb = 0x100; }
 		if (invsa > 0x100) { if ((INT32)invsa < 0) invsa = 0; else invsa = 0x100; }
 
+#if SIMD_DEST32
+		/* the SIMD helpers keep 16-bit intermediates, which is exact while the scales sum to 256 or less */
+		render_simd_scale simd_scale = render_simd_make_scale(sr, sg, sb);
+		render_simd_scale simd_invscale = render_simd_make_scale(invsa, invsa, invsa);
+		int simd_ok = (!NO_DEST_READ && MAX(sr, MAX(sg, sb)) + invsa <= 0x100);
+#endif
+
 		/* loop over rows */
 		for (y = setup->starty; y < setup->endy; y++)
 		{
@@ -1261,8 +1588,24 @@ static void FUNC_PREFIX(draw_quad_yuy16_none)(const render_primitive *prim, void
 			/* no lookup case */
 			if (palbase == NULL)
 			{
+				x = setup->startx;
+#if SIMD_DEST32
+				/* four pixels at a time */
+				for ( ; simd_ok && x + 4 <= endx; x += 4, dest += 4)
+				{
+					UINT32 pix[4];
+					for (int pixnum = 0; pixnum < 4; pixnum++)
+					{
+						pix[pixnum] = ycc_to_rgb(GET_TEXEL(yuy16)(&prim->texture, curu, curv));
+						curu += dudx;
+						curv += dvdx;
+					}
+					render_simd_blend4(dest, pix, simd_scale, simd_invscale);
+				}
+#endif
+
 				/* loop over cols */
-				for (x = setup->startx; x < endx; x++)
+				for ( ; x < endx; x++)
 				{
 					UINT32 pix = ycc_to_rgb(GET_TEXEL(yuy16)(&prim->texture, curu, curv));
 					UINT32 dpix = NO_DEST_READ ? 0 : *dest;
@@ -1279,8 +1622,24 @@ static void FUNC_PREFIX(draw_quad_yuy16_none)(const render_primitive *prim, void
 			/* lookup case */
 			else
 			{
+				x = setup->startx;
+#if SIMD_DEST32
+				/* four pixels at a time */
+				for ( ; simd_ok && x + 4 <= endx; x += 4, dest += 4)
+				{
+					UINT32 pix[4];
+					for (int pixnum = 0; pixnum < 4; pixnum++)
+					{
+						pix[pixnum] = ycc_to_rgb(GET_TEXEL(yuy16)(&prim->texture, curu, curv));
+						curu += dudx;
+						curv += dvdx;
+					}
+					render_simd_blend4(dest, pix, simd_scale, simd_invscale);
+				}
+#endif
+
 				/* loop over cols */
-				for (x = setup->startx; x < endx; x++)
+				for ( ; x < endx; x++)
 				{
 					UINT32 pix = ycc_to_rgb(GET_TEXEL(yuy16)(&prim->texture, curu, curv));
 					UINT32 dpix = NO_DEST_READ ? 0 : *dest;
@@ -1545,6 +1904,10 @@ static void FUNC_PREFIX(draw_quad_rgb32)(const render_primitive *prim, void *dst
 		if (sg > 0x100) { if ((INT32)sg < 0) sg = 0; else sg = 0x100; }
 		if (sb > 0x100) { if ((INT32)sb < 0) sb = 0; else sb = 0x100; }
 
+#if SIMD_DEST32
+		render_simd_scale simd_scale = render_simd_make_scale(sr, sg, sb);
+#endif
+
 		/* loop over rows */
 		for (y = setup->starty; y < setup->endy; y++)
 		{
@@ -1555,8 +1918,24 @@ static void FUNC_PREFIX(draw_quad_rgb32)(const render_primitive *prim, void *dst
 			/* no lookup case */
 			if (palbase == NULL)
 			{
+				x = setup->startx;
+#if SIMD_DEST32
+				/* four pixels at a time */
+				for ( ; x + 4 <= endx; x += 4, dest += 4)
+				{
+					UINT32 pix[4];
+					for (int pixnum = 0; pixnum < 4; pixnum++)
+					{
+						pix[pixnum] = GET_TEXEL(rgb32)(&prim->texture, curu, curv);
+						curu += dudx;
+						curv += dvdx;
+					}
+					render_simd_modulate4(dest, pix, simd_scale);
+				}
+#endif
+
 				/* loop over cols */
-				for (x = setup->startx; x < endx; x++)
+				for ( ; x < endx; x++)
 				{
 					UINT32 pix = GET_TEXEL(rgb32)(&prim->texture, curu, curv);
 					UINT32 r = (SOURCE32_R(pix) * sr) >> 8;
@@ -1602,6 +1981,13 @@ static void FUNC_PREFIX(draw_quad_rgb32)(const render_primitive *prim, void *dst
 		if (sb > 0x100) { if ((INT32)sb < 0) sb = 0; else sb = 0x100; }
 		if (invsa > 0x100) { if ((INT32)invsa < 0) invsa = 0; else invsa = 0x100; }
 
+#if SIMD_DEST32
+		/* the SIMD helpers keep 16-bit intermediates, which is exact while the scales sum to 256 or less */
+		render_simd_scale simd_scale = render_simd_make_scale(sr, sg, sb);
+		render_simd_scale simd_invscale = render_simd_make_scale(invsa, invsa, invsa);
+		int simd_ok = (!NO_DEST_READ && MAX(sr, MAX(sg, sb)) + invsa <= 0x100);
+#endif
+
 		/* loop over rows */
 		for (y = setup->starty; y < setup->endy; y++)
 		{
@@ -1612,8 +1998,24 @@ static void FUNC_PREFIX(draw_quad_rgb32)(const render_primitive *prim, void *dst
 			/* no lookup case */
 			if (palbase == NULL)
 			{
+				x = setup->startx;
+#if SIMD_DEST32
+				/* four pixels at a time */
+				for ( ; simd_ok && x + 4 <= endx; x += 4, dest += 4)
+				{
+					UINT32 pix[4];
+					for (int pixnum = 0; pixnum < 4; pixnum++)
+					{
+						pix[pixnum] = GET_TEXEL(rgb32)(&prim->texture, curu, curv);
+						curu += dudx;
+						curv += dvdx;
+					}
+					render_simd_blend4(dest, pix, simd_scale, simd_invscale);
+				}
+#endif
+
 				/* loop over cols */
-				for (x = setup->startx; x < endx; x++)
+				for ( ; x < endx; x++)
 				{
 					UINT32 pix = GET_TEXEL(rgb32)(&prim->texture, curu, curv);
 					UINT32 dpix = NO_DEST_READ ? 0 : *dest;
@@ -1814,8 +2216,24 @@ static void FUNC_PREFIX(draw_quad_argb32_alpha)(const render_primitive *prim, vo
 			/* no lookup case */
 			if (palbase == NULL)
 			{
+				x = setup->startx;
+#if SIMD_DEST32
+				/* four pixels at a time */
+				for ( ; !NO_DEST_READ && x + 4 <= endx; x += 4, dest += 4)
+				{
+					UINT32 pix[4];
+					for (int pixnum = 0; pixnum < 4; pixnum++)
+					{
+						pix[pixnum] = GET_TEXEL(argb32)(&prim->texture, curu, curv);
+						curu += dudx;
+						curv += dvdx;
+					}
+					render_simd_alpha_blend4(dest, pix);
+				}
+#endif
+
 				/* loop over cols */
-				for (x = setup->startx; x < endx; x++)
+				for ( ; x < endx; x++)
 				{
 					UINT32 pix = GET_TEXEL(argb32)(&prim->texture, curu, curv);
 					UINT32 ta = pix >> 24;
@@ -2220,7 +2638,7 @@ static void FUNC_PREFIX(draw_quad_argb32_add)(const render_primitive *prim, void
     drawing routine
 -------------------------------------------------*/
 
-static void FUNC_PREFIX(setup_and_draw_textured_quad)(const render_primitive *prim, void *dstdata, INT32 width, INT32 height, UINT32 pitch)
+static void FUNC_PREFIX(setup_and_draw_textured_quad)(const render_primitive *prim, void *dstdata, INT32 width, INT32 height, UINT32 pitch, INT32 top, INT32 bottom)
 {
 	float fdudx, fdvdx, fdudy, fdvdy;
 	quad_setup_data setup;
@@ -2269,6 +2687,15 @@ static void FUNC_PREFIX(setup_and_draw_textured_quad)(const render_primitive *pr
 		setup.startv -= 0x8000;
 	}
 
+	/* clip to the band, keeping the texture anchored to the unbanded first row */
+	if (setup.starty < top)
+	{
+		setup.startu += (top - setup.starty) * setup.dudy;
+		setup.startv += (top - setup.starty) * setup.dvdy;
+		setup.starty = top;
+	}
+	if (setup.endy > bottom) setup.endy = bottom;
+
 	/* render based on the texture coordinates */
 	switch (prim->flags & (PRIMFLAG_TEXFORMAT_MASK | PRIMFLAG_BLENDMODE_MASK))
 	{
@@ -2324,16 +2751,18 @@ static void FUNC_PREFIX(setup_and_draw_textured_quad)(const render_primitive *pr
 
 
 
+#if !QUADS_ONLY
+
 /***************************************************************************
     PRIMARY ENTRY POINT
 ***************************************************************************/
 
 /*-------------------------------------------------
-    draw_primitives - draw a series of primitives
-    using a software rasterizer
+    draw_band - render the primitives that touch
+    one horizontal band of the target, in order
 -------------------------------------------------*/
 
-static void FUNC_PREFIX(draw_primitives)(const render_primitive_list &primlist, void *dstdata, UINT32 width, UINT32 height, UINT32 pitch)
+static void FUNC_PREFIX(draw_band)(const render_primitive_list &primlist, void *dstdata, INT32 width, INT32 height, UINT32 pitch, INT32 top, INT32 bottom)
 {
 	const render_primitive *prim;
 
@@ -2342,14 +2771,14 @@ static void FUNC_PREFIX(draw_primitives)(const render_primitive_list &primlist,
 		switch (prim->type)
 		{
 			case render_primitive::LINE:
-				FUNC_PREFIX(draw_line)(prim, dstdata, width, height, pitch);
+				FUNC_PREFIX(draw_line)(prim, dstdata, width, height, pitch, top, bottom);
 				break;
 
 			case render_primitive::QUAD:
 				if (!prim->texture.base)
-					FUNC_PREFIX(draw_rect)(prim, dstdata, width, height, pitch);
+					FUNC_PREFIX(draw_rect)(prim, dstdata, width, height, pitch, top, bottom);
 				else
-					FUNC_PREFIX(setup_and_draw_textured_quad)(prim, dstdata, width, height, pitch);
+					FUNC_PREFIX(setup_and_draw_textured_quad)(prim, dstdata, width, height, pitch, top, bottom);
 				break;
 
 			default:
@@ -2358,6 +2787,61 @@ static void FUNC_PREFIX(draw_primitives)(const render_primitive_list &primlist,
 }
 
 
+/*-------------------------------------------------
+    draw_band_callback - work item callback that
+    renders a single band
+-------------------------------------------------*/
+
+static void *FUNC_PREFIX(draw_band_callback)(void *param, int threadid)
+{
+	band_work_data *band = (band_work_data *)param;
+	FUNC_PREFIX(draw_band)(*band->primlist, band->dstdata, band->width, band->height, band->pitch, band->top, band->bottom);
+	return NULL;
+}
+
+
+/*-------------------------------------------------
+    draw_primitives - render a list of primitives;
+    if a work queue is given, large targets are
+    split into bands rendered in parallel
+-------------------------------------------------*/
+
+static void FUNC_PREFIX(draw_primitives)(const render_primitive_list &primlist, void *dstdata, UINT32 width, UINT32 height, UINT32 pitch, osd_work_queue *queue)
+{
+	band_work_data band[MAX_BANDS];
+	int bands = (queue != NULL) ? MIN((int)(height / MIN_BAND_HEIGHT), MAX_BANDS) : 1;
+	int bandnum;
+
+	/* small targets are drawn in one go */
+	if (bands <= 1)
+	{
+		FUNC_PREFIX(draw_band)(primlist, dstdata, width, height, pitch, 0, height);
+		return;
+	}
+
+	/* the bands share this table, so build it before they start */
+	init_cosine_table();
+
+	/* split the target evenly; each band walks the whole list so primitive order is preserved */
+	for (bandnum = 0; bandnum < bands; bandnum++)
+	{
+		band[bandnum].primlist = &primlist;
+		band[bandnum].dstdata = dstdata;
+		band[bandnum].width = width;
+		band[bandnum].height = height;
+		band[bandnum].pitch = pitch;
+		band[bandnum].top = height * bandnum / bands;
+		band[bandnum].bottom = height * (bandnum + 1) / bands;
+	}
+
+	/* queue them all and wait; the band data lives on our stack */
+	osd_work_item_queue_multiple(queue, FUNC_PREFIX(draw_band_callback), bands, band, sizeof(band[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+	while (!osd_work_queue_wait(queue, osd_ticks_per_second() * 10)) ;
+}
+
+#endif	/* !QUADS_ONLY */
+
+
 
 /***************************************************************************
     MACRO UNDOING
@@ -2381,6 +2865,8 @@ static void FUNC_PREFIX(draw_primitives)(const render_primitive_list &primlist,
 #undef SOURCE15_TO_DEST
 #undef SOURCE32_TO_DEST
 
+#undef SIMD_DEST32
+
 #undef FUNC_PREFIX
 #undef PIXEL_TYPE
 
@@ -2393,5 +2879,8 @@ static void FUNC_PREFIX(draw_primitives)(const render_primitive_list &primlist,
 #undef DSTSHIFT_B
 
 #undef NO_DEST_READ
+#undef BILINEAR_FILTER
+#undef NO_SIMD
+#undef QUADS_ONLY
 
 #undef VARIABLE_SHIFT
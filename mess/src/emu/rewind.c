@@ -0,0 +1,308 @@
+/***************************************************************************
+
+    rewind.c
+
+    Rewind support built on in-memory save states.
+
+    Copyright Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+****************************************************************************
+
+    Every few frames the whole machine state is captured with
+    save_manager::write_buffer. Each capture is XORed against the one
+    before it, which leaves mostly zeros for the parts of the state that
+    did not change, and the result is deflated into a fixed-size ring.
+
+    The first step back after a capture simply reloads that capture.
+    Each further step takes the newest entry off the ring, inflates it
+    and XORs it into the most recent capture, which yields the capture
+    before that. When the ring is full the oldest entries are discarded.
+
+    Captures and restores only happen between timeslices, never from
+    inside a timer callback, and only when the scheduler says it is safe
+    to save.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "emuopts.h"
+#include "rewind.h"
+
+#include <zlib.h>
+
+
+//**************************************************************************
+//  DEBUGGING
+//**************************************************************************
+
+#define VERBOSE 0
+
+#define LOG(x) do { if (VERBOSE) logerror x; } while (0)
+
+
+
+//**************************************************************************
+//  REWIND MANAGER
+//**************************************************************************
+
+//-------------------------------------------------
+//  rewind_manager - constructor
+//-------------------------------------------------
+
+rewind_manager::rewind_manager(running_machine &machine)
+	: m_machine(machine),
+	  m_enabled(machine.options().rewind()),
+	  m_interval(MAX(machine.options().rewind_interval(), 1)),
+	  m_level(MIN(MAX(machine.options().rewind_compression(), Z_NO_COMPRESSION), Z_BEST_COMPRESSION)),
+	  m_state_size(machine.save().state_size()),
+	  m_frames(0),
+	  m_capture_pending(false),
+	  m_step_pending(false),
+	  m_have_previous(false),
+	  m_at_previous(false),
+	  m_previous(NULL),
+	  m_current(NULL),
+	  m_compressed(NULL),
+	  m_ring(NULL),
+	  m_ring_size(0),
+	  m_write(0),
+	  m_snapshots(NULL),
+	  m_capacity(0),
+	  m_first(0),
+	  m_count(0)
+{
+	// nothing to do if we're disabled or there is no state to speak of
+	if (!m_enabled)
+		return;
+	// the ring is indexed with 32-bit offsets, so keep it under 2GB; the option range enforces the same
+	UINT64 ringbytes = (UINT64)machine.options().rewind_memory() * 1024 * 1024;
+	if (m_state_size == 0 || machine.options().rewind_memory() <= 0 || ringbytes >= U64(0x80000000))
+	{
+		m_enabled = false;
+		return;
+	}
+
+	// allocate working buffers
+	m_previous = auto_alloc_array_clear(machine, UINT8, m_state_size);
+	m_current = auto_alloc_array_clear(machine, UINT8, m_state_size);
+	m_compressed = auto_alloc_array(machine, UINT8, compressBound(m_state_size));
+
+	// allocate the ring and an index generous enough for well-compressed snapshots
+	m_ring_size = (UINT32)ringbytes;
+	m_ring = auto_alloc_array(machine, UINT8, m_ring_size);
+	m_capacity = MAX(m_ring_size / 256, 16);
+	m_snapshots = auto_alloc_array(machine, snapshot, m_capacity);
+
+	// count frames as they go by
+	machine.add_notifier(MACHINE_NOTIFY_FRAME, machine_notify_delegate(FUNC(rewind_manager::frame_tick), this));
+}
+
+
+//-------------------------------------------------
+//  memory_used - return the number of bytes of
+//  the ring currently in use
+//-------------------------------------------------
+
+UINT32 rewind_manager::memory_used() const
+{
+	UINT32 total = 0;
+	for (int snapnum = 0; snapnum < m_count; snapnum++)
+		total += m_snapshots[(m_first + snapnum) % m_capacity].m_size;
+	return total;
+}
+
+
+//-------------------------------------------------
+//  update - perform any pending captures or
+//  restores; called between timeslices
+//-------------------------------------------------
+
+void rewind_manager::update()
+{
+	// quick exit if there's nothing to do
+	if (!m_capture_pending && !m_step_pending)
+		return;
+
+	// if there are anonymous timers outstanding, wait for them to clear
+	if (!machine().scheduler().can_save())
+		return;
+
+	g_profiler.start(PROFILER_REWIND);
+
+	// a step back takes precedence and resets the capture interval
+	if (m_step_pending)
+	{
+		m_step_pending = false;
+		if (restore())
+			popmessage("Rewind (%d)", m_count);
+		else
+			popmessage("Rewind: no more history");
+		m_capture_pending = false;
+		m_frames = 0;
+	}
+
+	// otherwise, take a snapshot
+	else
+	{
+		m_capture_pending = false;
+		capture();
+	}
+
+	g_profiler.stop();
+}
+
+
+//-------------------------------------------------
+//  frame_tick - count frames and flag when a
+//  capture is due
+//-------------------------------------------------
+
+void rewind_manager::frame_tick()
+{
+	// paused frames don't count
+	if (machine().paused())
+		return;
+	if (++m_frames >= m_interval)
+	{
+		m_frames = 0;
+		m_capture_pending = true;
+	}
+}
+
+
+//-------------------------------------------------
+//  capture - snapshot the current state and add
+//  it to the ring
+//-------------------------------------------------
+
+void rewind_manager::capture()
+{
+	// grab the state
+	if (machine().save().write_buffer(m_current, m_state_size) != STATERR_NONE)
+		return;
+
+	// the machine has now moved on from whatever it was restored to
+	m_at_previous = false;
+
+	// the very first capture just seeds the chain
+	if (!m_have_previous)
+	{
+		memcpy(m_previous, m_current, m_state_size);
+		m_have_previous = true;
+		return;
+	}
+
+	// XOR against the previous capture, which then becomes the current one
+	xor_state(m_previous, m_current);
+	uLongf complen = compressBound(m_state_size);
+	int zerr = compress2(m_compressed, &complen, m_previous, m_state_size, m_level);
+	UINT8 *temp = m_previous;
+	m_previous = m_current;
+	m_current = temp;
+	if (zerr != Z_OK || complen > m_ring_size)
+	{
+		// the chain is broken; start over from this capture
+		LOG(("rewind: unable to store snapshot (zerr=%d, size=%d)\n", zerr, (int)complen));
+		while (m_count > 0)
+			discard_oldest();
+		return;
+	}
+
+	// wrap if we don't fit at the end; anything left in the tail is the oldest data
+	if (m_write + complen > m_ring_size)
+	{
+		while (m_count > 0 && m_snapshots[m_first].m_offset >= m_write)
+			discard_oldest();
+		m_write = 0;
+	}
+
+	// discard anything we are about to overwrite, or make room in the index
+	while (m_count > 0 && (m_count == m_capacity || (m_snapshots[m_first].m_offset >= m_write && m_snapshots[m_first].m_offset < m_write + complen)))
+		discard_oldest();
+
+	// append the new snapshot
+	snapshot &snap = m_snapshots[(m_first + m_count++) % m_capacity];
+	snap.m_offset = m_write;
+	snap.m_size = complen;
+	memcpy(&m_ring[m_write], m_compressed, complen);
+	m_write += complen;
+	LOG(("rewind: stored snapshot %d, %d bytes\n", m_count, (int)complen));
+}
+
+
+//-------------------------------------------------
+//  restore - step back to the newest capture, or
+//  if we are already there, to the one before it
+//-------------------------------------------------
+
+bool rewind_manager::restore()
+{
+	if (!m_have_previous)
+		return false;
+
+	// the first step after a capture goes back to that capture itself
+	if (!m_at_previous)
+	{
+		m_at_previous = true;
+		return (machine().save().read_buffer(m_previous, m_state_size) == STATERR_NONE);
+	}
+
+	// beyond that, walk back through the deltas
+	if (m_count == 0)
+		return false;
+
+	// pull the newest snapshot off the ring and reclaim its space
+	snapshot &snap = m_snapshots[(m_first + m_count - 1) % m_capacity];
+	m_count--;
+	m_write = snap.m_offset;
+
+	// inflate it and XOR it into the newest capture to get the one before
+	uLongf destlen = m_state_size;
+	if (uncompress(m_current, &destlen, &m_ring[snap.m_offset], snap.m_size) != Z_OK || destlen != m_state_size)
+	{
+		m_have_previous = false;
+		while (m_count > 0)
+			discard_oldest();
+		return false;
+	}
+	xor_state(m_previous, m_current);
+
+	// and make it live
+	return (machine().save().read_buffer(m_previous, m_state_size) == STATERR_NONE);
+}
+
+
+//-------------------------------------------------
+//  discard_oldest - throw away the oldest
+//  snapshot in the ring
+//-------------------------------------------------
+
+void rewind_manager::discard_oldest()
+{
+	assert(m_count > 0);
+	m_first = (m_first + 1) % m_capacity;
+	m_count--;
+	if (m_count == 0)
+		m_write = 0;
+}
+
+
+//-------------------------------------------------
+//  xor_state - XOR a state into another, a word
+//  at a time where possible
+//-------------------------------------------------
+
+void rewind_manager::xor_state(UINT8 *dest, const UINT8 *source) const
+{
+	// buffers come straight from the allocator, so they are suitably aligned
+	UINT32 words = m_state_size / sizeof(UINT64);
+	UINT64 *dest64 = reinterpret_cast<UINT64 *>(dest);
+	const UINT64 *source64 = reinterpret_cast<const UINT64 *>(source);
+	for (UINT32 wordnum = 0; wordnum < words; wordnum++)
+		dest64[wordnum] ^= source64[wordnum];
+
+	// handle any stragglers
+	for (UINT32 bytenum = words * sizeof(UINT64); bytenum < m_state_size; bytenum++)
+		dest[bytenum] ^= source[bytenum];
+}
@@ -0,0 +1,88 @@
+/***************************************************************************
+
+    rewind.h
+
+    Rewind support built on in-memory save states.
+
+    Copyright Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __REWIND_H__
+#define __REWIND_H__
+
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> rewind_manager
+
+// keeps a fixed-size ring of compressed snapshots, each one stored as the
+// XOR of a state with the state captured just before it
+class rewind_manager
+{
+public:
+	// construction/destruction
+	rewind_manager(running_machine &machine);
+
+	// getters
+	running_machine &machine() const { return m_machine; }
+	bool enabled() const { return m_enabled; }
+	int snapshot_count() const { return m_count; }
+	UINT32 memory_used() const;
+
+	// control
+	void step_back() { if (m_enabled) m_step_pending = true; }
+	void update();
+
+private:
+	// internal helpers
+	void frame_tick();
+	void capture();
+	bool restore();
+	void discard_oldest();
+	void xor_state(UINT8 *dest, const UINT8 *source) const;
+
+	// a single compressed snapshot within the ring
+	struct snapshot
+	{
+		UINT32				m_offset;				// offset of the data within the ring
+		UINT32				m_size;					// compressed size of the data
+	};
+
+	// internal state
+	running_machine &		m_machine;				// reference to our machine
+	bool					m_enabled;				// is rewind enabled?
+	int						m_interval;				// number of frames between snapshots
+	int						m_level;				// zlib compression level
+	UINT32					m_state_size;			// size of a single uncompressed state
+
+	// frame tracking
+	int						m_frames;				// frames since the last snapshot
+	bool					m_capture_pending;		// do we owe a snapshot?
+	bool					m_step_pending;			// has a step back been requested?
+	bool					m_have_previous;		// is m_previous valid?
+	bool					m_at_previous;			// is the machine still at m_previous, having just been restored to it?
+
+	// working buffers
+	UINT8 *					m_previous;				// the most recently captured state
+	UINT8 *					m_current;				// scratch buffer for the state being captured
+	UINT8 *					m_compressed;			// scratch buffer for compression
+
+	// snapshot ring
+	UINT8 *					m_ring;					// ring memory
+	UINT32					m_ring_size;			// size of the ring memory
+	UINT32					m_write;				// offset where the next snapshot will be written
+	snapshot *				m_snapshots;			// circular index of snapshots, oldest first
+	int						m_capacity;				// maximum number of snapshots in the index
+	int						m_first;				// index of the oldest snapshot
+	int						m_count;				// number of live snapshots
+};
+
+
+#endif	/* __REWIND_H__ */
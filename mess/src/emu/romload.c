@@ -28,6 +28,9 @@
 
 #define TEMPBUFFER_MAX_SIZE		(1024 * 1024 * 1024)
 
+/* maximum amount of zipped ROM data to inflate ahead of loading */
+#define PREFETCH_MAX_SIZE		(64 * 1024 * 1024)
+
 
 
 /***************************************************************************
@@ -46,6 +49,25 @@ struct _open_chd
 };
 
 
+typedef struct _rom_prefetch rom_prefetch;
+struct _rom_prefetch
+{
+	rom_prefetch *		next;					/* pointer to next in the list */
+	const rom_entry *	romp;					/* ROM entry the file was found for */
+	emu_file *			file;					/* file opened without preloading */
+	file_error			filerr;					/* result of inflating it */
+};
+
+
+typedef struct _rom_load_file rom_load_file;
+struct _rom_load_file
+{
+	emu_file *			file;					/* file opened up front, or NULL */
+	UINT32				erroroffset;			/* where its messages belong in the error string */
+	astring				errorstring;			/* messages from verifying it */
+};
+
+
 typedef struct _romload_private rom_load_data;
 struct _romload_private
 {
@@ -64,6 +86,7 @@ struct _romload_private
 	UINT32			romstotalsize;		/* total size of ROMs to read */
 
 	emu_file *		file;				/* current file */
+	rom_prefetch *	prefetch_list;		/* files already inflated by the prefetch */
 	open_chd *		chd_list;			/* disks */
 	open_chd **		chd_list_tailptr;
 
@@ -73,6 +96,19 @@ struct _romload_private
 };
 
 
+typedef struct _rom_region_job rom_region_job;
+struct _rom_region_job
+{
+	rom_region_job *	next;					/* pointer to the previously queued job */
+	rom_load_data		data;					/* private load state for the worker */
+	const rom_entry *	entries;				/* first entry in the region */
+	rom_load_file *		files;					/* one per file entry, in order */
+	int					numfiles;				/* number of file entries */
+	astring				fatal;					/* fatal error raised while loading */
+	int					fatalcode;				/* exit code for that error */
+};
+
+
 /***************************************************************************
     FUNCTION PROTOTYPES
 ***************************************************************************/
@@ -101,9 +137,9 @@ file_error common_process_file(emu_options &options, const char *location, const
 	return filerr;
 }
 
-file_error common_process_file(emu_options &options, const char *location, bool has_crc, UINT32 crc, const rom_entry *romp, emu_file **image_file)
+file_error common_process_file(emu_options &options, const char *location, bool has_crc, UINT32 crc, const rom_entry *romp, emu_file **image_file, UINT32 openflags)
 {
-	*image_file = global_alloc(emu_file(options.media_path(), OPEN_FLAG_READ));
+	*image_file = global_alloc(emu_file(options.media_path(), openflags));
 	file_error filerr;
 
 	if (has_crc)
@@ -606,17 +642,14 @@ static void region_post_process(rom_load_data *romdata, const char *rgntag, bool
 
 
 /*-------------------------------------------------
-    open_rom_file - open a ROM file, searching
-    up the parent and loading by checksum
+    find_rom_file - search for a ROM file up the
+    parent chain and through the software list
+    locations, loading by checksum if possible
 -------------------------------------------------*/
 
-static int open_rom_file(rom_load_data *romdata, const char *regiontag, const rom_entry *romp)
+static file_error find_rom_file(rom_load_data *romdata, const char *regiontag, const rom_entry *romp, UINT32 openflags, emu_file **file)
 {
 	file_error filerr = FILERR_NOT_FOUND;
-	UINT32 romsize = rom_file_size(romp);
-
-	/* update status display */
-	display_loading_rom_message(romdata, ROM_GETNAME(romp));
 
 	/* extract CRC to use for searching */
 	UINT32 crc = 0;
@@ -624,12 +657,12 @@ static int open_rom_file(rom_load_data *romdata, const char *regiontag, const ro
 
 	/* attempt reading up the chain through the parents. It automatically also
      attempts any kind of load by checksum supported by the archives. */
-	romdata->file = NULL;
-	for (int drv = driver_list::find(romdata->machine().system()); romdata->file == NULL && drv != -1; drv = driver_list::clone(drv))
-		filerr = common_process_file(romdata->machine().options(), driver_list::driver(drv).name, has_crc, crc, romp, &romdata->file);
+	*file = NULL;
+	for (int drv = driver_list::find(romdata->machine().system()); *file == NULL && drv != -1; drv = driver_list::clone(drv))
+		filerr = common_process_file(romdata->machine().options(), driver_list::driver(drv).name, has_crc, crc, romp, file, openflags);
 
 	/* if the region is load by name, load the ROM from there */
-	if (romdata->file == NULL && regiontag != NULL)
+	if (*file == NULL && regiontag != NULL)
 	{
 		// check if we are dealing with softwarelists. if so, locationtag
 		// is actually a concatenation of: listname + setname + parentname
@@ -676,24 +709,58 @@ static int open_rom_file(rom_load_data *romdata, const char *regiontag, const ro
 		// - if we are not using lists, we have regiontag only;
 		// - if we are using lists, we have: list/clonename, list/parentname, clonename, parentname
 		if (!is_list)
-			filerr = common_process_file(romdata->machine().options(), tag1.cstr(), has_crc, crc, romp, &romdata->file);
+			filerr = common_process_file(romdata->machine().options(), tag1.cstr(), has_crc, crc, romp, file, openflags);
 		else
 		{
 			// try to load from list/setname
-			if ((romdata->file == NULL) && (tag2.cstr() != NULL))
-				filerr = common_process_file(romdata->machine().options(), tag2.cstr(), has_crc, crc, romp, &romdata->file);
+			if ((*file == NULL) && (tag2.cstr() != NULL))
+				filerr = common_process_file(romdata->machine().options(), tag2.cstr(), has_crc, crc, romp, file, openflags);
 			// try to load from list/parentname
-			if ((romdata->file == NULL) && has_parent && (tag3.cstr() != NULL))
-				filerr = common_process_file(romdata->machine().options(), tag3.cstr(), has_crc, crc, romp, &romdata->file);
+			if ((*file == NULL) && has_parent && (tag3.cstr() != NULL))
+				filerr = common_process_file(romdata->machine().options(), tag3.cstr(), has_crc, crc, romp, file, openflags);
 			// try to load from setname
-			if ((romdata->file == NULL) && (tag4.cstr() != NULL))
-				filerr = common_process_file(romdata->machine().options(), tag4.cstr(), has_crc, crc, romp, &romdata->file);
+			if ((*file == NULL) && (tag4.cstr() != NULL))
+				filerr = common_process_file(romdata->machine().options(), tag4.cstr(), has_crc, crc, romp, file, openflags);
 			// try to load from parentname
-			if ((romdata->file == NULL) && has_parent && (tag5.cstr() != NULL))
-				filerr = common_process_file(romdata->machine().options(), tag5.cstr(), has_crc, crc, romp, &romdata->file);
+			if ((*file == NULL) && has_parent && (tag5.cstr() != NULL))
+				filerr = common_process_file(romdata->machine().options(), tag5.cstr(), has_crc, crc, romp, file, openflags);
 		}
 	}
 
+	return filerr;
+}
+
+
+/*-------------------------------------------------
+    open_rom_file - open a ROM file, searching
+    up the parent and loading by checksum
+-------------------------------------------------*/
+
+static int open_rom_file(rom_load_data *romdata, const char *regiontag, const rom_entry *romp)
+{
+	file_error filerr = FILERR_NOT_FOUND;
+	UINT32 romsize = rom_file_size(romp);
+
+	/* update status display */
+	display_loading_rom_message(romdata, ROM_GETNAME(romp));
+
+	/* take the file if it was already found and inflated during the prefetch */
+	romdata->file = NULL;
+	for (rom_prefetch **prevptr = &romdata->prefetch_list; *prevptr != NULL; prevptr = &(*prevptr)->next)
+		if ((*prevptr)->romp == romp)
+		{
+			rom_prefetch *entry = *prevptr;
+			*prevptr = entry->next;
+			romdata->file = entry->file;
+			filerr = FILERR_NONE;
+			global_free(entry);
+			break;
+		}
+
+	/* otherwise, go looking for it */
+	if (romdata->file == NULL)
+		filerr = find_rom_file(romdata, regiontag, romp, OPEN_FLAG_READ, &romdata->file);
+
 	/* update counters */
 	romdata->romsloaded++;
 	romdata->romsloadedsize += romsize;
@@ -899,11 +966,54 @@ static void copy_rom_data(rom_load_data *romdata, const rom_entry *romp)
 
 
 /*-------------------------------------------------
-    process_rom_entries - process all ROM entries
-    for a region
+    open_rom_entries - open the files for all ROM
+    entries in a region, in order, noting where
+    each one's messages belong; returns TRUE if
+    the region cannot be loaded in the background
 -------------------------------------------------*/
 
-static void process_rom_entries(rom_load_data *romdata, const char *regiontag, const rom_entry *romp)
+static int open_rom_entries(rom_load_data *romdata, const char *regiontag, const rom_entry *romp, rom_load_file *files)
+{
+	int serial = FALSE;
+
+	for ( ; !ROMENTRY_ISREGIONEND(romp); romp++)
+	{
+		/* copies read other regions, which must be completely loaded first */
+		if (ROMENTRY_ISCOPY(romp))
+			serial = TRUE;
+
+		/* open the file if it is a non-BIOS or matches the current BIOS */
+		else if (ROMENTRY_ISFILE(romp))
+		{
+			int irrelevantbios = (ROM_GETBIOSFLAGS(romp) != 0 && ROM_GETBIOSFLAGS(romp) != romdata->system_bios);
+
+			LOG(("Opening ROM file: %s\n", ROM_GETNAME(romp)));
+			if (!irrelevantbios && !open_rom_file(romdata, regiontag, romp))
+			{
+				handle_missing_file(romdata, romp);
+
+				/* missing files are filled with random data, which must stay in sequence */
+				serial = TRUE;
+			}
+
+			files->file = romdata->file;
+			files->erroroffset = romdata->errorstring.len();
+			romdata->file = NULL;
+			files++;
+		}
+	}
+	return serial;
+}
+
+
+/*-------------------------------------------------
+    load_rom_entries - read and verify all ROM
+    entries for a region from the files opened
+    by open_rom_entries; safe to run on a worker
+    given a private rom_load_data
+-------------------------------------------------*/
+
+static void load_rom_entries(rom_load_data *romdata, const rom_entry *romp, rom_load_file *files)
 {
 	UINT32 lastflags = 0;
 
@@ -937,10 +1047,9 @@ static void process_rom_entries(rom_load_data *romdata, const char *regiontag, c
 			const rom_entry *baserom = romp;
 			int explength = 0;
 
-			/* open the file if it is a non-BIOS or matches the current BIOS */
-			LOG(("Opening ROM file: %s\n", ROM_GETNAME(romp)));
-			if (!irrelevantbios && !open_rom_file(romdata, regiontag, romp))
-				handle_missing_file(romdata, romp);
+			/* take over the file that was opened for this entry */
+			romdata->file = files->file;
+			files->file = NULL;
 
 			/* loop until we run out of reloads */
 			do
@@ -971,6 +1080,10 @@ static void process_rom_entries(rom_load_data *romdata, const char *regiontag, c
 					LOG(("Verifying length (%X) and checksums\n", explength));
 					verify_length_and_hash(romdata, ROM_GETNAME(baserom), explength, hash_collection(ROM_GETHASHDATA(baserom)));
 					LOG(("Verify finished\n"));
+
+					/* keep the messages with the file so they can be put back in order */
+					files->errorstring.cpy(romdata->errorstring);
+					romdata->errorstring.reset();
 				}
 
 				/* reseek to the start and clear the baserom so we don't reverify */
@@ -988,6 +1101,7 @@ static void process_rom_entries(rom_load_data *romdata, const char *regiontag, c
 				global_free(romdata->file);
 				romdata->file = NULL;
 			}
+			files++;
 		}
 		else
 		{
@@ -1199,6 +1313,134 @@ done:
 }
 
 
+/*-------------------------------------------------
+    prepare_region_job - open the files for a
+    region and set up the state needed to load it;
+    the region must already be allocated
+-------------------------------------------------*/
+
+static rom_region_job *prepare_region_job(rom_load_data *romdata, const char *regiontag, const rom_entry *romp, int *serial)
+{
+	rom_region_job *job = global_alloc_clear(rom_region_job);
+
+	/* count the files */
+	for (const rom_entry *scan = romp; !ROMENTRY_ISREGIONEND(scan); scan++)
+		if (ROMENTRY_ISFILE(scan))
+			job->numfiles++;
+
+	/* the worker gets its own copy of the state it touches */
+	job->data.m_machine = romdata->m_machine;
+	job->data.system_bios = romdata->system_bios;
+	job->data.region = romdata->region;
+	job->entries = romp;
+	if (job->numfiles > 0)
+		job->files = global_alloc_array_clear(rom_load_file, job->numfiles);
+
+	/* open everything now, so that messages and missing files are reported in order */
+	*serial = open_rom_entries(romdata, regiontag, romp, job->files);
+	return job;
+}
+
+
+/*-------------------------------------------------
+    run_region_job - read and verify the files
+    for a region
+-------------------------------------------------*/
+
+static void run_region_job(rom_region_job *job)
+{
+	/* a bad definition must not escape a worker thread; hold it for the merge */
+	try
+	{
+		load_rom_entries(&job->data, job->entries, job->files);
+	}
+	catch (emu_fatalerror &fatal)
+	{
+		job->fatal.cpy(fatal.string());
+		job->fatalcode = fatal.exitcode();
+	}
+}
+
+
+/*-------------------------------------------------
+    region_job_callback - work queue entry point
+    for run_region_job
+-------------------------------------------------*/
+
+static void *region_job_callback(void *param, int threadid)
+{
+	run_region_job((rom_region_job *)param);
+	return NULL;
+}
+
+
+/*-------------------------------------------------
+    finish_region_job - merge the results of a
+    region job back into the main state; jobs
+    must be finished from last to first
+-------------------------------------------------*/
+
+static void finish_region_job(rom_load_data *romdata, rom_region_job *job)
+{
+	/* put each file's messages back where they would have been, working backwards */
+	for (int filenum = job->numfiles - 1; filenum >= 0; filenum--)
+	{
+		rom_load_file *file = &job->files[filenum];
+		romdata->errorstring.ins(file->erroroffset, file->errorstring);
+		if (file->file != NULL)
+			global_free(file->file);
+	}
+	if (job->data.file != NULL)
+		global_free(job->data.file);
+	romdata->warnings += job->data.warnings;
+	romdata->knownbad += job->data.knownbad;
+
+	/* free everything, then rethrow any error from the worker */
+	astring fatal(job->fatal);
+	int fatalcode = job->fatalcode;
+	if (job->files != NULL)
+		global_free(job->files);
+	global_free(job);
+	if (fatal.len() != 0)
+		throw emu_fatalerror(fatalcode, "%s", fatal.cstr());
+}
+
+
+/*-------------------------------------------------
+    process_rom_entries - process all ROM entries
+    for a region
+-------------------------------------------------*/
+
+static void process_rom_entries(rom_load_data *romdata, const char *regiontag, const rom_entry *romp)
+{
+	int serial;
+	rom_region_job *job = prepare_region_job(romdata, regiontag, romp, &serial);
+	run_region_job(job);
+	finish_region_job(romdata, job);
+}
+
+
+/*-------------------------------------------------
+    finish_pending_jobs - wait for all queued
+    region jobs and merge their results
+-------------------------------------------------*/
+
+static void finish_pending_jobs(rom_load_data *romdata, osd_work_queue *queue, rom_region_job **pending)
+{
+	/* wait for the workers */
+	if (queue != NULL)
+		while (!osd_work_queue_wait(queue, osd_ticks_per_second() * 10)) ;
+
+	/* the list is newest first, which is the order the merge needs */
+	while (*pending != NULL)
+	{
+		rom_region_job *job = *pending;
+		*pending = job->next;
+		finish_region_job(romdata, job);
+	}
+}
+
+
 /*-------------------------------------------------
     process_disk_entries - process all disk entries
     for a region
@@ -1439,12 +1681,116 @@ void load_software_part_region(device_t *device, char *swlist, char *swname, rom
 }
 
 
+/*-------------------------------------------------
+    prefetch_callback - inflate a single zipped
+    ROM on a worker thread
+-------------------------------------------------*/
+
+static void *prefetch_callback(void *param, int threadid)
+{
+	rom_prefetch *entry = (rom_prefetch *)param;
+	entry->filerr = entry->file->inflate();
+	return NULL;
+}
+
+
+/*-------------------------------------------------
+    prefetch_rom_files - locate the zipped ROMs
+    up front and inflate them in parallel so the
+    serial load below just copies from memory
+-------------------------------------------------*/
+
+static void prefetch_rom_files(rom_load_data *romdata)
+{
+	rom_prefetch **tailptr = &romdata->prefetch_list;
+	UINT32 totalsize = 0;
+	const rom_source *source;
+	const rom_entry *region, *rom;
+
+	osd_work_queue *queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO | WORK_QUEUE_FLAG_MULTI);
+	if (queue == NULL)
+		return;
+
+	/* find every relevant ROM; opening is serial since it shares the ZIP directory cache */
+	for (source = rom_first_source(romdata->machine().config()); source != NULL; source = rom_next_source(*source))
+		for (region = rom_first_region(*source); region != NULL; region = rom_next_region(region))
+			if (ROMREGION_ISROMDATA(region))
+				for (rom = rom_first_file(region); rom != NULL; rom = rom_next_file(rom))
+					if (ROM_GETBIOSFLAGS(rom) == 0 || ROM_GETBIOSFLAGS(rom) == romdata->system_bios)
+					{
+						const char *regiontag = ROMREGION_ISLOADBYNAME(region) ? ROMREGION_GETTAG(region) : NULL;
+						emu_file *file;
+
+						/* only zipped files are worth handing off; the rest are found again later */
+						if (find_rom_file(romdata, regiontag, rom, OPEN_FLAG_READ | OPEN_FLAG_NO_PRELOAD, &file) != FILERR_NONE)
+							continue;
+						if (!file->needs_inflate() || totalsize + file->size() > PREFETCH_MAX_SIZE)
+						{
+							global_free(file);
+							continue;
+						}
+						totalsize += file->size();
+
+						/* add to the list and start inflating */
+						rom_prefetch *entry = global_alloc_clear(rom_prefetch);
+						entry->romp = rom;
+						entry->file = file;
+						*tailptr = entry;
+						tailptr = &entry->next;
+						osd_work_item_queue(queue, prefetch_callback, entry, WORK_ITEM_FLAG_AUTO_RELEASE);
+					}
+
+	/* wait for everything to land */
+	while (!osd_work_queue_wait(queue, osd_ticks_per_second() * 10)) ;
+	osd_work_queue_free(queue);
+
+	/* turn the inflated data into plain RAM files here, since that releases the ZIP handles and
+       the ZIP cache may only be touched from this thread; the region workers then see only RAM */
+	for (rom_prefetch *entry = romdata->prefetch_list; entry != NULL; entry = entry->next)
+		if (entry->filerr == FILERR_NONE && (core_file *)*entry->file == NULL)
+			entry->filerr = FILERR_FAILURE;
+
+	/* drop anything that failed; the normal path will find it again and report the error */
+	for (rom_prefetch **prevptr = &romdata->prefetch_list; *prevptr != NULL; )
+	{
+		rom_prefetch *entry = *prevptr;
+		if (entry->filerr == FILERR_NONE)
+			prevptr = &entry->next;
+		else
+		{
+			*prevptr = entry->next;
+			global_free(entry->file);
+			global_free(entry);
+		}
+	}
+}
+
+
+/*-------------------------------------------------
+    free_prefetch_list - release any prefetched
+    files that were never consumed
+-------------------------------------------------*/
+
+static void free_prefetch_list(rom_load_data *romdata)
+{
+	while (romdata->prefetch_list != NULL)
+	{
+		rom_prefetch *entry = romdata->prefetch_list;
+		romdata->prefetch_list = entry->next;
+		global_free(entry->file);
+		global_free(entry);
+	}
+}
+
+
 /*-------------------------------------------------
     process_region_list - process a region list
 -------------------------------------------------*/
 
 static void process_region_list(rom_load_data *romdata)
 {
+	osd_work_queue *queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	rom_region_job *pending = NULL;
 	astring regiontag;
 	const rom_source *source;
 	const rom_entry *region;
@@ -1487,13 +1833,37 @@ static void process_region_list(rom_load_data *romdata)
 					fill_random(romdata->machine(), romdata->region->base(), romdata->region->bytes());
 #endif
 
-				/* now process the entries in the region */
-				process_rom_entries(romdata, ROMREGION_ISLOADBYNAME(region) ? ROMREGION_GETTAG(region) : NULL, region + 1);
+				/* open the files for the region now, then read and verify them in the background */
+				int serial;
+				rom_region_job *job = prepare_region_job(romdata, ROMREGION_ISLOADBYNAME(region) ? ROMREGION_GETTAG(region) : NULL, region + 1, &serial);
+				if (queue != NULL && !serial)
+				{
+					job->next = pending;
+					pending = job;
+					osd_work_item_queue(queue, region_job_callback, job, WORK_ITEM_FLAG_AUTO_RELEASE);
+				}
+
+				/* regions that depend on the others, or on the random sequence, load in place */
+				else
+				{
+					/* merging the earlier jobs inserts text ahead of this region's files, so move their offsets along */
+					int oldlength = romdata->errorstring.len();
+					finish_pending_jobs(romdata, queue, &pending);
+					for (int filenum = 0; filenum < job->numfiles; filenum++)
+						job->files[filenum].erroroffset += romdata->errorstring.len() - oldlength;
+					run_region_job(job);
+					finish_region_job(romdata, job);
+				}
 			}
 			else if (ROMREGION_ISDISKDATA(region))
 				process_disk_entries(romdata, ROMREGION_GETTAG(region), region + 1, NULL);
 		}
 
+	/* wait for the background loads to complete */
+	finish_pending_jobs(romdata, queue, &pending);
+	if (queue != NULL)
+		osd_work_queue_free(queue);
+
 	/* now go back and post-process all the regions */
 	for (source = rom_first_source(romdata->machine().config()); source != NULL; source = rom_next_source(*source))
 		for (region = rom_first_region(*source); region != NULL; region = rom_next_region(region)) {
@@ -1531,8 +1901,10 @@ void rom_init(running_machine &machine)
 	romdata->chd_list = NULL;
 	romdata->chd_list_tailptr = &machine.romload_data->chd_list;
 
-	/* process the ROM entries we were passed */
+	/* inflate zipped ROMs in parallel, then process the ROM entries we were passed */
+	prefetch_rom_files(romdata);
 	process_region_list(romdata);
+	free_prefetch_list(romdata);
 
 	/* display the results and exit */
 	display_rom_load_results(romdata);
@@ -49,9 +49,24 @@
     Data is always written as native-endian.
     Data is converted from the endiannness it was written upon load.
 
+    Delta files share the header above with SS_DELTA set in the flags.
+    Their (compressed) data describes changes against the state written
+    or loaded just before them:
+
+    00..03  Sequence number within the chain (1 = first delta after base)
+    04..07  CRC32 of the base state's uncompressed data
+    08..end Page records:
+                00..03  Page number (0xffffffff terminates the list)
+                04..    Page data (DELTA_PAGE_SIZE bytes, or less for the
+                        final page of the state)
+
+    Sequence, CRC and page numbers are little-endian; page data is
+    native-endian. Deltas are only tracked when -state_deltas is nonzero.
+
 ***************************************************************************/
 
 #include "emu.h"
+#include "emuopts.h"
 
 #include <zlib.h>
 
@@ -72,11 +87,14 @@
 
 const int SAVE_VERSION		= 2;
 const int HEADER_SIZE		= 32;
+const int DELTA_PAGE_SIZE	= 4096;
+const UINT32 DELTA_END		= 0xffffffff;
 
 // Available flags
 enum
 {
-	SS_MSB_FIRST = 0x02
+	SS_MSB_FIRST = 0x02,
+	SS_DELTA = 0x04
 };
 
 
@@ -101,7 +119,18 @@ save_manager::save_manager(running_machine &machine)
 	  m_illegal_regs(0),
 	  m_entry_list(machine.respool()),
 	  m_presave_list(machine.respool()),
-	  m_postload_list(machine.respool())
+	  m_postload_list(machine.respool()),
+	  m_state_size(0),
+	  m_runs(NULL),
+	  m_run_count(0),
+	  m_delta_limit(machine.options().state_deltas()),
+	  m_shadow(NULL),
+	  m_dirty(NULL),
+	  m_delta_valid(false),
+	  m_delta_sequence(0),
+	  m_delta_base_crc(0),
+	  m_last_save_bytes(0),
+	  m_last_save_ticks(0)
 {
 }
 
@@ -116,7 +145,10 @@ void save_manager::allow_registration(bool allowed)
 	// allow/deny registration
 	m_reg_allowed = allowed;
 	if (!allowed)
+	{
 		dump_registry();
+		compute_layout();
+	}
 }
 
 
@@ -263,17 +295,12 @@ save_error save_manager::read_file(emu_file &file)
 	if (m_illegal_regs > 0)
 		return STATERR_ILLEGAL_REGISTRATIONS;
 
-	// read the header and turn on compression for the rest of the file
-	file.compress(FCOMPRESS_NONE);
-	file.seek(0, SEEK_SET);
+	// read and verify the header; deltas can only be loaded via read_delta_chain
 	UINT8 header[HEADER_SIZE];
-	if (file.read(header, sizeof(header)) != sizeof(header))
-		return STATERR_READ_ERROR;
-	file.compress(FCOMPRESS_MEDIUM);
-
-	// verify the header and report an error if it doesn't match
-	UINT32 sig = signature();
-	if (validate_header(header, machine().system().name, sig, popmessage, "Error: ")  != STATERR_NONE)
+	save_error err = read_header(file, header);
+	if (err != STATERR_NONE)
+		return err;
+	if (header[9] & SS_DELTA)
 		return STATERR_INVALID_HEADER;
 
 	// determine whether or not to flip the data when done
@@ -291,6 +318,17 @@ save_error save_manager::read_file(emu_file &file)
 			entry->flip_data();
 	}
 
+	// the loaded state becomes the base for any following deltas, unless it
+	// was flipped, in which case it no longer matches the file it came from
+	if (m_delta_limit > 0)
+	{
+		allocate_shadow();
+		gather_state(m_shadow);
+		m_delta_valid = !flip;
+		m_delta_sequence = 0;
+		m_delta_base_crc = crc32(0, m_shadow, m_state_size);
+	}
+
 	// call the post-load functions
 	for (state_callback *func = m_postload_list.first(); func != NULL; func = func->next())
 		func->m_func();
@@ -308,15 +346,11 @@ save_error save_manager::write_file(emu_file &file)
 	// if we have illegal registrations, return an error
 	if (m_illegal_regs > 0)
 		return STATERR_ILLEGAL_REGISTRATIONS;
+	osd_ticks_t start = osd_ticks();
 
 	// generate the header
 	UINT8 header[HEADER_SIZE];
-	memcpy(&header[0], s_magic_num, 8);
-	header[8] = SAVE_VERSION;
-	header[9] = NATIVE_ENDIAN_VALUE_LE_BE(0, SS_MSB_FIRST);
-	strncpy((char *)&header[0x0a], machine().system().name, 0x1c - 0x0a);
-	UINT32 sig = signature();
-	*(UINT32 *)&header[0x1c] = LITTLE_ENDIANIZE_INT32(sig);
+	generate_header(header, 0);
 
 	// write the header and turn on compression for the rest of the file
 	file.compress(FCOMPRESS_NONE);
@@ -329,13 +363,266 @@ save_error save_manager::write_file(emu_file &file)
 	for (state_callback *func = m_presave_list.first(); func != NULL; func = func->next())
 		func->m_func();
 
-	// then write all the data
-	for (state_entry *entry = m_entry_list.first(); entry != NULL; entry = entry->next())
+	// without deltas, just write all the data
+	if (m_delta_limit == 0)
 	{
-		UINT32 totalsize = entry->m_typesize * entry->m_typecount;
-		if (file.write(entry->m_data, totalsize) != totalsize)
+		for (state_entry *entry = m_entry_list.first(); entry != NULL; entry = entry->next())
+		{
+			UINT32 totalsize = entry->m_typesize * entry->m_typecount;
+			if (file.write(entry->m_data, totalsize) != totalsize)
+				return STATERR_WRITE_ERROR;
+		}
+	}
+
+	// otherwise, gather it into the shadow copy and write that in one go; the
+	// shadow then serves as the base for subsequent deltas
+	else
+	{
+		allocate_shadow();
+		gather_state(m_shadow);
+		m_delta_sequence = 0;
+		m_delta_base_crc = crc32(0, m_shadow, m_state_size);
+		m_delta_valid = (file.write(m_shadow, m_state_size) == m_state_size);
+		if (!m_delta_valid)
 			return STATERR_WRITE_ERROR;
 	}
+
+	// update statistics
+	m_last_save_bytes = m_state_size;
+	m_last_save_ticks = osd_ticks() - start;
+	logerror("Saved full state: %d bytes in %d ms\n", m_last_save_bytes, (int)(m_last_save_ticks * 1000 / osd_ticks_per_second()));
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  write_delta_file - writes only the pages that
+//  changed since the last save or load
+//-------------------------------------------------
+
+save_error save_manager::write_delta_file(emu_file &file)
+{
+	// if we have illegal registrations, return an error
+	if (m_illegal_regs > 0)
+		return STATERR_ILLEGAL_REGISTRATIONS;
+
+	// we need something to compare against
+	if (!m_delta_valid)
+		return STATERR_NO_BASE;
+	osd_ticks_t start = osd_ticks();
+
+	// generate the header
+	UINT8 header[HEADER_SIZE];
+	generate_header(header, SS_DELTA);
+
+	// write the header and turn on compression for the rest of the file
+	file.compress(FCOMPRESS_NONE);
+	file.seek(0, SEEK_SET);
+	if (file.write(header, sizeof(header)) != sizeof(header))
+		return STATERR_WRITE_ERROR;
+	file.compress(FCOMPRESS_MEDIUM);
+
+	// call the pre-save functions
+	for (state_callback *func = m_presave_list.first(); func != NULL; func = func->next())
+		func->m_func();
+
+	// compare each entry against the shadow a page-sized chunk at a time,
+	// updating the shadow and noting which pages changed
+	UINT32 pagecount = (m_state_size + DELTA_PAGE_SIZE - 1) / DELTA_PAGE_SIZE;
+	memset(m_dirty, 0, pagecount);
+	for (state_entry *entry = m_entry_list.first(); entry != NULL; entry = entry->next())
+	{
+		const UINT8 *source = reinterpret_cast<const UINT8 *>(entry->m_data);
+		UINT32 offset = entry->m_offset;
+		UINT32 remaining = entry->m_typesize * entry->m_typecount;
+		while (remaining > 0)
+		{
+			UINT32 chunk = MIN(remaining, DELTA_PAGE_SIZE - offset % DELTA_PAGE_SIZE);
+			if (memcmp(&m_shadow[offset], source, chunk) != 0)
+			{
+				memcpy(&m_shadow[offset], source, chunk);
+				m_dirty[offset / DELTA_PAGE_SIZE] = 1;
+			}
+			source += chunk;
+			offset += chunk;
+			remaining -= chunk;
+		}
+	}
+
+	// the shadow is now ahead of the chain; it only becomes a valid base
+	// again once the whole delta has made it to the file
+	m_delta_valid = false;
+
+	// write the sequence number and the base CRC, followed by each dirty page
+	UINT32 rawval = LITTLE_ENDIANIZE_INT32(m_delta_sequence + 1);
+	if (file.write(&rawval, sizeof(rawval)) != sizeof(rawval))
+		return STATERR_WRITE_ERROR;
+	rawval = LITTLE_ENDIANIZE_INT32(m_delta_base_crc);
+	if (file.write(&rawval, sizeof(rawval)) != sizeof(rawval))
+		return STATERR_WRITE_ERROR;
+	UINT32 bytes = 2 * sizeof(rawval);
+	for (UINT32 pagenum = 0; pagenum < pagecount; pagenum++)
+		if (m_dirty[pagenum])
+		{
+			UINT32 pagebase = pagenum * DELTA_PAGE_SIZE;
+			UINT32 pagesize = MIN(DELTA_PAGE_SIZE, m_state_size - pagebase);
+			rawval = LITTLE_ENDIANIZE_INT32(pagenum);
+			if (file.write(&rawval, sizeof(rawval)) != sizeof(rawval) || file.write(&m_shadow[pagebase], pagesize) != pagesize)
+				return STATERR_WRITE_ERROR;
+			bytes += sizeof(rawval) + pagesize;
+		}
+	rawval = LITTLE_ENDIANIZE_INT32(DELTA_END);
+	if (file.write(&rawval, sizeof(rawval)) != sizeof(rawval))
+		return STATERR_WRITE_ERROR;
+	bytes += sizeof(rawval);
+	m_delta_valid = true;
+	m_delta_sequence++;
+
+	// update statistics
+	m_last_save_bytes = bytes;
+	m_last_save_ticks = osd_ticks() - start;
+	logerror("Saved delta state %d: %d bytes in %d ms\n", m_delta_sequence, m_last_save_bytes, (int)(m_last_save_ticks * 1000 / osd_ticks_per_second()));
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  read_delta_chain - rebuild the full state from
+//  a base file plus a chain of delta files
+//-------------------------------------------------
+
+save_error save_manager::read_delta_chain(emu_file &base, emu_file *const *deltas, int deltacount)
+{
+	// if we have illegal registrations, return an error
+	if (m_illegal_regs > 0)
+		return STATERR_ILLEGAL_REGISTRATIONS;
+
+	// read and verify the base header
+	UINT8 header[HEADER_SIZE];
+	save_error err = read_header(base, header);
+	if (err != STATERR_NONE)
+		return err;
+	if (header[9] & SS_DELTA)
+		return STATERR_INVALID_HEADER;
+	UINT8 baseflags = header[9];
+
+	// read the base image into the shadow; nothing live is touched until
+	// the entire chain has been read successfully
+	allocate_shadow();
+	m_delta_valid = false;
+	if (base.read(m_shadow, m_state_size) != m_state_size)
+		return STATERR_READ_ERROR;
+	UINT32 basecrc = crc32(0, m_shadow, m_state_size);
+
+	// apply each delta in turn
+	UINT32 pagecount = (m_state_size + DELTA_PAGE_SIZE - 1) / DELTA_PAGE_SIZE;
+	for (int deltanum = 0; deltanum < deltacount; deltanum++)
+	{
+		emu_file &delta = *deltas[deltanum];
+		err = read_header(delta, header);
+		if (err != STATERR_NONE)
+			return err;
+		if (!(header[9] & SS_DELTA) || (header[9] & SS_MSB_FIRST) != (baseflags & SS_MSB_FIRST))
+			return STATERR_INVALID_HEADER;
+
+		// make sure the deltas are in the right order and were made against
+		// this base, rather than an earlier one saved under the same name
+		UINT32 rawval;
+		if (delta.read(&rawval, sizeof(rawval)) != sizeof(rawval))
+			return STATERR_READ_ERROR;
+		if (LITTLE_ENDIANIZE_INT32(rawval) != (UINT32)(deltanum + 1))
+			return STATERR_INVALID_HEADER;
+		if (delta.read(&rawval, sizeof(rawval)) != sizeof(rawval))
+			return STATERR_READ_ERROR;
+		if (LITTLE_ENDIANIZE_INT32(rawval) != basecrc)
+			return STATERR_INVALID_HEADER;
+
+		// copy in pages until we hit the end marker
+		while (true)
+		{
+			if (delta.read(&rawval, sizeof(rawval)) != sizeof(rawval))
+				return STATERR_READ_ERROR;
+			UINT32 pagenum = LITTLE_ENDIANIZE_INT32(rawval);
+			if (pagenum == DELTA_END)
+				break;
+			if (pagenum >= pagecount)
+				return STATERR_READ_ERROR;
+			UINT32 pagebase = pagenum * DELTA_PAGE_SIZE;
+			UINT32 pagesize = MIN(DELTA_PAGE_SIZE, m_state_size - pagebase);
+			if (delta.read(&m_shadow[pagebase], pagesize) != pagesize)
+				return STATERR_READ_ERROR;
+		}
+	}
+
+	// copy the rebuilt state out to the live entries
+	bool flip = NATIVE_ENDIAN_VALUE_LE_BE((baseflags & SS_MSB_FIRST) != 0, (baseflags & SS_MSB_FIRST) == 0);
+	scatter_state(m_shadow, flip);
+	if (flip)
+		gather_state(m_shadow);
+	m_delta_valid = !flip;
+	m_delta_sequence = deltacount;
+	m_delta_base_crc = basecrc;
+
+	// call the post-load functions
+	for (state_callback *func = m_postload_list.first(); func != NULL; func = func->next())
+		func->m_func();
+
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  write_buffer - save the state into a block of
+//  memory, with no header or compression
+//-------------------------------------------------
+
+save_error save_manager::write_buffer(void *buf, UINT32 size)
+{
+	// if we have illegal registrations, return an error
+	if (m_illegal_regs > 0)
+		return STATERR_ILLEGAL_REGISTRATIONS;
+
+	// verify the buffer is big enough
+	if (size < m_state_size)
+		return STATERR_WRITE_ERROR;
+	osd_ticks_t start = osd_ticks();
+
+	// call the pre-save functions
+	for (state_callback *func = m_presave_list.first(); func != NULL; func = func->next())
+		func->m_func();
+
+	// copy out the data
+	gather_state(reinterpret_cast<UINT8 *>(buf));
+
+	// update statistics
+	m_last_save_bytes = m_state_size;
+	m_last_save_ticks = osd_ticks() - start;
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  read_buffer - restore the state from a block
+//  of memory filled in by write_buffer
+//-------------------------------------------------
+
+save_error save_manager::read_buffer(const void *buf, UINT32 size)
+{
+	// if we have illegal registrations, return an error
+	if (m_illegal_regs > 0)
+		return STATERR_ILLEGAL_REGISTRATIONS;
+
+	// verify the buffer is big enough
+	if (size < m_state_size)
+		return STATERR_READ_ERROR;
+
+	// copy in the data
+	scatter_state(reinterpret_cast<const UINT8 *>(buf), false);
+
+	// call the post-load functions
+	for (state_callback *func = m_postload_list.first(); func != NULL; func = func->next())
+		func->m_func();
+
 	return STATERR_NONE;
 }
 
@@ -364,6 +651,139 @@ UINT32 save_manager::signature() const
 }
 
 
+//-------------------------------------------------
+//  compute_layout - assign each entry an offset
+//  within a flattened image of the whole state
+//-------------------------------------------------
+
+void save_manager::compute_layout()
+{
+	// entries are laid out end to end in registration order, matching the
+	// order they appear in a save file
+	m_state_size = 0;
+	for (state_entry *entry = m_entry_list.first(); entry != NULL; entry = entry->next())
+	{
+		entry->m_offset = m_state_size;
+		m_state_size += entry->m_typesize * entry->m_typecount;
+	}
+
+	// coalesce neighbouring entries that also sit next to each other in
+	// memory, so that copying the whole state takes as few memcpys as possible
+	if (m_runs != NULL)
+		auto_free(machine(), m_runs);
+	m_runs = auto_alloc_array(machine(), copy_run, m_entry_list.count() + 1);
+	m_run_count = 0;
+	for (state_entry *entry = m_entry_list.first(); entry != NULL; entry = entry->next())
+	{
+		UINT8 *data = reinterpret_cast<UINT8 *>(entry->m_data);
+		UINT32 size = entry->m_typesize * entry->m_typecount;
+		if (m_run_count > 0 && m_runs[m_run_count - 1].m_data + m_runs[m_run_count - 1].m_size == data)
+			m_runs[m_run_count - 1].m_size += size;
+		else
+		{
+			copy_run &run = m_runs[m_run_count++];
+			run.m_data = data;
+			run.m_offset = entry->m_offset;
+			run.m_size = size;
+		}
+	}
+	LOG(("Save state layout: %d bytes in %d entries, %d copy runs\n", m_state_size, m_entry_list.count(), m_run_count));
+
+	// any existing shadow no longer matches
+	if (m_shadow != NULL)
+	{
+		auto_free(machine(), m_shadow);
+		auto_free(machine(), m_dirty);
+		m_shadow = NULL;
+		m_dirty = NULL;
+	}
+	m_delta_valid = false;
+}
+
+
+//-------------------------------------------------
+//  allocate_shadow - allocate the shadow copy of
+//  the state used as the base for deltas
+//-------------------------------------------------
+
+void save_manager::allocate_shadow()
+{
+	if (m_shadow == NULL)
+	{
+		m_shadow = auto_alloc_array_clear(machine(), UINT8, m_state_size + 1);
+		m_dirty = auto_alloc_array_clear(machine(), UINT8, m_state_size / DELTA_PAGE_SIZE + 1);
+	}
+}
+
+
+//-------------------------------------------------
+//  gather_state - copy every entry into a
+//  flattened image
+//-------------------------------------------------
+
+void save_manager::gather_state(UINT8 *dest) const
+{
+	for (int runnum = 0; runnum < m_run_count; runnum++)
+		memcpy(&dest[m_runs[runnum].m_offset], m_runs[runnum].m_data, m_runs[runnum].m_size);
+}
+
+
+//-------------------------------------------------
+//  scatter_state - copy a flattened image back
+//  out to every entry
+//-------------------------------------------------
+
+void save_manager::scatter_state(const UINT8 *source, bool flip)
+{
+	for (int runnum = 0; runnum < m_run_count; runnum++)
+		memcpy(m_runs[runnum].m_data, &source[m_runs[runnum].m_offset], m_runs[runnum].m_size);
+
+	// flipping has to be done entry by entry
+	if (flip)
+		for (state_entry *entry = m_entry_list.first(); entry != NULL; entry = entry->next())
+			entry->flip_data();
+}
+
+
+//-------------------------------------------------
+//  generate_header - fill in a save file header
+//-------------------------------------------------
+
+void save_manager::generate_header(UINT8 *header, UINT8 flags) const
+{
+	memset(header, 0, HEADER_SIZE);
+	memcpy(&header[0], s_magic_num, 8);
+	header[8] = SAVE_VERSION;
+	header[9] = NATIVE_ENDIAN_VALUE_LE_BE(0, SS_MSB_FIRST) | flags;
+	strncpy((char *)&header[0x0a], machine().system().name, 0x1c - 0x0a);
+	UINT32 sig = signature();
+	*(UINT32 *)&header[0x1c] = LITTLE_ENDIANIZE_INT32(sig);
+}
+
+
+//-------------------------------------------------
+//  read_header - read and validate the header of
+//  a save file, leaving compression on for the
+//  data that follows
+//-------------------------------------------------
+
+save_error save_manager::read_header(emu_file &file, UINT8 *header)
+{
+	// read the header and turn on compression for the rest of the file
+	file.compress(FCOMPRESS_NONE);
+	file.seek(0, SEEK_SET);
+	if (file.read(header, HEADER_SIZE) != HEADER_SIZE)
+		return STATERR_READ_ERROR;
+	file.compress(FCOMPRESS_MEDIUM);
+
+	// verify the header and report an error if it doesn't match
+	UINT32 sig = signature();
+	if (validate_header(header, machine().system().name, sig, popmessage, "Error: ")  != STATERR_NONE)
+		return STATERR_INVALID_HEADER;
+	return STATERR_NONE;
+}
+
+
 //-------------------------------------------------
 //  dump_registry - dump the registry to the
 //  logfile
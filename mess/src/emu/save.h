@@ -58,7 +58,8 @@ enum save_error
 	STATERR_ILLEGAL_REGISTRATIONS,
 	STATERR_INVALID_HEADER,
 	STATERR_READ_ERROR,
-	STATERR_WRITE_ERROR
+	STATERR_WRITE_ERROR,
+	STATERR_NO_BASE
 };
 
 
@@ -132,6 +133,11 @@ public:
 	running_machine &machine() const { return m_machine; }
 	int registration_count() const { return m_entry_list.count(); }
 	bool registration_allowed() const { return m_reg_allowed; }
+	UINT32 state_size() const { return m_state_size; }
+	UINT32 last_save_bytes() const { return m_last_save_bytes; }
+	osd_ticks_t last_save_ticks() const { return m_last_save_ticks; }
+	bool delta_ready() const { return m_delta_valid && m_delta_sequence < m_delta_limit; }
+	UINT32 delta_sequence() const { return m_delta_sequence; }
 
 	// registration control
 	void allow_registration(bool allowed = true);
@@ -188,10 +194,24 @@ public:
 	save_error write_file(emu_file &file);
 	save_error read_file(emu_file &file);
 
+	// delta file processing
+	save_error write_delta_file(emu_file &file);
+	save_error read_delta_chain(emu_file &base, emu_file *const *deltas, int deltacount);
+
+	// uncompressed, native-endian in-memory processing; buffers must hold state_size() bytes
+	save_error write_buffer(void *buf, UINT32 size);
+	save_error read_buffer(const void *buf, UINT32 size);
+
 private:
 	// internal helpers
 	UINT32 signature() const;
 	void dump_registry() const;
+	void compute_layout();
+	void allocate_shadow();
+	void gather_state(UINT8 *dest) const;
+	void scatter_state(const UINT8 *source, bool flip);
+	void generate_header(UINT8 *header, UINT8 flags) const;
+	save_error read_header(emu_file &file, UINT8 *header);
 	static save_error validate_header(const UINT8 *header, const char *gamename, UINT32 signature, void (CLIB_DECL *errormsg)(const char *fmt, ...), const char *error_prefix);
 
 	// state callback item
@@ -230,6 +250,14 @@ private:
 		UINT32				m_offset;				// offset within the final structure
 	};
 
+	// a run of entries that are contiguous both in memory and in the image
+	struct copy_run
+	{
+		UINT8 *				m_data;					// pointer to the first entry's memory
+		UINT32				m_offset;				// offset within the flattened image
+		UINT32				m_size;					// total bytes covered by the run
+	};
+
 	// internal state
 	running_machine &		m_machine;				// reference to our machine
 	bool					m_reg_allowed;			// are registrations allowed?
@@ -239,6 +267,21 @@ private:
 	simple_list<state_callback> m_presave_list;		// list of pre-save functions
 	simple_list<state_callback> m_postload_list;	// list of post-load functions
 
+	// flattened layout and delta tracking
+	UINT32					m_state_size;			// total size of all entries, laid out end to end
+	copy_run *				m_runs;					// coalesced copy runs covering the image
+	int						m_run_count;			// number of copy runs
+	UINT32					m_delta_limit;			// maximum deltas per base; 0 disables deltas
+	UINT8 *					m_shadow;				// copy of the state as of the last save or load
+	UINT8 *					m_dirty;				// per-page dirty flags used while writing deltas
+	bool					m_delta_valid;			// is m_shadow a valid base for the next delta?
+	UINT32					m_delta_sequence;		// number of deltas written since the base
+	UINT32					m_delta_base_crc;		// CRC of the base image, stored in each delta
+
+	// statistics
+	UINT32					m_last_save_bytes;		// uncompressed bytes written by the last save
+	osd_ticks_t				m_last_save_ticks;		// time spent in the last save
+
 	static const char s_magic_num[8];				// magic number for header
 };
 
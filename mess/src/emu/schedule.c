@@ -77,7 +77,6 @@ enum
 emu_timer::emu_timer()
 	: m_machine(NULL),
 	  m_next(NULL),
-	  m_prev(NULL),
 	  m_param(0),
 	  m_ptr(NULL),
 	  m_enabled(false),
@@ -86,7 +85,10 @@ emu_timer::emu_timer()
 	  m_start(attotime::zero),
 	  m_expire(attotime::never),
 	  m_device(NULL),
-	  m_id(0)
+	  m_id(0),
+	  m_heapexpire(attotime::never),
+	  m_heapseq(0),
+	  m_heapindex(-1)
 {
 }
 
@@ -110,7 +112,6 @@ emu_timer &emu_timer::init(running_machine &machine, timer_expired_delegate call
 	// ensure the entire timer state is clean
 	m_machine = &machine;
 	m_next = NULL;
-	m_prev = NULL;
 	m_callback = callback;
 	m_param = 0;
 	m_ptr = ptr;
@@ -121,6 +122,7 @@ emu_timer &emu_timer::init(running_machine &machine, timer_expired_delegate call
 	m_expire = attotime::never;
 	m_device = NULL;
 	m_id = 0;
+	m_heapindex = -1;
 
 	// if we're not temporary, register ourselves with the save state system
 	if (!m_temporary)
@@ -142,7 +144,6 @@ emu_timer &emu_timer::init(device_t &device, device_timer_id id, void *ptr, bool
 	// ensure the entire timer state is clean
 	m_machine = &device.machine();
 	m_next = NULL;
-	m_prev = NULL;
 	m_callback = timer_expired_delegate();
 	m_param = 0;
 	m_ptr = ptr;
@@ -153,6 +154,7 @@ emu_timer &emu_timer::init(device_t &device, device_timer_id id, void *ptr, bool
 	m_expire = attotime::never;
 	m_device = &device;
 	m_id = id;
+	m_heapindex = -1;
 
 	// if we're not temporary, register ourselves with the save state system
 	if (!m_temporary)
@@ -268,21 +270,28 @@ void emu_timer::register_save()
 	astring name;
 
 	// for non-device timers, it is an index based on the callback function name
+	device_scheduler &scheduler = machine().scheduler();
 	if (m_device == NULL)
 	{
 		name = m_callback.name();
-		for (emu_timer *curtimer = machine().scheduler().first_timer(); curtimer != NULL; curtimer = curtimer->next())
+		for (int timernum = 0; timernum < scheduler.m_timer_count; timernum++)
+		{
+			emu_timer *curtimer = scheduler.m_timer_heap[timernum];
 			if (!curtimer->m_temporary && curtimer->m_device == NULL && strcmp(curtimer->m_callback.name(), m_callback.name()) == 0)
 				index++;
+		}
 	}
 
 	// for device timers, it is an index based on the device and timer ID
 	else
 	{
 		name.printf("%s/%d", m_device->tag(), m_id);
-		for (emu_timer *curtimer = machine().scheduler().first_timer(); curtimer != NULL; curtimer = curtimer->next())
+		for (int timernum = 0; timernum < scheduler.m_timer_count; timernum++)
+		{
+			emu_timer *curtimer = scheduler.m_timer_heap[timernum];
 			if (!curtimer->m_temporary && curtimer->m_device != NULL && curtimer->m_device == m_device && curtimer->m_id == m_id)
 				index++;
+		}
 	}
 
 	// save the bits
@@ -341,7 +350,10 @@ device_scheduler::device_scheduler(running_machine &machine) :
 	m_executing_device(NULL),
 	m_execute_list(NULL),
 	m_basetime(attotime::zero),
-	m_timer_list(NULL),
+	m_timer_heap(NULL),
+	m_timer_count(0),
+	m_timer_heap_size(0),
+	m_timer_sequence(0),
 	m_timer_allocator(machine.respool()),
 	m_callback_timer(NULL),
 	m_callback_timer_modified(false),
@@ -350,9 +362,8 @@ device_scheduler::device_scheduler(running_machine &machine) :
 	m_quantum_allocator(machine.respool()),
 	m_quantum_minimum(ATTOSECONDS_IN_NSEC(1) / 1000)
 {
-	// append a single never-expiring timer so there is always one in the list
-	m_timer_list = &m_timer_allocator.alloc()->init(machine, timer_expired_delegate(), NULL, true);
-	m_timer_list->adjust(attotime::never);
+	// append a single never-expiring timer so there is always one in the heap
+	m_timer_allocator.alloc()->init(machine, timer_expired_delegate(), NULL, true).adjust(attotime::never);
 
 	// register global states
 	machine.save().save_item(NAME(m_basetime));
@@ -368,8 +379,8 @@ device_scheduler::device_scheduler(running_machine &machine) :
 device_scheduler::~device_scheduler()
 {
 	// remove all timers
-	while (m_timer_list != NULL)
-		m_timer_allocator.reclaim(m_timer_list->release());
+	while (m_timer_count > 0)
+		m_timer_allocator.reclaim(m_timer_heap[m_timer_count - 1]->release());
 }
 
 
@@ -397,13 +408,16 @@ attotime device_scheduler::time() const
 bool device_scheduler::can_save() const
 {
 	// if any live temporary timers exit, fail
-	for (emu_timer *timer = m_timer_list; timer != NULL; timer = timer->next())
+	for (int timernum = 0; timernum < m_timer_count; timernum++)
+	{
+		emu_timer *timer = m_timer_heap[timernum];
 		if (timer->m_temporary && timer->expire() != attotime::never)
 		{
 			logerror("Failed save state attempt due to anonymous timers:\n");
 			dump_timers();
 			return false;
 		}
+	}
 
 	// otherwise, we're good
 	return true;
@@ -427,14 +441,14 @@ void device_scheduler::timeslice()
 	execute_timers();
 
 	// loop until we hit the next timer
-	while (m_basetime < m_timer_list->m_expire)
+	while (m_basetime < m_timer_heap[0]->m_expire)
 	{
 		// by default, assume our target is the end of the next quantum
 		attotime target = m_basetime + attotime(0, m_quantum_list.first()->m_actual);
 
 		// however, if the next timer is going to fire before then, override
-		if (m_timer_list->m_expire < target)
-			target = m_timer_list->m_expire;
+		if (m_timer_heap[0]->m_expire < target)
+			target = m_timer_heap[0]->m_expire;
 
 		LOG(("------------------\n"));
 		LOG(("cpu_timeslice: target = %s\n", target.as_string()));
@@ -670,11 +684,12 @@ void device_scheduler::presave()
 
 void device_scheduler::postload()
 {
-	// remove all timers and make a private list of permanent ones
+	// remove all timers in their pre-load order and make a private list of
+	// permanent ones; the heap is still ordered by the cached pre-load keys
 	simple_list<emu_timer> private_list;
-	while (m_timer_list != NULL)
+	while (m_timer_count > 0)
 	{
-		emu_timer &timer = *m_timer_list;
+		emu_timer &timer = *m_timer_heap[0];
 
 		// temporary timers go away entirely (except our special never-expiring one)
 		if (timer.m_temporary && timer.expire() != attotime::never)
@@ -809,69 +824,127 @@ void device_scheduler::rebuild_execute_list()
 }
 
 
+//-------------------------------------------------
+//  timer_heap_before - return true if timer1
+//  should fire before timer2
+//-------------------------------------------------
+
+inline bool device_scheduler::timer_heap_before(const emu_timer &timer1, const emu_timer &timer2) const
+{
+	if (timer1.m_heapexpire != timer2.m_heapexpire)
+		return timer1.m_heapexpire < timer2.m_heapexpire;
+	return timer1.m_heapseq < timer2.m_heapseq;
+}
+
+
 //-------------------------------------------------
 //  timer_list_insert - insert a new timer into
-//  the list at the appropriate location
+//  the heap at the appropriate location
 //-------------------------------------------------
 
 emu_timer &device_scheduler::timer_list_insert(emu_timer &timer)
 {
-	// disabled timers sort to the end
-	attotime expire = timer.m_enabled ? timer.m_expire : attotime::never;
+	assert(timer.m_heapindex == -1);
 
-	// loop over the timer list
-	emu_timer *prevtimer = NULL;
-	for (emu_timer *curtimer = m_timer_list; curtimer != NULL; prevtimer = curtimer, curtimer = curtimer->next())
+	// disabled timers sort to the end; equal expirations fire in insertion order
+	timer.m_heapexpire = timer.m_enabled ? timer.m_expire : attotime::never;
+	timer.m_heapseq = m_timer_sequence++;
+
+	// grow the heap array if we need to
+	if (m_timer_count == m_timer_heap_size)
 	{
-		// if the current list entry expires after us, we should be inserted before it
-		if (curtimer->m_expire > expire)
+		int newsize = (m_timer_heap_size == 0) ? 64 : m_timer_heap_size * 2;
+		emu_timer **newheap = auto_alloc_array(machine(), emu_timer *, newsize);
+		if (m_timer_heap != NULL)
 		{
-			// link the new guy in before the current list entry
-			timer.m_prev = curtimer->m_prev;
-			timer.m_next = curtimer;
-
-			if (curtimer->m_prev != NULL)
-				curtimer->m_prev->m_next = &timer;
-			else
-				m_timer_list = &timer;
-
-			curtimer->m_prev = &timer;
-			return timer;
+			memcpy(newheap, m_timer_heap, m_timer_count * sizeof(*newheap));
+			auto_free(machine(), m_timer_heap);
 		}
+		m_timer_heap = newheap;
+		m_timer_heap_size = newsize;
 	}
 
-	// need to insert after the last one
-	if (prevtimer != NULL)
-		prevtimer->m_next = &timer;
-	else
-		m_timer_list = &timer;
-
-	timer.m_prev = prevtimer;
-	timer.m_next = NULL;
+	// append at the bottom and bubble up into position
+	timer_heap_set(m_timer_count++, timer);
+	timer_heap_sift_up(timer.m_heapindex);
 	return timer;
 }
 
 
 //-------------------------------------------------
 //  timer_list_remove - remove a timer from the
-//  linked list
+//  heap
 //-------------------------------------------------
 
 emu_timer &device_scheduler::timer_list_remove(emu_timer &timer)
 {
-	// remove it from the list
-	if (timer.m_prev != NULL)
-		timer.m_prev->m_next = timer.m_next;
-	else
-		m_timer_list = timer.m_next;
+	int index = timer.m_heapindex;
+	assert(index >= 0 && index < m_timer_count && m_timer_heap[index] == &timer);
 
-	if (timer.m_next != NULL)
-		timer.m_next->m_prev = timer.m_prev;
+	// move the last entry into the hole and restore the heap in whichever
+	// direction it needs to go
+	emu_timer &last = *m_timer_heap[--m_timer_count];
+	if (&last != &timer)
+	{
+		timer_heap_set(index, last);
+		if (index > 0 && timer_heap_before(last, *m_timer_heap[(index - 1) / 2]))
+			timer_heap_sift_up(index);
+		else
+			timer_heap_sift_down(index);
+	}
 
+	timer.m_heapindex = -1;
 	return timer;
 }
 
 
+//-------------------------------------------------
+//  timer_heap_sift_up - move the entry at the
+//  given index towards the root until ordered
+//-------------------------------------------------
+
+void device_scheduler::timer_heap_sift_up(int index)
+{
+	emu_timer &timer = *m_timer_heap[index];
+	while (index > 0)
+	{
+		int parent = (index - 1) / 2;
+		if (!timer_heap_before(timer, *m_timer_heap[parent]))
+			break;
+		timer_heap_set(index, *m_timer_heap[parent]);
+		index = parent;
+	}
+	timer_heap_set(index, timer);
+}
+
+
+//-------------------------------------------------
+//  timer_heap_sift_down - move the entry at the
+//  given index towards the leaves until ordered
+//-------------------------------------------------
+
+void device_scheduler::timer_heap_sift_down(int index)
+{
+	emu_timer &timer = *m_timer_heap[index];
+	while (true)
+	{
+		// pick the earlier of the two children
+		int child = index * 2 + 1;
+		if (child >= m_timer_count)
+			break;
+		if (child + 1 < m_timer_count && timer_heap_before(*m_timer_heap[child + 1], *m_timer_heap[child]))
+			child++;
+
+		// stop once we fire before both of them
+		if (!timer_heap_before(*m_timer_heap[child], timer))
+			break;
+		timer_heap_set(index, *m_timer_heap[child]);
+		index = child;
+	}
+	timer_heap_set(index, timer);
+}
+
+
 //-------------------------------------------------
 //  execute_timers - execute timers and update
 //  scheduling quanta
@@ -883,13 +956,13 @@ void device_scheduler::execute_timers()
 	while (m_basetime >= m_quantum_list.first()->m_expire)
 		m_quantum_allocator.reclaim(m_quantum_list.detach_head());
 
-	LOG(("timer_set_global_time: new=%s head->expire=%s\n", m_basetime.as_string(), m_timer_list->m_expire.as_string()));
+	LOG(("timer_set_global_time: new=%s head->expire=%s\n", m_basetime.as_string(), m_timer_heap[0]->m_expire.as_string()));
 
 	// now process any timers that are overdue
-	while (m_timer_list->m_expire <= m_basetime)
+	while (m_timer_heap[0]->m_expire <= m_basetime)
 	{
 		// if this is a one-shot timer, disable it now
-		emu_timer &timer = *m_timer_list;
+		emu_timer &timer = *m_timer_heap[0];
 		bool was_enabled = timer.m_enabled;
 		if (timer.m_period == attotime::zero || timer.m_period == attotime::never)
 			timer.m_enabled = false;
@@ -974,6 +1047,43 @@ void device_scheduler::add_scheduling_quantum(attotime quantum, attotime duratio
 }
 
 
+//-------------------------------------------------
+//  benchmark_timers - time how quickly timers can
+//  be rescheduled while the given number of extra
+//  timers are live, returning adjusts per second;
+//  the timers never fire, so this is only useful
+//  once the machine has stopped running
+//-------------------------------------------------
+
+double device_scheduler::benchmark_timers(int count, int adjusts)
+{
+	// temporary timers, so nothing is registered for saving; spread them over the next second
+	emu_timer **timers = global_alloc_array(emu_timer *, count);
+	UINT32 seed = 12345;
+	for (int index = 0; index < count; index++)
+	{
+		seed = seed * 1103515245 + 12345;
+		timers[index] = &m_timer_allocator.alloc()->init(machine(), timer_expired_delegate(), NULL, true);
+		timers[index]->adjust(attotime::from_usec(1 + (seed >> 8) % 1000000));
+	}
+
+	// then keep moving random ones to random new times
+	osd_ticks_t start = osd_ticks();
+	for (int iter = 0; iter < adjusts; iter++)
+	{
+		seed = seed * 1103515245 + 12345;
+		timers[(seed >> 16) % count]->adjust(attotime::from_usec(1 + (seed >> 4) % 1000000));
+	}
+	osd_ticks_t ticks = osd_ticks() - start;
+
+	// give them all back
+	for (int index = 0; index < count; index++)
+		m_timer_allocator.reclaim(timers[index]->release());
+	global_free(timers);
+	return (ticks > 0) ? (double)adjusts * (double)osd_ticks_per_second() / (double)ticks : 0;
+}
+
+
 //-------------------------------------------------
 //  dump_timers - dump the current timer state
 //-------------------------------------------------
@@ -982,8 +1092,8 @@ void device_scheduler::dump_timers() const
 {
 	logerror("=============================================\n");
 	logerror("Timer Dump: Time = %15s\n", time().as_string());
-	for (emu_timer *timer = first_timer(); timer != NULL; timer = timer->next())
-		timer->dump();
+	for (int timernum = 0; timernum < m_timer_count; timernum++)
+		m_timer_heap[timernum]->dump();
 	logerror("=============================================\n");
 }
 
@@ -97,7 +97,6 @@ class emu_timer
 
 public:
 	// getters
-	emu_timer *next() const { return m_next; }
 	running_machine &machine() const { assert(m_machine != NULL); return *m_machine; }
 	bool enabled() const { return m_enabled; }
 	int param() const { return m_param; }
@@ -126,8 +125,7 @@ private:
 
 	// internal state
 	running_machine *	m_machine;		// reference to the owning machine
-	emu_timer *			m_next;			// next timer in order in the list
-	emu_timer *			m_prev;			// previous timer in order in the list
+	emu_timer *			m_next;			// next timer in the free list
 	timer_expired_delegate m_callback;	// callback function
 	INT32				m_param;		// integer parameter
 	void *				m_ptr;			// pointer parameter
@@ -138,6 +136,9 @@ private:
 	attotime			m_expire;		// time when the timer will expire
 	device_t *			m_device;		// for device timers, a pointer to the device
 	device_timer_id		m_id;			// for device timers, the ID of the timer
+	attotime			m_heapexpire;	// expiration time used to order the timer heap
+	UINT64				m_heapseq;		// insertion sequence; breaks ties between equal expirations
+	int					m_heapindex;	// index within the scheduler's timer heap, or -1
 };
 
 
@@ -156,7 +157,7 @@ public:
 	// getters
 	running_machine &machine() const { return m_machine; }
 	attotime time() const;
-	emu_timer *first_timer() const { return m_timer_list; }
+	emu_timer *first_timer() const { return (m_timer_count > 0) ? m_timer_heap[0] : NULL; }
 	device_execute_interface *currently_executing() const { return m_executing_device; }
 	bool can_save() const;
 
@@ -184,6 +185,7 @@ public:
 
 	// debugging
 	void dump_timers() const;
+	double benchmark_timers(int count, int adjusts);
 
 	// for emergencies only!
 	void eat_all_cycles();
@@ -202,6 +204,10 @@ private:
 	// timer helpers
 	emu_timer &timer_list_insert(emu_timer &timer);
 	emu_timer &timer_list_remove(emu_timer &timer);
+	bool timer_heap_before(const emu_timer &timer1, const emu_timer &timer2) const;
+	void timer_heap_sift_up(int index);
+	void timer_heap_sift_down(int index);
+	void timer_heap_set(int index, emu_timer &timer) { m_timer_heap[index] = &timer; timer.m_heapindex = index; }
 	void execute_timers();
 
 	// internal state
@@ -210,8 +216,11 @@ private:
 	device_execute_interface *	m_execute_list;				// list of devices to be executed
 	attotime					m_basetime;					// global basetime; everything moves forward from here
 
-	// list of active timers
-	emu_timer *					m_timer_list;				// head of the active list
+	// binary min-heap of active timers, ordered by expiration then insertion
+	emu_timer **				m_timer_heap;				// array of heap entries; [0] is the next to fire
+	int							m_timer_count;				// number of live entries in the heap
+	int							m_timer_heap_size;			// allocated size of the heap array
+	UINT64						m_timer_sequence;			// next insertion sequence number
 	fixed_allocator<emu_timer>	m_timer_allocator;			// allocator for timers
 
 	// other internal states
@@ -13,10 +13,77 @@
 #include "hash.h"
 #include "softlist.h"
 
+#include <zlib.h>
+
 #include <ctype.h>
 
 typedef tagmap_t<software_info *> softlist_map;
 
+
+/***************************************************************************
+    COMPILED INDEX
+
+    Parsing a large list through expat is slow, so after a clean parse we
+    write a flat binary image of it to the index directory. The image is
+    keyed on the size and modification time of the XML it came from, or on
+    a CRC of its contents where the OSD cannot report the time, and uses
+    offsets only, so it is loaded with a single read and could be mapped
+    directly. Every record is bounds-checked when the index is loaded; an
+    index that fails is ignored and the XML is parsed instead. Entries are
+    turned back into software_info structures only when software_list_find
+    returns them.
+
+    Layout: header, records (one per software, in XML order), shortname
+    hash table, per-software part data, string table. String offset 0
+    means NULL.
+***************************************************************************/
+
+#define SOFTLIST_INDEX_MAGIC		0x49575353	/* 'SSWI' */
+#define SOFTLIST_INDEX_VERSION		1
+
+typedef struct _softlist_index_header softlist_index_header;
+struct _softlist_index_header
+{
+	UINT32		magic;				/* SOFTLIST_INDEX_MAGIC; also catches byte order */
+	UINT32		version;			/* SOFTLIST_INDEX_VERSION */
+	UINT64		xml_size;			/* size of the source XML */
+	UINT64		xml_modified;		/* modification time of the source XML, or its CRC */
+	UINT32		total_size;			/* size of the whole index */
+	UINT32		software_count;		/* number of records */
+	UINT32		hash_size;			/* number of hash buckets (power of 2) */
+	UINT32		description;		/* list description (string offset) */
+	UINT32		records_offset;		/* offsets of each section from the start */
+	UINT32		hash_offset;
+	UINT32		blob_offset;
+	UINT32		blob_size;
+	UINT32		strings_offset;
+	UINT32		strings_size;
+};
+
+typedef struct _softlist_index_record softlist_index_record;
+struct _softlist_index_record
+{
+	UINT32		shortname;			/* string offsets */
+	UINT32		longname;
+	UINT32		parentname;
+	UINT32		year;
+	UINT32		publisher;
+	UINT32		supported;			/* SOFTWARE_SUPPORTED_* */
+	UINT32		hash;				/* hash of the shortname */
+	UINT32		blob;				/* offset of the part data within the blob section */
+};
+
+/* used twice: once with base == NULL to size the sections, then to fill them */
+typedef struct _softlist_index_writer softlist_index_writer;
+struct _softlist_index_writer
+{
+	UINT8 *		base;				/* output image, or NULL when measuring */
+	UINT32		blob_offset;		/* section offsets within the image */
+	UINT32		strings_offset;
+	UINT32		blob;				/* bytes used so far in each section */
+	UINT32		strings;
+};
+
 /***************************************************************************
     EXPAT INTERFACES
 ***************************************************************************/
@@ -54,6 +121,7 @@ INLINE void ATTR_PRINTF(2,3) parse_error(parse_state *state, const char *fmt, ..
 	char buf[256];
 	va_list va;
 
+	state->error_count++;
 	if (state->error_proc)
 	{
 		va_start(va, fmt);
@@ -870,6 +938,563 @@ static void data_handler(void *data, const XML_Char *s, int len)
 }
 
 
+/*-------------------------------------------------
+    softlist_index_hash - case-insensitive hash
+    of a software shortname
+-------------------------------------------------*/
+
+static UINT32 softlist_index_hash(const char *string)
+{
+	UINT32 hash = 0;
+
+	while (*string != 0)
+		hash = hash * 31 + tolower((UINT8)*string++);
+	return hash;
+}
+
+
+/*-------------------------------------------------
+    softlist_index_add_string/add_u32 - append
+    to the string or blob sections
+-------------------------------------------------*/
+
+static UINT32 softlist_index_add_string(softlist_index_writer *writer, const char *string)
+{
+	UINT32 offset = writer->strings;
+	UINT32 length;
+
+	if (string == NULL)
+		return 0;
+
+	length = strlen(string) + 1;
+	if (writer->base != NULL)
+		memcpy(writer->base + writer->strings_offset + offset, string, length);
+	writer->strings += length;
+	return offset;
+}
+
+static void softlist_index_add_u32(softlist_index_writer *writer, UINT32 value)
+{
+	if (writer->base != NULL)
+		*(UINT32 *)(writer->base + writer->blob_offset + writer->blob) = value;
+	writer->blob += sizeof(UINT32);
+}
+
+
+/*-------------------------------------------------
+    softlist_index_add_features - append a
+    feature list as a count and name/value pairs
+-------------------------------------------------*/
+
+static void softlist_index_add_features(softlist_index_writer *writer, const feature_list *list)
+{
+	const feature_list *feature;
+	UINT32 count = 0;
+
+	for (feature = list; feature != NULL; feature = feature->next)
+		count++;
+
+	softlist_index_add_u32(writer, count);
+	for (feature = list; feature != NULL; feature = feature->next)
+	{
+		softlist_index_add_u32(writer, softlist_index_add_string(writer, feature->name));
+		softlist_index_add_u32(writer, softlist_index_add_string(writer, feature->value));
+	}
+}
+
+
+/*-------------------------------------------------
+    softlist_index_add_software - append the
+    shared features and parts of one software,
+    returning its blob offset
+-------------------------------------------------*/
+
+static UINT32 softlist_index_add_software(softlist_index_writer *writer, const software_info *info)
+{
+	UINT32 start = writer->blob;
+	const software_part *part;
+	UINT32 count = 0;
+
+	/* shared features hang off a dummy head */
+	softlist_index_add_features(writer, (info->shared_info != NULL) ? info->shared_info->next : NULL);
+
+	/* parts are terminated by an entry with no name */
+	for (part = info->partdata; part != NULL && part->name != NULL; part++)
+		count++;
+	softlist_index_add_u32(writer, count);
+
+	for (part = info->partdata; part != NULL && part->name != NULL; part++)
+	{
+		const rom_entry *rom;
+
+		softlist_index_add_u32(writer, softlist_index_add_string(writer, part->name));
+		softlist_index_add_u32(writer, softlist_index_add_string(writer, part->interface_));
+		softlist_index_add_features(writer, part->featurelist);
+
+		/* ROM entries run up to and including ROM_END */
+		count = 0;
+		if (part->romdata != NULL)
+			for (rom = part->romdata; ; rom++)
+			{
+				count++;
+				if (ROMENTRY_ISEND(rom))
+					break;
+			}
+		softlist_index_add_u32(writer, count);
+
+		for (rom = part->romdata; count-- != 0; rom++)
+		{
+			softlist_index_add_u32(writer, softlist_index_add_string(writer, rom->_name));
+
+			/* fill entries carry their value in the hash pointer */
+			if (ROMENTRY_ISFILL(rom))
+				softlist_index_add_u32(writer, (UINT32)(FPTR)rom->_hashdata);
+			else
+				softlist_index_add_u32(writer, softlist_index_add_string(writer, rom->_hashdata));
+			softlist_index_add_u32(writer, rom->_offset);
+			softlist_index_add_u32(writer, rom->_length);
+			softlist_index_add_u32(writer, rom->_flags);
+		}
+	}
+	return start;
+}
+
+
+/*-------------------------------------------------
+    softlist_index_xml_stamp - get the size and
+    modification time of the list's XML
+-------------------------------------------------*/
+
+static int softlist_index_xml_stamp(software_list *swlist, UINT64 *size, UINT64 *modified)
+{
+	osd_directory_entry *entry = osd_stat(swlist->file->fullpath());
+
+	if (entry == NULL)
+		return FALSE;
+
+	*size = entry->size;
+	*modified = entry->last_modified;
+	osd_free(entry);
+
+	/* without a timestamp (e.g. osdmini), key on a CRC of the contents; the top bit keeps it apart from real times */
+	if (*modified == 0)
+	{
+		UINT8 buf[4096];
+		UINT32 crc = 0, len;
+
+		swlist->file->seek(0, SEEK_SET);
+		while ((len = swlist->file->read(buf, sizeof(buf))) != 0)
+			crc = crc32(crc, buf, len);
+		swlist->file->seek(0, SEEK_SET);
+		*modified = U64(0x8000000000000000) | crc;
+	}
+	return TRUE;
+}
+
+
+/*-------------------------------------------------
+    softlist_index_add_list - append every
+    software in the list, filling in the records
+    and hash table when they are given; returns
+    the description's string offset
+-------------------------------------------------*/
+
+static UINT32 softlist_index_add_list(softlist_index_writer *writer, software_list *swlist, softlist_index_record *records, UINT32 *hash, UINT32 hash_size)
+{
+	UINT32 description = softlist_index_add_string(writer, swlist->description);
+	software_info *info;
+	UINT32 index = 0;
+
+	for (info = swlist->software_info_list; info != NULL; info = info->next, index++)
+	{
+		softlist_index_record record;
+
+		record.shortname = softlist_index_add_string(writer, info->shortname);
+		record.longname = softlist_index_add_string(writer, info->longname);
+		record.parentname = softlist_index_add_string(writer, info->parentname);
+		record.year = softlist_index_add_string(writer, info->year);
+		record.publisher = softlist_index_add_string(writer, info->publisher);
+		record.supported = info->supported;
+		record.hash = softlist_index_hash(info->shortname);
+		record.blob = softlist_index_add_software(writer, info);
+
+		if (records != NULL)
+		{
+			UINT32 bucket = record.hash & (hash_size - 1);
+
+			/* linear probing; a duplicate name lands after the first, matching XML order */
+			records[index] = record;
+			while (hash[bucket] != 0)
+				bucket = (bucket + 1) & (hash_size - 1);
+			hash[bucket] = index + 1;
+		}
+	}
+	return description;
+}
+
+
+/*-------------------------------------------------
+    softlist_index_save - write the index for a
+    freshly parsed list
+-------------------------------------------------*/
+
+static void softlist_index_save(software_list *swlist)
+{
+	softlist_index_header *header;
+	softlist_index_writer writer;
+	software_info *info;
+	UINT64 xml_size, xml_modified;
+	UINT32 count = 0, hash_size = 16;
+
+	if (swlist->options == NULL || !softlist_index_xml_stamp(swlist, &xml_size, &xml_modified))
+		return;
+
+	for (info = swlist->software_info_list; info != NULL; info = info->next)
+		count++;
+	while (hash_size < count * 2)
+		hash_size *= 2;
+
+	/* measure the variable-sized sections; string offset 0 is reserved for NULL */
+	memset(&writer, 0, sizeof(writer));
+	writer.strings = 1;
+	softlist_index_add_list(&writer, swlist, NULL, NULL, 0);
+
+	/* lay out the image */
+	UINT32 records_offset = sizeof(*header);
+	UINT32 hash_offset = records_offset + count * sizeof(softlist_index_record);
+	UINT32 blob_offset = hash_offset + hash_size * sizeof(UINT32);
+	UINT32 strings_offset = blob_offset + writer.blob;
+	UINT32 total_size = strings_offset + writer.strings;
+	UINT8 *base = global_alloc_array_clear(UINT8, total_size);
+
+	header = (softlist_index_header *)base;
+	header->magic = SOFTLIST_INDEX_MAGIC;
+	header->version = SOFTLIST_INDEX_VERSION;
+	header->xml_size = xml_size;
+	header->xml_modified = xml_modified;
+	header->total_size = total_size;
+	header->software_count = count;
+	header->hash_size = hash_size;
+	header->records_offset = records_offset;
+	header->hash_offset = hash_offset;
+	header->blob_offset = blob_offset;
+	header->blob_size = writer.blob;
+	header->strings_offset = strings_offset;
+	header->strings_size = writer.strings;
+
+	/* now fill it */
+	writer.base = base;
+	writer.blob_offset = blob_offset;
+	writer.strings_offset = strings_offset;
+	writer.blob = 0;
+	writer.strings = 1;
+	header->description = softlist_index_add_list(&writer, swlist, (softlist_index_record *)(base + records_offset), (UINT32 *)(base + hash_offset), hash_size);
+
+	/* a truncated write is caught by the size check on load */
+	emu_file file(swlist->options->index_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	if (file.open(swlist->listname, ".swi") == FILERR_NONE)
+		file.write(base, total_size);
+	global_free(base);
+}
+
+
+/*-------------------------------------------------
+    softlist_index_check_features - check a
+    feature list in the blob, advancing past it
+-------------------------------------------------*/
+
+static int softlist_index_check_features(const softlist_index_header *header, const UINT32 **blob, const UINT32 *end)
+{
+	UINT32 count;
+
+	if (*blob >= end)
+		return FALSE;
+	count = *(*blob)++;
+	if (count > (UINT32)(end - *blob) / 2)
+		return FALSE;
+	while (count-- != 0)
+	{
+		if ((*blob)[0] >= header->strings_size || (*blob)[1] >= header->strings_size)
+			return FALSE;
+		*blob += 2;
+	}
+	return TRUE;
+}
+
+
+/*-------------------------------------------------
+    softlist_index_check_software - check that a
+    record's strings lie in the string table and
+    its part data in the blob, so that nothing
+    read later can run off the end of the index
+-------------------------------------------------*/
+
+static int softlist_index_check_software(const softlist_index_header *header, const UINT8 *base, const softlist_index_record *record)
+{
+	const UINT32 *blob, *end;
+	UINT32 partcount;
+
+	if (record->shortname == 0 || record->shortname >= header->strings_size ||
+		record->longname >= header->strings_size || record->parentname >= header->strings_size ||
+		record->year >= header->strings_size || record->publisher >= header->strings_size ||
+		record->blob >= header->blob_size || (record->blob & 3) != 0)
+		return FALSE;
+
+	blob = (const UINT32 *)(base + header->blob_offset + record->blob);
+	end = (const UINT32 *)(base + header->blob_offset + (header->blob_size & ~3));
+	if (!softlist_index_check_features(header, &blob, end))
+		return FALSE;
+
+	/* each part is at least a name, an interface and two counts */
+	if (blob >= end)
+		return FALSE;
+	partcount = *blob++;
+	if (partcount > (UINT32)(end - blob) / 4)
+		return FALSE;
+	while (partcount-- != 0)
+	{
+		UINT32 romcount;
+
+		if (end - blob < 2 || blob[0] >= header->strings_size || blob[1] >= header->strings_size)
+			return FALSE;
+		blob += 2;
+		if (!softlist_index_check_features(header, &blob, end))
+			return FALSE;
+
+		/* each ROM is a name, hash data (or fill value), offset, length and flags */
+		if (blob >= end)
+			return FALSE;
+		romcount = *blob++;
+		if (romcount > (UINT32)(end - blob) / 5)
+			return FALSE;
+		while (romcount-- != 0)
+		{
+			if (blob[0] >= header->strings_size)
+				return FALSE;
+			if ((blob[4] & ROMENTRY_TYPEMASK) != ROMENTRYTYPE_FILL && blob[1] >= header->strings_size)
+				return FALSE;
+			blob += 5;
+		}
+	}
+	return TRUE;
+}
+
+
+/*-------------------------------------------------
+    softlist_index_load - load a compiled index
+    if it is current for the list's XML
+-------------------------------------------------*/
+
+static int softlist_index_load(software_list *swlist)
+{
+	const softlist_index_header *header;
+	const softlist_index_record *records;
+	const UINT32 *hash;
+	UINT64 xml_size, xml_modified, size;
+	UINT32 number;
+	UINT8 *base;
+
+	if (!softlist_index_xml_stamp(swlist, &xml_size, &xml_modified))
+		return FALSE;
+
+	emu_file file(swlist->options->index_directory(), OPEN_FLAG_READ);
+	if (file.open(swlist->listname, ".swi") != FILERR_NONE)
+		return FALSE;
+	size = file.size();
+	if (size < sizeof(*header) || size > 0x7fffffff)
+		return FALSE;
+
+	base = (UINT8 *)pool_malloc_lib(swlist->pool, size);
+	if (base == NULL)
+		return FALSE;
+	header = (const softlist_index_header *)base;
+
+	/* check the key and that every section lies inside what we read */
+	if (file.read(base, size) != size ||
+		header->magic != SOFTLIST_INDEX_MAGIC || header->version != SOFTLIST_INDEX_VERSION ||
+		header->xml_size != xml_size || header->xml_modified != xml_modified || header->total_size != size ||
+		header->records_offset < sizeof(*header) ||
+		((header->records_offset | header->hash_offset | header->blob_offset) & 3) != 0 ||
+		header->records_offset + (UINT64)header->software_count * sizeof(softlist_index_record) > header->hash_offset ||
+		header->hash_offset + (UINT64)header->hash_size * sizeof(UINT32) > header->blob_offset ||
+		header->blob_offset + (UINT64)header->blob_size > header->strings_offset ||
+		header->strings_offset + (UINT64)header->strings_size != size ||
+		header->hash_size == 0 || (header->hash_size & (header->hash_size - 1)) != 0 ||
+		header->strings_size == 0 || base[size - 1] != 0 ||
+		header->description >= header->strings_size)
+		goto invalid;
+
+	/* then every hash entry and record, so lookups never have to */
+	hash = (const UINT32 *)(base + header->hash_offset);
+	for (number = 0; number < header->hash_size; number++)
+		if (hash[number] > header->software_count)
+			goto invalid;
+	records = (const softlist_index_record *)(base + header->records_offset);
+	for (number = 0; number < header->software_count; number++)
+		if (!softlist_index_check_software(header, base, &records[number]))
+			goto invalid;
+
+	swlist->index_infos = (software_info *)pool_malloc_lib(swlist->pool, (header->software_count + 1) * sizeof(software_info));
+	if (swlist->index_infos == NULL)
+		goto invalid;
+	memset(swlist->index_infos, 0, (header->software_count + 1) * sizeof(software_info));
+
+	swlist->index = base;
+	swlist->description = (header->description != 0) ? (const char *)base + header->strings_offset + header->description : NULL;
+	swlist->list_entries = header->software_count;
+	return TRUE;
+
+invalid:
+	/* a bad index is simply ignored; the caller falls back to the XML */
+	pool_object_remove(swlist->pool, base, TRUE);
+	return FALSE;
+}
+
+
+/*-------------------------------------------------
+    softlist_index_string - resolve a string
+    offset
+-------------------------------------------------*/
+
+INLINE const char *softlist_index_string(software_list *swlist, UINT32 offset)
+{
+	const softlist_index_header *header = (const softlist_index_header *)swlist->index;
+
+	if (offset == 0 || offset >= header->strings_size)
+		return NULL;
+	return (const char *)swlist->index + header->strings_offset + offset;
+}
+
+
+/*-------------------------------------------------
+    softlist_index_get_features - rebuild a
+    feature list from the blob
+-------------------------------------------------*/
+
+static const UINT32 *softlist_index_get_features(software_list *swlist, const UINT32 *blob, feature_list **head)
+{
+	UINT32 count = *blob++;
+
+	*head = NULL;
+	while (count-- != 0)
+	{
+		feature_list *feature = (feature_list *)pool_malloc_lib(swlist->pool, sizeof(feature_list));
+
+		feature->next = NULL;
+		feature->name = (char *)softlist_index_string(swlist, *blob++);
+		feature->value = (char *)softlist_index_string(swlist, *blob++);
+		*head = feature;
+		head = &feature->next;
+	}
+	return blob;
+}
+
+
+/*-------------------------------------------------
+    softlist_index_get_software - turn an index
+    record into a software_info, the first time
+    it is asked for
+-------------------------------------------------*/
+
+static software_info *softlist_index_get_software(software_list *swlist, UINT32 number)
+{
+	const softlist_index_header *header = (const softlist_index_header *)swlist->index;
+	const softlist_index_record *record = (const softlist_index_record *)(swlist->index + header->records_offset) + number;
+	software_info *info = &swlist->index_infos[number];
+	const UINT32 *blob;
+	UINT32 partcount, partnum;
+
+	if (info->shortname != NULL)
+		return info;
+
+	info->shortname = softlist_index_string(swlist, record->shortname);
+	info->longname = softlist_index_string(swlist, record->longname);
+	info->parentname = softlist_index_string(swlist, record->parentname);
+	info->year = softlist_index_string(swlist, record->year);
+	info->publisher = softlist_index_string(swlist, record->publisher);
+	info->supported = record->supported;
+	info->next = NULL;
+
+	/* shared features hang off a dummy head, as the XML parser leaves them */
+	blob = (const UINT32 *)(swlist->index + header->blob_offset + record->blob);
+	info->shared_info = (feature_list *)pool_malloc_lib(swlist->pool, sizeof(feature_list));
+	info->shared_info->name = NULL;
+	info->shared_info->value = NULL;
+	blob = softlist_index_get_features(swlist, blob, &info->shared_info->next);
+
+	/* parts, plus the terminating entry with no name */
+	partcount = *blob++;
+	info->partdata = (software_part *)pool_malloc_lib(swlist->pool, (partcount + 1) * sizeof(software_part));
+	memset(info->partdata, 0, (partcount + 1) * sizeof(software_part));
+	for (partnum = 0; partnum < partcount; partnum++)
+	{
+		software_part *part = &info->partdata[partnum];
+		UINT32 romcount, romnum;
+
+		part->name = softlist_index_string(swlist, *blob++);
+		part->interface_ = softlist_index_string(swlist, *blob++);
+		blob = softlist_index_get_features(swlist, blob, &part->featurelist);
+
+		romcount = *blob++;
+		if (romcount != 0)
+			part->romdata = (struct rom_entry *)pool_malloc_lib(swlist->pool, romcount * sizeof(struct rom_entry));
+		for (romnum = 0; romnum < romcount; romnum++)
+		{
+			struct rom_entry *rom = &part->romdata[romnum];
+			UINT32 name = *blob++;
+			UINT32 hashdata = *blob++;
+
+			rom->_name = softlist_index_string(swlist, name);
+			rom->_offset = *blob++;
+			rom->_length = *blob++;
+			rom->_flags = *blob++;
+			rom->_hashdata = ROMENTRY_ISFILL(rom) ? (const char *)(FPTR)hashdata : softlist_index_string(swlist, hashdata);
+		}
+	}
+	return info;
+}
+
+
+/*-------------------------------------------------
+    softlist_index_find - software_list_find for
+    a list backed by an index
+-------------------------------------------------*/
+
+static software_info *softlist_index_find(software_list *swlist, const char *look_for, software_info *prev)
+{
+	const softlist_index_header *header = (const softlist_index_header *)swlist->index;
+	const softlist_index_record *records = (const softlist_index_record *)(swlist->index + header->records_offset);
+	UINT32 number = (prev != NULL) ? (prev - swlist->index_infos) + 1 : 0;
+
+	/* a plain name goes through the hash table; anything else falls back to the scan */
+	if (prev == NULL && look_for[0] != 0 && strlen(look_for) < 16 && strpbrk(look_for, "*?") == NULL)
+	{
+		const UINT32 *hash = (const UINT32 *)(swlist->index + header->hash_offset);
+		UINT32 hashval = softlist_index_hash(look_for);
+		UINT32 bucket;
+
+		for (bucket = hashval & (header->hash_size - 1); hash[bucket] != 0; bucket = (bucket + 1) & (header->hash_size - 1))
+		{
+			UINT32 candidate = hash[bucket] - 1;
+
+			if (candidate < header->software_count && records[candidate].hash == hashval &&
+				core_stricmp(look_for, softlist_index_string(swlist, records[candidate].shortname)) == 0)
+				return softlist_index_get_software(swlist, candidate);
+		}
+	}
+
+	/* compare against the names in the string table; only matches are built */
+	for ( ; number < header->software_count; number++)
+	{
+		const char *shortname = softlist_index_string(swlist, records[number].shortname);
+
+		if (shortname != NULL && !mame_strwildcmp(look_for, shortname))
+			return softlist_index_get_software(swlist, number);
+	}
+	return NULL;
+}
+
+
 /*-------------------------------------------------
  software_list_get_count
  -------------------------------------------------*/
@@ -878,6 +1503,9 @@ static int software_list_get_count(software_list *swlist)
 {
 	int count = 0;
 
+	if (swlist->index != NULL)
+		return ((const softlist_index_header *)swlist->index)->software_count;
+
 	for (software_info *swinfo = software_list_find(swlist, "*", NULL); swinfo != NULL; swinfo = software_list_find(swlist, "*", swinfo))
 		count++;
 
@@ -938,6 +1566,10 @@ void software_list_parse(software_list *swlist,
 	UINT32 len;
 	XML_Memory_Handling_Suite memcallbacks;
 
+	/* an index already holds everything the parse would produce */
+	if (swlist->index != NULL)
+		return;
+
 	swlist->file->seek(0, SEEK_SET);
 
 	memset(&swlist->state, 0, sizeof(swlist->state));
@@ -976,6 +1608,10 @@ done:
 	swlist->state.parser = NULL;
 	swlist->current_software_info = swlist->software_info_list;
 	swlist->list_entries = software_list_get_count(swlist);
+
+	/* only a clean parse is worth keeping, so validation still sees any errors */
+	if (swlist->state.error_count == 0 && swlist->software_info_list != NULL)
+		softlist_index_save(swlist);
 }
 
 
@@ -1004,6 +1640,8 @@ software_list *software_list_open(emu_options &options, const char *listname, in
 	memset(swlist, 0, sizeof(*swlist));
 	swlist->pool = pool;
 	swlist->error_proc = error_proc;
+	swlist->options = &options;
+	swlist->listname = pool_strdup_lib(pool, listname);
 
 	/* open a file */
 	swlist->file = global_alloc(emu_file(options.hash_path(), OPEN_FLAG_READ));
@@ -1011,6 +1649,9 @@ software_list *software_list_open(emu_options &options, const char *listname, in
 	if (filerr != FILERR_NONE)
 		goto error;
 
+	/* with a current index there is nothing to parse */
+	softlist_index_load(swlist);
+
 	if (is_preload)
 	{
 		software_list_parse(swlist, swlist->error_proc, NULL);
@@ -1185,6 +1826,9 @@ software_info *software_list_find(software_list *swlist, const char *look_for, s
 	if (look_for == NULL)
 		return NULL;
 
+	if (swlist->index != NULL)
+		return softlist_index_find(swlist, look_for, prev);
+
 	/* If we haven't read in the xml file yet, then do it now */
 	if ( ! swlist->software_info_list )
 		software_list_parse( swlist, swlist->error_proc, NULL );
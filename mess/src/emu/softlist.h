@@ -75,6 +75,7 @@ struct _parse_state
 
 	enum softlist_parse_position pos;
 	char **text_dest;
+	int error_count;
 };
 
 
@@ -95,6 +96,10 @@ struct _software_list
 	int current_rom_entry;
 	void (*error_proc)(const char *message);
 	int list_entries;
+	emu_options *options;					// used to locate the compiled index
+	const char *listname;
+	UINT8 *index;							// compiled index, or NULL if we parse the XML
+	software_info *index_infos;				// one entry per indexed software, filled in on demand
 };
 
 /* Handling a software list */
@@ -97,7 +97,9 @@ sound_stream::sound_stream(device_t &device, int inputs, int outputs, int sample
 	  m_output_update_sampindex(0),
 	  m_output_base_sampindex(0),
 	  m_callback(callback),
-	  m_param(param)
+	  m_param(param),
+	  m_parallel_update(false),
+	  m_update_level(-1)
 {
 	// get the device's sound interface
 	device_sound_interface *sound;
@@ -244,6 +246,7 @@ void sound_stream::set_input(int index, sound_stream *input_stream, int output_i
 	// update the dependent info
 	if (input.m_source != NULL)
 		input.m_source->m_dependents++;
+	m_device.machine().sound().m_graph_dirty = true;
 
 	// update sample rates now that we know the input
 	recompute_sample_rate_data();
@@ -256,6 +259,20 @@ void sound_stream::set_input(int index, sound_stream *input_stream, int output_i
 //-------------------------------------------------
 
 void sound_stream::update()
+{
+	g_profiler.start(PROFILER_SOUND);
+	update_samples();
+	g_profiler.stop();
+}
+
+
+//-------------------------------------------------
+//  update_samples - generate samples up to the
+//  current emulated time; this is the part of
+//  update that is safe to run on a worker
+//-------------------------------------------------
+
+void sound_stream::update_samples()
 {
 	// determine the number of samples since the start of this second
 	attotime time = m_device.machine().time();
@@ -276,12 +293,15 @@ void sound_stream::update()
 		update_sampindex -= m_sample_rate;
 	}
 
+	// if we're already there, leave everything alone; several dependents
+	// may check on us at once from different threads
+	if (update_sampindex == m_output_sampindex)
+		return;
+
 	// generate samples to get us up to the appropriate time
-	g_profiler.start(PROFILER_SOUND);
 	assert(m_output_sampindex - m_output_base_sampindex >= 0);
 	assert(update_sampindex - m_output_base_sampindex <= m_output_bufalloc);
 	generate_samples(update_sampindex - m_output_sampindex);
-	g_profiler.stop();
 
 	// remember this info for next time
 	m_output_sampindex = update_sampindex;
@@ -393,11 +413,11 @@ void sound_stream::update_with_accounting(bool second_tick)
 //  pending sample rate change, apply it now
 //-------------------------------------------------
 
-void sound_stream::apply_sample_rate_changes()
+bool sound_stream::apply_sample_rate_changes()
 {
 	// skip if nothing to do
 	if (m_new_sample_rate == 0)
-		return;
+		return false;
 
 	// update to the new rate and remember the old rate
 	UINT32 old_rate = m_sample_rate;
@@ -415,6 +435,40 @@ void sound_stream::apply_sample_rate_changes()
 	// clear out the buffer
 	for (int outputnum = 0; outputnum < m_outputs; outputnum++)
 		memset(m_output[outputnum].m_buffer, 0, m_max_samples_per_update * sizeof(m_output[outputnum].m_buffer[0]));
+	return true;
+}
+
+
+//-------------------------------------------------
+//  compute_update_level - determine how deep in
+//  the stream graph we are: 0 for streams with
+//  no inputs, otherwise one more than the
+//  deepest of our inputs
+//-------------------------------------------------
+
+int sound_stream::compute_update_level()
+{
+	if (m_update_level < 0)
+	{
+		m_update_level = 0;
+		for (int inputnum = 0; inputnum < m_inputs; inputnum++)
+			if (m_input[inputnum].m_source != NULL)
+				m_update_level = MAX(m_update_level, m_input[inputnum].m_source->m_stream->compute_update_level() + 1);
+	}
+	return m_update_level;
+}
+
+
+//-------------------------------------------------
+//  update_callback - work queue callback to
+//  bring a single stream up to date
+//-------------------------------------------------
+
+void *sound_stream::update_callback(void *param, int threadid)
+{
+	sound_stream *stream = *reinterpret_cast<sound_stream **>(param);
+	stream->update_samples();
+	return NULL;
 }
 
 
@@ -474,6 +528,118 @@ void sound_stream::recompute_sample_rate_data()
 			assert(input.m_latency_attoseconds < update_attoseconds);
 		}
 	}
+
+	// bring the band-limited filters in line with the new rates
+	update_resample_filters();
+}
+
+
+//-------------------------------------------------
+//  filter_half_taps - return half the number of
+//  taps needed to resample between two rates at
+//  the given quality, or 0 if no filter is
+//  needed
+//-------------------------------------------------
+
+int sound_stream::filter_half_taps(int quality, UINT32 in_rate, UINT32 out_rate)
+{
+	if (quality <= 0 || in_rate == out_rate)
+		return 0;
+
+	// 4, 8 or 16 taps either side of the sample, stretched when decimating
+	int half = 4 << (MIN(quality, 3) - 1);
+	if (in_rate > out_rate)
+		half = ((UINT64)half * in_rate + out_rate - 1) / out_rate;
+
+	// keep the tap count a multiple of 4 for the inner loop
+	return MIN((half + 1) & ~1, FILTER_MAX_HALF_TAPS);
+}
+
+
+//-------------------------------------------------
+//  update_resample_filters - make sure each
+//  input's band-limited filter matches the
+//  current sample rates, and that the input
+//  latency leaves enough lookahead for it
+//-------------------------------------------------
+
+void sound_stream::update_resample_filters()
+{
+	attoseconds_t update_attoseconds = m_device.machine().sound().update_attoseconds();
+	int quality = m_device.machine().sound().resample_quality();
+
+	for (int inputnum = 0; inputnum < m_inputs; inputnum++)
+	{
+		stream_input &input = m_input[inputnum];
+		int half = 0;
+		if (input.m_source != NULL)
+		{
+			sound_stream &source = *input.m_source->m_stream;
+			half = filter_half_taps(quality, source.m_sample_rate, m_sample_rate);
+
+			// the filter reads half its taps past each sample and as many before it; if that
+			// doesn't fit in the history we keep, fall back to simple interpolation
+			attoseconds_t latency = (half + 2) * source.m_attoseconds_per_sample + m_attoseconds_per_sample;
+			if (half != 0 && MAX(latency, input.m_latency_attoseconds) + half * source.m_attoseconds_per_sample >= update_attoseconds)
+				half = 0;
+			if (half != 0)
+			{
+				input.m_latency_attoseconds = MAX(input.m_latency_attoseconds, latency);
+				if (input.m_filter_taps != 2 * half || input.m_filter_in_rate != source.m_sample_rate || input.m_filter_out_rate != m_sample_rate)
+					build_resample_filter(input, half);
+			}
+		}
+		if (half == 0)
+			input.m_filter_taps = 0;
+	}
+}
+
+
+//-------------------------------------------------
+//  build_resample_filter - compute the polyphase
+//  coefficients of a Blackman-windowed sinc
+//  filter for an input
+//-------------------------------------------------
+
+void sound_stream::build_resample_filter(stream_input &input, int half)
+{
+	UINT32 in_rate = input.m_source->m_stream->m_sample_rate;
+	int taps = 2 * half;
+
+	// make sure we have room
+	if (input.m_filter_alloc < FILTER_PHASES * taps)
+	{
+		auto_free(m_device.machine(), input.m_filter);
+		input.m_filter_alloc = FILTER_PHASES * taps;
+		input.m_filter = auto_alloc_array(m_device.machine(), float, input.m_filter_alloc);
+	}
+
+	// cut off a little below the lower of the two Nyquist frequencies
+	double cutoff = 0.92 * MIN(1.0, (double)m_sample_rate / (double)in_rate);
+	for (int phase = 0; phase < FILTER_PHASES; phase++)
+	{
+		float *coeffs = &input.m_filter[phase * taps];
+		double frac = (double)phase / (double)FILTER_PHASES;
+		double sum = 0;
+		for (int tap = 0; tap < taps; tap++)
+		{
+			// distance of this tap from the sample position, in source samples
+			double t = (double)(tap - (half - 1)) - frac;
+			double x = t / (double)half;
+			double window = 0.42 + 0.5 * cos(M_PI * x) + 0.08 * cos(2.0 * M_PI * x);
+			double sinc = (t == 0) ? 1.0 : sin(M_PI * cutoff * t) / (M_PI * cutoff * t);
+			coeffs[tap] = cutoff * sinc * window;
+			sum += coeffs[tap];
+		}
+
+		// normalize each phase to unity gain at DC
+		for (int tap = 0; tap < taps; tap++)
+			coeffs[tap] /= sum;
+	}
+
+	input.m_filter_taps = taps;
+	input.m_filter_in_rate = in_rate;
+	input.m_filter_out_rate = m_sample_rate;
 }
 
 
@@ -577,7 +743,7 @@ void sound_stream::generate_samples(int samples)
 		// update the stream to the current time
 		stream_input &input = m_input[inputnum];
 		if (input.m_source != NULL)
-			input.m_source->m_stream->update();
+			input.m_source->m_stream->update_samples();
 
 		// generate the resampled data
 		m_input_array[inputnum] = generate_resampled_data(input, samples);
@@ -640,6 +806,13 @@ stream_sample_t *sound_stream::generate_resampled_data(stream_input &input, UINT
 	// compute the stepping fraction
 	UINT32 step = ((UINT64)input_stream.m_sample_rate << FRAC_BITS) / m_sample_rate;
 
+	// if we have a band-limited filter for these rates, use it
+	if (input.m_filter_taps != 0 && step != FRAC_ONE && input.m_filter_in_rate == input_stream.m_sample_rate && input.m_filter_out_rate == m_sample_rate)
+	{
+		generate_filtered_data(input, dest, source, basefrac, step, gain, numsamples);
+		return input.m_resample;
+	}
+
 	// if we have equal sample rates, we just need to copy
 	if (step == FRAC_ONE)
 	{
@@ -717,6 +890,43 @@ stream_sample_t *sound_stream::generate_resampled_data(stream_input &input, UINT
 }
 
 
+//-------------------------------------------------
+//  generate_filtered_data - resample an input
+//  through its polyphase filter
+//-------------------------------------------------
+
+void sound_stream::generate_filtered_data(stream_input &input, stream_sample_t *dest, const stream_sample_t *source, UINT32 basefrac, UINT32 step, int gain, UINT32 numsamples)
+{
+	const int taps = input.m_filter_taps;
+	const float *filter = input.m_filter;
+
+	// the first tap sits half a filter before the sample
+	source -= taps / 2 - 1;
+	while (numsamples--)
+	{
+		const float *coeffs = &filter[(basefrac >> (FRAC_BITS - FILTER_PHASE_BITS)) * taps];
+
+		// four independent sums keep the loop friendly to vectorizers
+		float sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
+		for (int tap = 0; tap < taps; tap += 4)
+		{
+			sum0 += float(source[tap + 0]) * coeffs[tap + 0];
+			sum1 += float(source[tap + 1]) * coeffs[tap + 1];
+			sum2 += float(source[tap + 2]) * coeffs[tap + 2];
+			sum3 += float(source[tap + 3]) * coeffs[tap + 3];
+		}
+		float sum = (sum0 + sum1) + (sum2 + sum3);
+		stream_sample_t sample = (sum >= 0) ? stream_sample_t(sum + 0.5f) : -stream_sample_t(0.5f - sum);
+		*dest++ = (sample * gain) >> 8;
+
+		// advance
+		basefrac += step;
+		source += basefrac >> FRAC_BITS;
+		basefrac &= FRAC_MASK;
+	}
+}
+
+
 
 //**************************************************************************
 //  STREAM INPUT
@@ -733,7 +943,12 @@ sound_stream::stream_input::stream_input()
 	  m_bufalloc(0),
 	  m_latency_attoseconds(0),
 	  m_gain(0x100),
-	  m_initial_gain(0x100)
+	  m_initial_gain(0x100),
+	  m_filter(NULL),
+	  m_filter_taps(0),
+	  m_filter_alloc(0),
+	  m_filter_in_rate(0),
+	  m_filter_out_rate(0)
 {
 }
 
@@ -774,8 +989,15 @@ sound_manager::sound_manager(running_machine &machine)
 	  m_muted(0),
 	  m_attenuation(0),
 	  m_nosound_mode(!machine.options().sound()),
+	  m_resample_quality(MIN(MAX(machine.options().resample_quality(), 0), 3)),
+	  m_sound_threads(machine.options().sound_threads()),
 	  m_wavfile(NULL),
 	  m_stream_list(machine.respool()),
+	  m_graph_dirty(true),
+	  m_graph_levels(0),
+	  m_queue(NULL),
+	  m_work_list(NULL),
+	  m_work_alloc(0),
 	  m_update_attoseconds(STREAMS_UPDATE_ATTOTIME.attoseconds),
 	  m_last_update(attotime::zero)
 {
@@ -784,7 +1006,9 @@ sound_manager::sound_manager(running_machine &machine)
 	const char *avifile = machine.options().avi_write();
 
 	// handle -nosound and lower sample rate if not recording WAV or AVI
-	if (m_nosound_mode && wavfile[0] == 0 && avifile[0] == 0)
+	// or hashing the output, which must see the same audio either way
+	bool hashing = (machine.options().hash_write()[0] != 0 || machine.options().hash_verify()[0] != 0);
+	if (m_nosound_mode && wavfile[0] == 0 && avifile[0] == 0 && !hashing)
 		machine.m_sample_rate = 11025;
 
 	// count the speakers
@@ -826,6 +1050,10 @@ sound_manager::~sound_manager()
 	if (m_wavfile != NULL)
 		wav_close(m_wavfile);
 	m_wavfile = NULL;
+
+	// release the work queue
+	if (m_queue != NULL)
+		osd_work_queue_free(m_queue);
 }
 
 
@@ -835,6 +1063,7 @@ sound_manager::~sound_manager()
 
 sound_stream *sound_manager::stream_alloc(device_t &device, int inputs, int outputs, int sample_rate, void *param, sound_stream::stream_update_func callback)
 {
+	m_graph_dirty = true;
 	if (callback != NULL)
 		return &m_stream_list.append(*auto_alloc(device.machine(), sound_stream(device, inputs, outputs, sample_rate, param, callback)));
 	else
@@ -1001,6 +1230,9 @@ void sound_manager::update()
 
 	g_profiler.start(PROFILER_SOUND);
 
+	// bring independent streams up to date on the work queue
+	update_streams_parallel();
+
 	// force all the speaker streams to generate the proper number of samples
 	int samples_this_update = 0;
 	for (speaker_device *speaker = downcast<speaker_device *>(machine().devicelist().first(SPEAKER)); speaker != NULL; speaker = speaker->next_speaker())
@@ -1060,8 +1292,93 @@ void sound_manager::update()
 	m_last_update = curtime;
 
 	// update sample rates if they have changed
+	bool rates_changed = false;
 	for (sound_stream *stream = m_stream_list.first(); stream != NULL; stream = stream->next())
-		stream->apply_sample_rate_changes();
+		if (stream->apply_sample_rate_changes())
+			rates_changed = true;
+
+	// a new rate affects the filters of every stream fed by it
+	if (rates_changed && m_resample_quality != 0)
+		for (sound_stream *stream = m_stream_list.first(); stream != NULL; stream = stream->next())
+			stream->update_resample_filters();
 
 	g_profiler.stop();
 }
+
+
+//-------------------------------------------------
+//  update_stream_graph - recompute the update
+//  level of every stream, and allocate the work
+//  queue if there is anything worth threading
+//-------------------------------------------------
+
+void sound_manager::update_stream_graph()
+{
+	m_graph_dirty = false;
+
+	// reset and recompute the levels
+	for (sound_stream *stream = m_stream_list.first(); stream != NULL; stream = stream->next())
+		stream->m_update_level = -1;
+	m_graph_levels = 0;
+	int parallel = 0;
+	for (sound_stream *stream = m_stream_list.first(); stream != NULL; stream = stream->next())
+	{
+		m_graph_levels = MAX(m_graph_levels, stream->compute_update_level() + 1);
+		if (stream->m_parallel_update)
+			parallel++;
+	}
+
+	// make sure the scratch list can hold every stream
+	if (m_work_alloc < m_stream_list.count())
+	{
+		auto_free(machine(), m_work_list);
+		m_work_alloc = m_stream_list.count();
+		m_work_list = auto_alloc_array(machine(), sound_stream *, m_work_alloc);
+	}
+
+	// only bother with a queue if at least two streams can run side by side,
+	// and not at all if the serial update was asked for
+	if (m_sound_threads && parallel >= 2 && m_queue == NULL)
+		m_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
+}
+
+
+//-------------------------------------------------
+//  update_streams_parallel - bring streams up to
+//  date one graph level at a time, running the
+//  thread-safe streams of each level on the work
+//  queue; since every stream still sees its
+//  inputs fully generated, the output matches a
+//  serial update exactly
+//-------------------------------------------------
+
+void sound_manager::update_streams_parallel()
+{
+	if (m_graph_dirty)
+		update_stream_graph();
+	if (m_queue == NULL)
+		return;
+
+	for (int level = 0; level < m_graph_levels; level++)
+	{
+		// update the streams that must stay on this thread, and gather the rest
+		int count = 0;
+		for (sound_stream *stream = m_stream_list.first(); stream != NULL; stream = stream->next())
+			if (stream->m_update_level == level)
+			{
+				if (stream->m_parallel_update)
+					m_work_list[count++] = stream;
+				else
+					stream->update_samples();
+			}
+
+		// a lone stream isn't worth the round trip
+		if (count == 1)
+			m_work_list[0]->update_samples();
+		else if (count > 1)
+		{
+			osd_work_item_queue_multiple(m_queue, sound_stream::update_callback, count, m_work_list, sizeof(m_work_list[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+			osd_work_queue_wait(m_queue, osd_ticks_per_second() * 10);
+		}
+	}
+}
@@ -111,6 +111,13 @@ class sound_stream
 		attoseconds_t		m_latency_attoseconds;	// latency between this stream and the input stream
 		INT16				m_gain;					// gain to apply to this input
 		INT16				m_initial_gain;			// initial gain supplied at creation
+
+		// band-limited resampling filter
+		float *				m_filter;				// polyphase coefficients, FILTER_PHASES rows of m_filter_taps
+		int					m_filter_taps;			// number of taps per phase; 0 if unfiltered
+		UINT32				m_filter_alloc;			// allocated size of the filter, in coefficients
+		UINT32				m_filter_in_rate;		// source sample rate the filter was built for
+		UINT32				m_filter_out_rate;		// our sample rate the filter was built for
 	};
 
 	// constants
@@ -118,6 +125,9 @@ class sound_stream
 	static const UINT32 FRAC_BITS				= 22;
 	static const UINT32 FRAC_ONE				= 1 << FRAC_BITS;
 	static const UINT32 FRAC_MASK				= FRAC_ONE - 1;
+	static const int FILTER_PHASE_BITS			= 8;
+	static const int FILTER_PHASES				= 1 << FILTER_PHASE_BITS;
+	static const int FILTER_MAX_HALF_TAPS		= 128;
 
 	// construction/destruction
 	sound_stream(device_t &device, int inputs, int outputs, int sample_rate, void *param = NULL, stream_update_func callback = &sound_stream::device_stream_update_stub);
@@ -135,6 +145,7 @@ public:
 	float initial_input_gain(int inputnum) const;
 	const char *input_name(int inputnum, astring &string) const;
 	float output_gain(int outputnum) const;
+	bool parallel_update() const { return m_parallel_update; }
 
 	// operations
 	void set_input(int inputnum, sound_stream *input_stream, int outputnum = 0, float gain = 1.0f);
@@ -146,19 +157,29 @@ public:
 	void set_input_gain(int inputnum, float gain);
 	void set_output_gain(int outputnum, float gain);
 
+	// threading; only set this if the callback touches nothing but the stream's own state
+	void set_parallel_update(bool parallel = true) { m_parallel_update = parallel; }
+
 private:
 	// helpers called by our friends only
 	void update_with_accounting(bool second_tick);
-	void apply_sample_rate_changes();
+	bool apply_sample_rate_changes();
+	int compute_update_level();
+	static void *update_callback(void *param, int threadid);
 
 	// internal helpers
 	static STREAM_UPDATE( device_stream_update_stub );
 	void recompute_sample_rate_data();
 	void allocate_resample_buffers();
 	void allocate_output_buffers();
+	static int filter_half_taps(int quality, UINT32 in_rate, UINT32 out_rate);
+	void update_resample_filters();
+	void build_resample_filter(stream_input &input, int half);
 	void postload();
+	void update_samples();
 	void generate_samples(int samples);
 	stream_sample_t *generate_resampled_data(stream_input &input, UINT32 numsamples);
+	void generate_filtered_data(stream_input &input, stream_sample_t *dest, const stream_sample_t *source, UINT32 basefrac, UINT32 step, int gain, UINT32 numsamples);
 
 	// linking information
 	device_t &			m_device;				// owning device
@@ -194,6 +215,10 @@ private:
 	// callback information
 	stream_update_func	m_callback;				// callback function
 	void *				m_param;				// callback function parameter
+
+	// threading information
+	bool				m_parallel_update;		// can we be updated on a worker thread?
+	int					m_update_level;			// depth in the stream graph; -1 if not yet computed
 };
 
 
@@ -225,6 +250,7 @@ public:
 	sound_stream *first_stream() const { return m_stream_list.first(); }
 	attotime last_update() const { return m_last_update; }
 	attoseconds_t update_attoseconds() const { return m_update_attoseconds; }
+	int resample_quality() const { return m_resample_quality; }
 
 	// stream creation
 	sound_stream *stream_alloc(device_t &device, int inputs, int outputs, int sample_rate, void *param = NULL, sound_stream::stream_update_func callback = NULL);
@@ -250,6 +276,8 @@ private:
 
 	static TIMER_CALLBACK( update_static ) { reinterpret_cast<sound_manager *>(ptr)->update(); }
 	void update();
+	void update_stream_graph();
+	void update_streams_parallel();
 
 	// internal state
 	running_machine &	m_machine;				// reference to our machine
@@ -263,11 +291,18 @@ private:
 	UINT8				m_muted;
 	int 				m_attenuation;
 	int 				m_nosound_mode;
+	int					m_resample_quality;		// 0 for simple interpolation, 1-3 for band-limited
+	bool				m_sound_threads;		// may independent streams update on the work queue?
 
 	wav_file *			m_wavfile;
 
 	// streams data
 	simple_list<sound_stream> m_stream_list;	// list of streams
+	bool				m_graph_dirty;			// do the update levels need recomputing?
+	int					m_graph_levels;			// number of levels in the stream graph
+	osd_work_queue *	m_queue;				// work queue for parallel stream updates
+	sound_stream **		m_work_list;			// scratch list of streams to hand to the queue
+	int					m_work_alloc;			// allocated size of the scratch list
 	attoseconds_t		m_update_attoseconds;	// attoseconds between global updates
 	attotime			m_last_update;			// last update time
 };
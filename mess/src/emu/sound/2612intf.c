@@ -112,6 +112,7 @@ static DEVICE_START( ym2612 )
 
 	/* stream system initialize */
 	info->stream = device->machine().sound().stream_alloc(*device,0,2,rate,info,ym2612_stream_update);
+	info->stream->set_parallel_update();
 
 	/**** initialize YM2612 ****/
 	info->chip = ym2612_init(info,device,device->clock(),rate,timer_handler,IRQHandler);
@@ -154,6 +154,9 @@ static DEVICE_START( rf5c68 )
 		chip->sample_callback = intf->sample_end_callback;
 	else
 		chip->sample_callback = NULL;
+
+	/* the sample end callback calls out to the driver, so only go wide without one */
+	chip->stream->set_parallel_update(chip->sample_callback == NULL);
 }
 
 
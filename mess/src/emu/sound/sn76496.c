@@ -361,6 +361,7 @@ static int SN76496_init(device_t *device, sn76496_state *R, int stereo)
 	int i;
 
 	R->Channel = device->machine().sound().stream_alloc(*device,0,(stereo?2:1),sample_rate,R,SN76496Update);
+	R->Channel->set_parallel_update();
 
 	for (i = 0;i < 4;i++) R->Volume[i] = 0;
 
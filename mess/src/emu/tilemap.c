@@ -26,6 +26,12 @@
 /* maximum index in each array */
 #define MAX_PEN_TO_FLAGS				256
 
+/* updates with fewer dirty tiles than this are drawn on the calling thread */
+#define MIN_PARALLEL_TILES				256
+
+/* maximum number of bands a large update is split into */
+#define MAX_TILE_BANDS					16
+
 
 /***************************************************************************
     TYPE DEFINITIONS
@@ -64,6 +70,33 @@ struct _blit_parameters
 };
 
 
+/* a dirty tile whose info has been fetched, ready to be drawn */
+typedef struct _tile_job tile_job;
+struct _tile_job
+{
+	const UINT8 *		pen_data;			/* pen data, with the pen data offset applied */
+	const UINT8 *		mask_data;			/* mask data, or NULL */
+	UINT32				palette_base;		/* palette base */
+	tilemap_logical_index logindex;		/* logical index of the tile */
+	UINT32				col;				/* tile column */
+	UINT32				row;				/* tile row */
+	UINT8				category;			/* category */
+	UINT8				group;				/* group */
+	UINT8				flags;				/* flags, with the global flip applied */
+	UINT8				pen_mask;			/* pen mask */
+};
+
+
+/* a contiguous run of tile jobs drawn by one work item */
+typedef struct _tile_band tile_band;
+struct _tile_band
+{
+	tilemap_t *			tmap;
+	const tile_job *	job;
+	UINT32				count;
+};
+
+
 /* core tilemap structure */
 class tilemap_t
 {
@@ -124,6 +157,9 @@ public:
 	UINT8 *						tileflags;			/* per-tile flags */
 	UINT8 *						pen_to_flags;		/* mapping of pens to flags */
 
+	/* dirty tile staging, allocated on first update */
+	tile_job *					jobs;				/* fetched tiles awaiting drawing */
+
 private:
 	running_machine &			m_machine;			/* pointer back to the owning machine */
 };
@@ -134,6 +170,7 @@ struct _tilemap_private
 	tilemap_t *		list;
 	tilemap_t **		tailptr;
 	int				instance;
+	osd_work_queue *	work_queue;			/* queue for drawing large updates */
 };
 
 
@@ -155,6 +192,9 @@ static void mappings_update(tilemap_t *tmap);
 /* tile rendering */
 static void pixmap_update(tilemap_t *tmap, const rectangle *cliprect);
 static void tile_update(tilemap_t *tmap, tilemap_logical_index logindex, UINT32 cached_col, UINT32 cached_row);
+static void tile_fetch(tilemap_t *tmap, tile_job *job, tilemap_logical_index logindex, UINT32 col, UINT32 row);
+static void tile_render(tilemap_t *tmap, const tile_job *job);
+static void *tile_band_callback(void *param, int threadid);
 static UINT8 tile_draw(tilemap_t *tmap, const UINT8 *pendata, UINT32 x0, UINT32 y0, UINT32 palette_base, UINT8 category, UINT8 group, UINT8 flags, UINT8 pen_mask);
 static UINT8 tile_apply_bitmask(tilemap_t *tmap, const UINT8 *maskdata, UINT32 x0, UINT32 y0, UINT8 category, UINT8 flags);
 
@@ -352,6 +392,7 @@ static tilemap_t *tilemap_create_common(running_machine &machine, void *get_info
 	{
 		machine.tilemap_data = auto_alloc_clear(machine, tilemap_private);
 		machine.tilemap_data->tailptr = &machine.tilemap_data->list;
+		machine.tilemap_data->work_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
 	}
 	tilemap_instance = machine.tilemap_data->instance;
 
@@ -1138,6 +1179,13 @@ static void tilemap_exit(running_machine &machine)
 			tilemap_dispose(tilemap_data->list);
 			tilemap_data->list = next;
 		}
+
+	/* free the work queue */
+	if (tilemap_data != NULL && tilemap_data->work_queue != NULL)
+	{
+		osd_work_queue_free(tilemap_data->work_queue);
+		tilemap_data->work_queue = NULL;
+	}
 }
 
 
@@ -1169,6 +1217,8 @@ static void tilemap_dispose(tilemap_t *tmap)
 		}
 
 	/* free allocated memory */
+	if (tmap->jobs != NULL)
+		auto_free(tmap->machine(), tmap->jobs);
 	auto_free(tmap->machine(), tmap->pen_to_flags);
 	auto_free(tmap->machine(), tmap->tileflags);
 	auto_free(tmap->machine(), tmap->flagsmap);
@@ -1268,7 +1318,9 @@ static void mappings_update(tilemap_t *tmap)
 
 static void pixmap_update(tilemap_t *tmap, const rectangle *cliprect)
 {
+	osd_work_queue *queue = tmap->machine().tilemap_data->work_queue;
 	int mincol, maxcol, minrow, maxrow;
+	UINT32 count = 0;
 	int row, col;
 
 	/* if the graphics changed, we need to mark everything dirty */
@@ -1304,7 +1356,12 @@ g_profiler.start(PROFILER_TILEMAP_DRAW);
 		tmap->gfx_used = 0;
 	}
 
-	/* iterate over rows */
+	/* allocate the staging area the first time through */
+	if (tmap->jobs == NULL)
+		tmap->jobs = auto_alloc_array(tmap->machine(), tile_job, tmap->max_logical_index);
+
+	/* fetch every dirty tile in order; the get_info callbacks are driver code, so they stay on this thread */
+g_profiler.start(PROFILER_TILEMAP_UPDATE);
 	for (row = minrow; row <= maxrow; row++)
 	{
 		tilemap_logical_index logindex = row * tmap->cols;
@@ -1312,7 +1369,37 @@ g_profiler.start(PROFILER_TILEMAP_DRAW);
 		/* iterate over colums */
 		for (col = mincol; col <= maxcol; col++)
 			if (tmap->tileflags[logindex + col] == TILE_FLAG_DIRTY)
-				tile_update(tmap, logindex + col, col, row);
+				tile_fetch(tmap, &tmap->jobs[count++], logindex + col, col, row);
+	}
+g_profiler.stop();
+
+	/* small updates are drawn right here */
+	if (count < MIN_PARALLEL_TILES || queue == NULL)
+	{
+		UINT32 jobnum;
+
+		for (jobnum = 0; jobnum < count; jobnum++)
+			tile_render(tmap, &tmap->jobs[jobnum]);
+	}
+
+	/* large ones are split into bands; each tile touches only its own pixels and
+       flags, so the result does not depend on how the bands are scheduled */
+	else
+	{
+		tile_band band[MAX_TILE_BANDS];
+		int bandnum;
+
+		for (bandnum = 0; bandnum < MAX_TILE_BANDS; bandnum++)
+		{
+			UINT32 first = count * bandnum / MAX_TILE_BANDS;
+			band[bandnum].tmap = tmap;
+			band[bandnum].job = &tmap->jobs[first];
+			band[bandnum].count = count * (bandnum + 1) / MAX_TILE_BANDS - first;
+		}
+
+		/* queue them all and wait; the band data lives on our stack */
+		osd_work_item_queue_multiple(queue, tile_band_callback, MAX_TILE_BANDS, band, sizeof(band[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+		while (!osd_work_queue_wait(queue, osd_ticks_per_second() * 10)) ;
 	}
 
 	/* mark it all clean */
@@ -1329,27 +1416,42 @@ g_profiler.stop();
 
 static void tile_update(tilemap_t *tmap, tilemap_logical_index logindex, UINT32 col, UINT32 row)
 {
-	UINT32 x0 = tmap->tilewidth * col;
-	UINT32 y0 = tmap->tileheight * row;
-	tilemap_memory_index memindex;
-	UINT32 flags;
+	tile_job job;
 
 g_profiler.start(PROFILER_TILEMAP_UPDATE);
 
+	tile_fetch(tmap, &job, logindex, col, row);
+	tile_render(tmap, &job);
+
+g_profiler.stop();
+}
+
+
+/*-------------------------------------------------
+    tile_fetch - call the get_info callback for
+    a dirty tile and record what is needed to
+    draw it
+-------------------------------------------------*/
+
+static void tile_fetch(tilemap_t *tmap, tile_job *job, tilemap_logical_index logindex, UINT32 col, UINT32 row)
+{
+	tilemap_memory_index memindex;
+
 	/* call the get info callback for the associated memory index */
 	memindex = tmap->logical_to_memory[logindex];
 	(*tmap->tile_get_info)(*(running_machine *)tmap->tile_get_info_object, &tmap->tileinfo, memindex, tmap->user_data);
 
-	/* apply the global tilemap flip to the returned flip flags */
-	flags = tmap->tileinfo.flags ^ (tmap->attributes & 0x03);
-
-	/* draw the tile, using either direct or transparent */
-	tmap->tileflags[logindex] = tile_draw(tmap, tmap->tileinfo.pen_data + tmap->pen_data_offset, x0, y0,
-		tmap->tileinfo.palette_base, tmap->tileinfo.category, tmap->tileinfo.group, flags, tmap->tileinfo.pen_mask);
-
-	/* if mask data is specified, apply it */
-	if ((flags & (TILE_FORCE_LAYER0 | TILE_FORCE_LAYER1 | TILE_FORCE_LAYER2)) == 0 && tmap->tileinfo.mask_data != NULL)
-		tmap->tileflags[logindex] = tile_apply_bitmask(tmap, tmap->tileinfo.mask_data, x0, y0, tmap->tileinfo.category, flags);
+	/* record the results, applying the global tilemap flip to the returned flip flags */
+	job->pen_data = tmap->tileinfo.pen_data + tmap->pen_data_offset;
+	job->mask_data = tmap->tileinfo.mask_data;
+	job->palette_base = tmap->tileinfo.palette_base;
+	job->logindex = logindex;
+	job->col = col;
+	job->row = row;
+	job->category = tmap->tileinfo.category;
+	job->group = tmap->tileinfo.group;
+	job->flags = tmap->tileinfo.flags ^ (tmap->attributes & 0x03);
+	job->pen_mask = tmap->tileinfo.pen_mask;
 
 	/* track which gfx have been used for this tilemap */
 	if (tmap->tileinfo.gfxnum != 0xff && (tmap->gfx_used & (1 << tmap->tileinfo.gfxnum)) == 0)
@@ -1357,8 +1459,43 @@ g_profiler.start(PROFILER_TILEMAP_UPDATE);
 		tmap->gfx_used |= 1 << tmap->tileinfo.gfxnum;
 		tmap->gfx_dirtyseq[tmap->tileinfo.gfxnum] = tmap->machine().gfx[tmap->tileinfo.gfxnum]->dirtyseq;
 	}
+}
 
-g_profiler.stop();
+
+/*-------------------------------------------------
+    tile_render - draw a fetched tile into the
+    pixmap and flagsmap; safe to call from a
+    worker thread
+-------------------------------------------------*/
+
+static void tile_render(tilemap_t *tmap, const tile_job *job)
+{
+	UINT32 x0 = tmap->tilewidth * job->col;
+	UINT32 y0 = tmap->tileheight * job->row;
+
+	/* draw the tile, using either direct or transparent */
+	tmap->tileflags[job->logindex] = tile_draw(tmap, job->pen_data, x0, y0,
+		job->palette_base, job->category, job->group, job->flags, job->pen_mask);
+
+	/* if mask data is specified, apply it */
+	if ((job->flags & (TILE_FORCE_LAYER0 | TILE_FORCE_LAYER1 | TILE_FORCE_LAYER2)) == 0 && job->mask_data != NULL)
+		tmap->tileflags[job->logindex] = tile_apply_bitmask(tmap, job->mask_data, x0, y0, job->category, job->flags);
+}
+
+
+/*-------------------------------------------------
+    tile_band_callback - draw one band of a
+    large update on a worker thread
+-------------------------------------------------*/
+
+static void *tile_band_callback(void *param, int threadid)
+{
+	tile_band *band = (tile_band *)param;
+	UINT32 jobnum;
+
+	for (jobnum = 0; jobnum < band->count; jobnum++)
+		tile_render(band->tmap, &band->job[jobnum]);
+	return NULL;
 }
 
 
@@ -16,6 +16,7 @@
 #include "profiler.h"
 #include "render.h"
 #include "cheat.h"
+#include "rewind.h"
 #include "rendfont.h"
 #include "ui.h"
 #include "uiinput.h"
@@ -280,8 +281,8 @@ int ui_display_startup_screens(running_machine &machine, int first_time, int sho
 	int state;
 
 	/* disable everything if we are using -str for 300 or fewer seconds, or if we're the empty driver,
-       or if we are debugging */
-	if (!first_time || (str > 0 && str < 60*5) || &machine.system() == &GAME_NAME(___empty) || (machine.debug_flags & DEBUG_FLAG_ENABLED) != 0)
+       or if we are debugging or benchmarking */
+	if (!first_time || (str > 0 && str < 60*5) || machine.options().bench() > 0 || &machine.system() == &GAME_NAME(___empty) || (machine.debug_flags & DEBUG_FLAG_ENABLED) != 0)
 		show_gameinfo = show_warnings = show_disclaimer = FALSE;
 
 	#ifdef SDLMAME_EMSCRIPTEN
@@ -1405,6 +1406,10 @@ static UINT32 handler_ingame(running_machine &machine, render_container *contain
 		return ui_set_handler(handler_load_save, LOADSAVE_LOAD);
 	}
 
+	/* step back through the rewind history for as long as the key is held */
+	if (machine.rewind().enabled() && ui_input_pressed_repeat(machine, IPT_UI_REWIND, 1))
+		machine.rewind().step_back();
+
 	/* handle a save snapshot request */
 	if (ui_input_pressed(machine, IPT_UI_SNAPSHOT))
 		machine.video().save_active_screen_snapshots();
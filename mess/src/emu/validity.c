@@ -1168,6 +1168,9 @@ void validate_drivers(emu_options &options, const game_driver *curdriver)
 	/* validate inline function behavior */
 	error = validate_inlines() || error;
 
+	/* validate the software renderer's SIMD kernels against the scalar ones */
+	error = video_validate_render_kernels() || error;
+
 	get_profile_ticks();
 
 	/* pre-populate the defstr tagmap with all the default strings */
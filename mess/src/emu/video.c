@@ -45,6 +45,7 @@
 #include "ui.h"
 #include "aviio.h"
 #include "crsshair.h"
+#include "zlib.h"
 
 #include "snap.lh"
 
@@ -86,7 +87,11 @@ const UINT8 video_manager::s_skiptable[FRAMESKIP_LEVELS][FRAMESKIP_LEVELS] =
 //**************************************************************************
 
 // software rendering
-static void rgb888_draw_primitives(const render_primitive_list &primlist, void *dstdata, UINT32 width, UINT32 height, UINT32 pitch);
+static void rgb888_draw_primitives(const render_primitive_list &primlist, void *dstdata, UINT32 width, UINT32 height, UINT32 pitch, osd_work_queue *queue);
+static void rgb888_setup_and_draw_textured_quad(const render_primitive *prim, void *dstdata, INT32 width, INT32 height, UINT32 pitch, INT32 top, INT32 bottom);
+static void rgb888_nearest_setup_and_draw_textured_quad(const render_primitive *prim, void *dstdata, INT32 width, INT32 height, UINT32 pitch, INT32 top, INT32 bottom);
+static void rgb888_scalar_setup_and_draw_textured_quad(const render_primitive *prim, void *dstdata, INT32 width, INT32 height, UINT32 pitch, INT32 top, INT32 bottom);
+static void rgb888_nearest_scalar_setup_and_draw_textured_quad(const render_primitive *prim, void *dstdata, INT32 width, INT32 height, UINT32 pitch, INT32 top, INT32 bottom);
 
 
 
@@ -114,6 +119,7 @@ video_manager::video_manager(running_machine &machine)
 	  m_overall_valid_counter(0),
 	  m_throttle(machine.options().throttle()),
 	  m_fastforward(false),
+	  m_external_pacing(false),
 	  m_seconds_to_run(machine.options().seconds_to_run()),
 	  m_auto_frameskip(machine.options().auto_frameskip()),
 	  m_speed(original_speed_setting()),
@@ -132,7 +138,15 @@ video_manager::video_manager(running_machine &machine)
 	  m_avifile(NULL),
 	  m_movie_frame_period(attotime::zero),
 	  m_movie_next_frame_time(attotime::zero),
-	  m_movie_frame(0)
+	  m_movie_frame(0),
+	  m_hashfile(NULL),
+	  m_hash_verify(false),
+	  m_hash_interval(0),
+	  m_hash_next_second(0),
+	  m_hash_audio_crc(0),
+	  m_hash_expected_video(0),
+	  m_hash_expected_audio(0),
+	  m_hash_checked(0)
 {
 	// request a callback upon exiting
 	machine.add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(FUNC(video_manager::exit), this));
@@ -179,6 +193,9 @@ video_manager::video_manager(running_machine &machine)
 	if (filename[0] != 0)
 		begin_recording(filename, MF_AVI);
 
+	// start writing or checking output hashes if specified
+	begin_output_hash();
+
 	// if no screens, create a periodic timer to drive updates
 	if (machine.primary_screen == NULL)
 	{
@@ -241,9 +258,10 @@ void video_manager::frame_update(bool debug)
 	// update the internal render debugger
 	debugint_update_during_game(machine());
 
-	// if we're throttling, synchronize before rendering
+	// if we're throttling, synchronize before rendering; a host loop that paces
+	// us itself only wants the speed and frameskip bookkeeping
 	attotime current_time = machine().time();
-	if (!debug && !skipped_it && effective_throttle())
+	if (!debug && !skipped_it && effective_throttle() && !m_external_pacing)
 		update_throttle(current_time);
 
 	// ask the OSD to update
@@ -515,6 +533,10 @@ void video_manager::end_recording()
 
 void video_manager::add_sound_to_recording(const INT16 *sound, int numsamples)
 {
+	// fold the samples into the output hash
+	if (m_hashfile != NULL)
+		m_hash_audio_crc = crc32(m_hash_audio_crc, (const UINT8 *)sound, numsamples * 2 * sizeof(*sound));
+
 	// only record if we have a file
 	if (m_avifile != NULL)
 	{
@@ -542,6 +564,14 @@ void video_manager::exit()
 	// stop recording any movie
 	end_recording();
 
+	// close the hash file; if we are verifying, finish_output_hash has
+	// already reported on it, or the run ended in an error anyway
+	if (m_hashfile != NULL)
+	{
+		auto_free(machine(), m_hashfile);
+		m_hashfile = NULL;
+	}
+
 	// free all the graphics elements
 	for (int i = 0; i < MAX_GFX_ELEMENTS; i++)
 		gfx_element_free(machine().gfx[i]);
@@ -672,6 +702,7 @@ bool video_manager::finish_screen_updates()
 	if (!machine().paused())
 	{
 		record_frame();
+		update_output_hash();
 
 		// iterate over screens and update the burnin for the ones that care
 		for (screen_device *screen = machine().first_screen(); screen != NULL; screen = screen->next_screen())
@@ -1086,7 +1117,7 @@ void video_manager::create_snapshot_bitmap(device_t *screen)
 	// render the screen there
 	render_primitive_list &primlist = m_snap_target->get_primitives();
 	primlist.acquire_lock();
-	rgb888_draw_primitives(primlist, m_snap_bitmap->base, width, height, m_snap_bitmap->rowpixels);
+	rgb888_draw_primitives(primlist, m_snap_bitmap->base, width, height, m_snap_bitmap->rowpixels, NULL);
 	primlist.release_lock();
 }
 
@@ -1285,6 +1316,385 @@ void video_manager::record_frame()
 
 
 
+
+//-------------------------------------------------
+//  begin_output_hash - open the hash file named
+//  by -hashwrite or -hashverify
+//-------------------------------------------------
+
+void video_manager::begin_output_hash()
+{
+	const char *filename = machine().options().hash_verify();
+	m_hash_verify = (filename[0] != 0);
+	if (!m_hash_verify)
+	{
+		filename = machine().options().hash_write();
+		if (filename[0] == 0)
+			return;
+	}
+
+	// hash files live alongside the input logs they were made with
+	UINT32 openflags = m_hash_verify ? OPEN_FLAG_READ : (OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS | OPEN_FLAG_NO_BOM);
+	m_hashfile = auto_alloc(machine(), emu_file(machine().options().input_directory(), openflags));
+	file_error filerr = m_hashfile->open(filename);
+	if (filerr != FILERR_NONE)
+	{
+		auto_free(machine(), m_hashfile);
+		m_hashfile = NULL;
+		fatalerror("Unable to open output hash file %s", filename);
+	}
+
+	// when writing, emit a header and checkpoint at every interval
+	if (!m_hash_verify)
+	{
+		m_hash_interval = MAX(machine().options().hash_interval(), 1);
+		m_hash_next_second = m_hash_interval;
+		m_hashfile->printf("# %s %s output hashes for %s: second, framebuffer CRC, audio CRC\n", APPNAME, build_version, machine().system().name);
+	}
+
+	// when verifying, the file tells us when to check
+	else if (!read_output_hash())
+	{
+		auto_free(machine(), m_hashfile);
+		m_hashfile = NULL;
+	}
+}
+
+
+//-------------------------------------------------
+//  read_output_hash - read the next checkpoint
+//  from the hash file; returns false at the end
+//-------------------------------------------------
+
+bool video_manager::read_output_hash()
+{
+	char line[256];
+	while (m_hashfile->gets(line, ARRAY_LENGTH(line)) != NULL)
+	{
+		// skip comments and blank lines
+		if (line[0] == '#' || line[0] == '\r' || line[0] == '\n' || line[0] == 0)
+			continue;
+
+		if (sscanf(line, "%u %x %x", &m_hash_next_second, &m_hash_expected_video, &m_hash_expected_audio) == 3)
+			return true;
+		mame_printf_warning("Ignoring malformed output hash line: %s", line);
+	}
+	return false;
+}
+
+
+//-------------------------------------------------
+//  update_output_hash - at each checkpoint, hash
+//  the snapshot bitmap and the audio mixed since
+//  the last checkpoint, and write or check them
+//-------------------------------------------------
+
+void video_manager::update_output_hash()
+{
+	// ignore if nothing to do or not yet at the next checkpoint
+	if (m_hashfile == NULL || machine().time().seconds < m_hash_next_second)
+		return;
+
+	// hash the full snapshot, which goes through the same renderer as the OSD
+	UINT32 videocrc = 0;
+	if (machine().primary_screen != NULL)
+	{
+		create_snapshot_bitmap(NULL);
+		for (int y = 0; y < m_snap_bitmap->height; y++)
+			videocrc = crc32(videocrc, (const UINT8 *)BITMAP_ADDR32(m_snap_bitmap, y, 0), m_snap_bitmap->width * sizeof(UINT32));
+	}
+	UINT32 audiocrc = m_hash_audio_crc;
+	m_hash_audio_crc = 0;
+
+	// write mode: just record and advance
+	if (!m_hash_verify)
+	{
+		m_hashfile->printf("%u %08X %08X\n", m_hash_next_second, videocrc, audiocrc);
+		m_hash_next_second += m_hash_interval;
+		return;
+	}
+
+	// verify mode: stop at the first divergence
+	if (videocrc != m_hash_expected_video || audiocrc != m_hash_expected_audio)
+		throw emu_fatalerror(MAMERR_FATALERROR, "Output hash mismatch at %u seconds: framebuffer %08X (expected %08X), audio %08X (expected %08X)",
+				m_hash_next_second, videocrc, m_hash_expected_video, audiocrc, m_hash_expected_audio);
+	m_hash_checked++;
+
+	// once the file runs out, there is nothing left to check
+	if (!read_output_hash())
+	{
+		mame_printf_info("Output hashes matched at %d checkpoint(s)\n", m_hash_checked);
+		auto_free(machine(), m_hashfile);
+		m_hashfile = NULL;
+	}
+}
+
+
+//-------------------------------------------------
+//  finish_output_hash - called when the machine
+//  exits normally; a verify run that stops before
+//  its last checkpoint has not verified anything
+//  past that point, so treat it as a failure
+//-------------------------------------------------
+
+void video_manager::finish_output_hash()
+{
+	if (m_hashfile == NULL || !m_hash_verify)
+		return;
+
+	UINT32 remaining = 1;
+	UINT32 next_second = m_hash_next_second;
+	while (read_output_hash())
+		remaining++;
+	throw emu_fatalerror(MAMERR_FATALERROR, "Output hash verification ended at %u seconds with %u checkpoint(s) unchecked, the next at %u seconds (%u matched)",
+			machine().time().seconds, remaining, next_second, m_hash_checked);
+}
+
+
+//-------------------------------------------------
+//  benchmark_render - time the software renderer
+//  scaling a noisy 320x240 texture up to fill a
+//  1280x960 target, for each texture format and
+//  blend mode it has a kernel for, both filtered
+//  and unfiltered, and return the megapixels
+//  drawn per second as JSON members
+//-------------------------------------------------
+
+void video_manager::benchmark_render(astring &string)
+{
+	static const struct
+	{
+		const char *	name;
+		int				format;
+		int				blendmode;
+		float			r, g, b, a;
+	} cases[] =
+	{
+		{ "palette16_none",		TEXFORMAT_PALETTE16,	BLENDMODE_NONE,			1.0f, 1.0f,  1.0f, 1.0f },
+		{ "palette16_add",		TEXFORMAT_PALETTE16,	BLENDMODE_ADD,			1.0f, 1.0f,  1.0f, 1.0f },
+		{ "yuy16_none",			TEXFORMAT_YUY16,		BLENDMODE_NONE,			1.0f, 1.0f,  1.0f, 1.0f },
+		{ "rgb32_none",			TEXFORMAT_RGB32,		BLENDMODE_NONE,			1.0f, 1.0f,  1.0f, 1.0f },
+		{ "rgb32_tinted",		TEXFORMAT_RGB32,		BLENDMODE_NONE,			1.0f, 0.75f, 0.5f, 1.0f },
+		{ "rgb32_alpha",		TEXFORMAT_RGB32,		BLENDMODE_ALPHA,		1.0f, 1.0f,  1.0f, 0.5f },
+		{ "rgb32_add",			TEXFORMAT_RGB32,		BLENDMODE_ADD,			1.0f, 1.0f,  1.0f, 1.0f },
+		{ "argb32_alpha",		TEXFORMAT_ARGB32,		BLENDMODE_ALPHA,		1.0f, 1.0f,  1.0f, 1.0f },
+		{ "argb32_multiply",	TEXFORMAT_ARGB32,		BLENDMODE_RGB_MULTIPLY,	1.0f, 1.0f,  1.0f, 1.0f },
+		{ "argb32_add",			TEXFORMAT_ARGB32,		BLENDMODE_ADD,			1.0f, 1.0f,  1.0f, 1.0f }
+	};
+	static const struct
+	{
+		const char *	suffix;
+		void			(*draw)(const render_primitive *prim, void *dstdata, INT32 width, INT32 height, UINT32 pitch, INT32 top, INT32 bottom);
+	} filters[] =
+	{
+		{ "",			rgb888_setup_and_draw_textured_quad },
+		{ "_nearest",	rgb888_nearest_setup_and_draw_textured_quad }
+	};
+	const int srcwidth = 320, srcheight = 240;
+	const int dstwidth = 1280, dstheight = 960;
+	const int iterations = 20;
+
+	// random texels; the 16bpp ones stay within a 256-entry palette
+	UINT32 *texture32 = global_alloc_array(UINT32, srcwidth * srcheight);
+	UINT16 *texture16 = global_alloc_array(UINT16, srcwidth * srcheight);
+	rgb_t *palette = global_alloc_array(rgb_t, 256);
+	UINT32 *dest = global_alloc_array_clear(UINT32, dstwidth * dstheight);
+	UINT32 seed = 12345;
+	for (int index = 0; index < srcwidth * srcheight; index++)
+	{
+		seed = seed * 1103515245 + 12345;
+		texture32[index] = seed;
+		texture16[index] = (seed >> 16) & 0xff;
+	}
+	for (int index = 0; index < 256; index++)
+		palette[index] = MAKE_ARGB(0xff, index, index ^ 0x55, 255 - index);
+
+	// one quad covering the whole target
+	render_primitive prim;
+	prim.reset();
+	prim.type = render_primitive::QUAD;
+	prim.bounds.x0 = prim.bounds.y0 = 0;
+	prim.bounds.x1 = dstwidth;
+	prim.bounds.y1 = dstheight;
+	prim.texcoords.tl.u = prim.texcoords.tl.v = prim.texcoords.tr.v = prim.texcoords.bl.u = 0;
+	prim.texcoords.tr.u = prim.texcoords.bl.v = prim.texcoords.br.u = prim.texcoords.br.v = 1.0f;
+	prim.texture.rowpixels = srcwidth;
+	prim.texture.width = srcwidth;
+	prim.texture.height = srcheight;
+
+	// the bilinear kernels keep their plain names; the OSD's unfiltered ones get _nearest
+	double tps = (double)osd_ticks_per_second();
+	for (int filternum = 0; filternum < ARRAY_LENGTH(filters); filternum++)
+		for (int casenum = 0; casenum < ARRAY_LENGTH(cases); casenum++)
+		{
+			bool palettized = (cases[casenum].format == TEXFORMAT_PALETTE16);
+			prim.flags = PRIMFLAG_TEXFORMAT(cases[casenum].format) | PRIMFLAG_BLENDMODE(cases[casenum].blendmode);
+			prim.texture.base = (palettized || cases[casenum].format == TEXFORMAT_YUY16) ? (void *)texture16 : (void *)texture32;
+			prim.texture.palette = palettized ? palette : NULL;
+			prim.color.r = cases[casenum].r;
+			prim.color.g = cases[casenum].g;
+			prim.color.b = cases[casenum].b;
+			prim.color.a = cases[casenum].a;
+
+			osd_ticks_t start = osd_ticks();
+			for (int iter = 0; iter < iterations; iter++)
+				(*filters[filternum].draw)(&prim, dest, dstwidth, dstheight, dstwidth, 0, dstheight);
+			osd_ticks_t ticks = osd_ticks() - start;
+			string.catprintf("%s\"%s%s\": %.1f", (filternum == 0 && casenum == 0) ? "" : ", ", cases[casenum].name, filters[filternum].suffix,
+					(ticks > 0) ? (double)dstwidth * dstheight * iterations * tps / ((double)ticks * 1000000.0) : 0);
+		}
+
+	global_free(dest);
+	global_free(palette);
+	global_free(texture16);
+	global_free(texture32);
+}
+
+
+/*-------------------------------------------------
+    video_validate_render_kernels - draw random
+    quads with the SIMD and the scalar builds of
+    the software renderer, filtered and not, for
+    every texture format and blend mode, and
+    report any pixel where they differ; returns
+    true on error
+-------------------------------------------------*/
+
+bool video_validate_render_kernels(void)
+{
+	static const struct
+	{
+		const char *	name;
+		int				format;
+		int				blendmode;
+	} kernels[] =
+	{
+		{ "palette16_none",		TEXFORMAT_PALETTE16,	BLENDMODE_NONE },
+		{ "palette16_alpha",	TEXFORMAT_PALETTE16,	BLENDMODE_ALPHA },
+		{ "palette16_add",		TEXFORMAT_PALETTE16,	BLENDMODE_ADD },
+		{ "palettea16_alpha",	TEXFORMAT_PALETTEA16,	BLENDMODE_ALPHA },
+		{ "yuy16_none",			TEXFORMAT_YUY16,		BLENDMODE_NONE },
+		{ "rgb15_none",			TEXFORMAT_RGB15,		BLENDMODE_NONE },
+		{ "rgb15_alpha",		TEXFORMAT_RGB15,		BLENDMODE_ALPHA },
+		{ "rgb32_none",			TEXFORMAT_RGB32,		BLENDMODE_NONE },
+		{ "rgb32_alpha",		TEXFORMAT_RGB32,		BLENDMODE_ALPHA },
+		{ "rgb32_add",			TEXFORMAT_RGB32,		BLENDMODE_ADD },
+		{ "argb32_none",		TEXFORMAT_ARGB32,		BLENDMODE_NONE },
+		{ "argb32_alpha",		TEXFORMAT_ARGB32,		BLENDMODE_ALPHA },
+		{ "argb32_multiply",	TEXFORMAT_ARGB32,		BLENDMODE_RGB_MULTIPLY },
+		{ "argb32_add",			TEXFORMAT_ARGB32,		BLENDMODE_ADD }
+	};
+	static const struct
+	{
+		float			r, g, b, a;
+	} colors[] =
+	{
+		{ 1.0f, 1.0f,  1.0f, 1.0f },
+		{ 1.0f, 0.75f, 0.5f, 1.0f },
+		{ 0.8f, 0.6f,  1.0f, 0.5f },
+		{ 1.0f, 1.0f,  1.0f, 0.0f }
+	};
+	static const struct
+	{
+		float			x0, y0, x1, y1;
+	} bounds[] =
+	{
+		{ 3.3f, 2.6f, 197.8f, 149.2f },		// scaled up, with ragged span ends
+		{ 10.0f, 7.0f, 51.0f, 38.0f }		// scaled down
+	};
+	static const struct
+	{
+		const char *	name;
+		void			(*simd)(const render_primitive *prim, void *dstdata, INT32 width, INT32 height, UINT32 pitch, INT32 top, INT32 bottom);
+		void			(*scalar)(const render_primitive *prim, void *dstdata, INT32 width, INT32 height, UINT32 pitch, INT32 top, INT32 bottom);
+	} filters[] =
+	{
+		{ "nearest",	rgb888_nearest_setup_and_draw_textured_quad,	rgb888_nearest_scalar_setup_and_draw_textured_quad },
+		{ "bilinear",	rgb888_setup_and_draw_textured_quad,			rgb888_scalar_setup_and_draw_textured_quad }
+	};
+	const int srcwidth = 61, srcheight = 47;
+	const int dstwidth = 203, dstheight = 151;
+	bool error = false;
+
+	// random texels, a full 64k-entry palette so any 16bpp texel is a valid index, and a random target
+	UINT32 *texture32 = global_alloc_array(UINT32, srcwidth * srcheight);
+	UINT16 *texture16 = global_alloc_array(UINT16, srcwidth * srcheight);
+	rgb_t *palette = global_alloc_array(rgb_t, 65536);
+	UINT32 *background = global_alloc_array(UINT32, dstwidth * dstheight);
+	UINT32 *simddest = global_alloc_array(UINT32, dstwidth * dstheight);
+	UINT32 *scalardest = global_alloc_array(UINT32, dstwidth * dstheight);
+	UINT32 seed = 12345;
+	for (int index = 0; index < srcwidth * srcheight; index++)
+	{
+		seed = seed * 1103515245 + 12345;
+		texture32[index] = seed;
+		texture16[index] = seed >> 16;
+	}
+	for (int index = 0; index < 65536; index++)
+	{
+		seed = seed * 1103515245 + 12345;
+		palette[index] = seed;
+	}
+	for (int index = 0; index < dstwidth * dstheight; index++)
+	{
+		seed = seed * 1103515245 + 12345;
+		background[index] = seed;
+	}
+
+	render_primitive prim;
+	prim.reset();
+	prim.type = render_primitive::QUAD;
+	prim.texcoords.tl.u = prim.texcoords.tl.v = prim.texcoords.tr.v = prim.texcoords.bl.u = 0;
+	prim.texcoords.tr.u = prim.texcoords.bl.v = prim.texcoords.br.u = prim.texcoords.br.v = 1.0f;
+	prim.texture.rowpixels = srcwidth;
+	prim.texture.width = srcwidth;
+	prim.texture.height = srcheight;
+
+	for (int filternum = 0; filternum < ARRAY_LENGTH(filters); filternum++)
+		for (int kernelnum = 0; kernelnum < ARRAY_LENGTH(kernels); kernelnum++)
+			for (int colornum = 0; colornum < ARRAY_LENGTH(colors); colornum++)
+				for (int boundsnum = 0; boundsnum < ARRAY_LENGTH(bounds); boundsnum++)
+				{
+					int format = kernels[kernelnum].format;
+					bool palettized = (format == TEXFORMAT_PALETTE16 || format == TEXFORMAT_PALETTEA16);
+					prim.flags = PRIMFLAG_TEXFORMAT(format) | PRIMFLAG_BLENDMODE(kernels[kernelnum].blendmode);
+					prim.texture.base = (format == TEXFORMAT_RGB32 || format == TEXFORMAT_ARGB32) ? (void *)texture32 : (void *)texture16;
+					prim.texture.palette = palettized ? palette : NULL;
+					prim.color.r = colors[colornum].r;
+					prim.color.g = colors[colornum].g;
+					prim.color.b = colors[colornum].b;
+					prim.color.a = colors[colornum].a;
+					prim.bounds.x0 = bounds[boundsnum].x0;
+					prim.bounds.y0 = bounds[boundsnum].y0;
+					prim.bounds.x1 = bounds[boundsnum].x1;
+					prim.bounds.y1 = bounds[boundsnum].y1;
+
+					memcpy(simddest, background, dstwidth * dstheight * sizeof(*background));
+					memcpy(scalardest, background, dstwidth * dstheight * sizeof(*background));
+					(*filters[filternum].simd)(&prim, simddest, dstwidth, dstheight, dstwidth, 0, dstheight);
+					(*filters[filternum].scalar)(&prim, scalardest, dstwidth, dstheight, dstwidth, 0, dstheight);
+
+					// report only the first difference of each case
+					for (int index = 0; index < dstwidth * dstheight; index++)
+						if (simddest[index] != scalardest[index])
+						{
+							mame_printf_error("Software renderer %s %s kernel (color %d, bounds %d) differs from the scalar one at %d,%d: %08X (expected %08X)\n",
+									filters[filternum].name, kernels[kernelnum].name, colornum, boundsnum, index % dstwidth, index / dstwidth, simddest[index], scalardest[index]);
+							error = true;
+							break;
+						}
+				}
+
+	global_free(scalardest);
+	global_free(simddest);
+	global_free(background);
+	global_free(palette);
+	global_free(texture16);
+	global_free(texture32);
+	return error;
+}
+
+
 /*-------------------------------------------------
     video_assert_out_of_range_pixels - assert if
     any pixels in the given bitmap contain an
@@ -1328,3 +1738,46 @@ void video_assert_out_of_range_pixels(running_machine &machine, bitmap_t *bitmap
 #define BILINEAR_FILTER		1
 
 #include "rendersw.c"
+
+
+
+// unfiltered and scalar builds of the quad kernels, for benchmark_render
+// and video_validate_render_kernels
+#define FUNC_PREFIX(x)		rgb888_nearest_##x
+#define PIXEL_TYPE			UINT32
+#define SRCSHIFT_R			0
+#define SRCSHIFT_G			0
+#define SRCSHIFT_B			0
+#define DSTSHIFT_R			16
+#define DSTSHIFT_G			8
+#define DSTSHIFT_B			0
+#define QUADS_ONLY			1
+
+#include "rendersw.c"
+
+#define FUNC_PREFIX(x)		rgb888_scalar_##x
+#define PIXEL_TYPE			UINT32
+#define SRCSHIFT_R			0
+#define SRCSHIFT_G			0
+#define SRCSHIFT_B			0
+#define DSTSHIFT_R			16
+#define DSTSHIFT_G			8
+#define DSTSHIFT_B			0
+#define BILINEAR_FILTER		1
+#define NO_SIMD				1
+#define QUADS_ONLY			1
+
+#include "rendersw.c"
+
+#define FUNC_PREFIX(x)		rgb888_nearest_scalar_##x
+#define PIXEL_TYPE			UINT32
+#define SRCSHIFT_R			0
+#define SRCSHIFT_G			0
+#define SRCSHIFT_B			0
+#define DSTSHIFT_R			16
+#define DSTSHIFT_G			8
+#define DSTSHIFT_B			0
+#define NO_SIMD				1
+#define QUADS_ONLY			1
+
+#include "rendersw.c"
@@ -99,6 +99,7 @@ public:
 	void set_frameskip(int frameskip);
 	void set_throttled(bool throttled = true) { m_throttle = throttled; }
 	void set_fastforward(bool ffwd = true) { m_fastforward = ffwd; }
+	void set_external_pacing(bool external = true) { m_external_pacing = external; }
 
 	// render a frame
 	void frame_update(bool debug = false);
@@ -116,6 +117,12 @@ public:
 	void end_recording();
 	void add_sound_to_recording(const INT16 *sound, int numsamples);
 
+	// output hashes
+	void finish_output_hash();
+
+	// benchmarking
+	void benchmark_render(astring &string);
+
 private:
 	// internal helpers
 	void exit();
@@ -141,6 +148,11 @@ private:
 	file_error open_next(emu_file &file, const char *extension);
 	void record_frame();
 
+	// output hash helpers
+	void begin_output_hash();
+	bool read_output_hash();
+	void update_output_hash();
+
 	// internal state
 	running_machine &	m_machine;					// reference to our machine
 
@@ -167,6 +179,7 @@ private:
 	// configuration
 	bool				m_throttle;					// flag: TRUE if we're currently throttled
 	bool				m_fastforward;				// flag: TRUE if we're currently fast-forwarding
+	bool				m_external_pacing;			// flag: TRUE if the host loop paces us instead of update_throttle
 	UINT32				m_seconds_to_run;			// number of seconds to run before quitting
 	bool				m_auto_frameskip;			// flag: TRUE if we're automatically frameskipping
 	UINT32				m_speed;					// overall speed (*100)
@@ -193,6 +206,16 @@ private:
 	attotime			m_movie_next_frame_time;	// time of next frame
 	UINT32				m_movie_frame;				// current movie frame number
 
+	// output hashing
+	emu_file *			m_hashfile;					// handle to the open hash file
+	bool				m_hash_verify;				// are we checking against the file instead of writing it?
+	UINT32				m_hash_interval;			// seconds between checkpoints when writing
+	UINT32				m_hash_next_second;			// emulated second of the next checkpoint
+	UINT32				m_hash_audio_crc;			// running CRC of the audio since the last checkpoint
+	UINT32				m_hash_expected_video;		// expected framebuffer CRC when verifying
+	UINT32				m_hash_expected_audio;		// expected audio CRC when verifying
+	UINT32				m_hash_checked;				// number of checkpoints verified
+
 	static const UINT8		s_skiptable[FRAMESKIP_LEVELS][FRAMESKIP_LEVELS];
 
 	static const attoseconds_t ATTOSECONDS_PER_SPEED_UPDATE = ATTOSECONDS_PER_SECOND / 4;
@@ -206,5 +229,8 @@ private:
 // assert if any pixels in the given bitmap contain an invalid palette index
 void video_assert_out_of_range_pixels(running_machine &machine, bitmap_t *bitmap);
 
+// compare the software renderer's SIMD kernels with the scalar ones; true on error
+bool video_validate_render_kernels(void);
+
 
 #endif	/* __VIDEO_H__ */
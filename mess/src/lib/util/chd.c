@@ -54,6 +54,7 @@
 ***************************************************************************/
 
 #define PRINTF_MAX_HUNK				(0)
+#define PRINTF_CACHE_STATS			(0)
 
 
 
@@ -135,6 +136,16 @@ struct _crcmap_entry
 };
 
 
+/* a single entry in the decompressed hunk cache */
+typedef struct _hunk_cache_entry hunk_cache_entry;
+struct _hunk_cache_entry
+{
+	UINT32					hunknum;		/* hunk number, or ~0 if empty */
+	UINT32					lastuse;		/* LRU timestamp */
+	UINT8 *					data;			/* decompressed data */
+};
+
+
 /* a single metadata entry */
 typedef struct _metadata_entry metadata_entry;
 struct _metadata_entry
@@ -167,6 +178,19 @@ struct _chd_file
 	UINT8 *					compare;		/* hunk compare pointer */
 	UINT32					comparehunk;	/* index of current compare data */
 
+	hunk_cache_entry *		hunkcache;		/* LRU cache of hunks read through chd_read */
+	UINT8 *					hunkcachedata;	/* backing data for the cached hunks */
+	UINT32					hunkcachesize;	/* number of entries in the cache */
+	UINT32					hunkcacheclock;	/* LRU clock */
+	UINT32					lastread;		/* last hunk read through chd_read */
+	UINT8					readahead;		/* read the next hunk in the background? */
+	osd_work_item *			readaheaditem;	/* pending read-ahead work item, or NULL */
+	hunk_cache_entry *		readaheadentry;	/* cache entry being filled by the read-ahead */
+	UINT32					readaheadhunk;	/* hunk being read ahead */
+	UINT64					cachehits;		/* reads satisfied from the cache */
+	UINT64					cachemisses;	/* reads that had to be decompressed */
+	UINT64					cachereadaheads;/* hunks decompressed ahead of use */
+
 	UINT8 *					compressed;		/* pointer to buffer for compressed data */
 	const codec_interface *	codecintf;		/* interface to the codec */
 	void *					codecdata;		/* opaque pointer to codec data */
@@ -240,6 +264,7 @@ static const UINT8 nullsha1[CHD_SHA1_BYTES] = { 0 };
 /* internal async operations */
 static void *async_read_callback(void *param, int threadid);
 static void *async_write_callback(void *param, int threadid);
+static void *async_readahead_callback(void *param, int threadid);
 
 /* internal header operations */
 static chd_error header_validate(const chd_header *header);
@@ -251,6 +276,13 @@ static chd_error hunk_read_into_cache(chd_file *chd, UINT32 hunknum);
 static chd_error hunk_read_into_memory(chd_file *chd, UINT32 hunknum, UINT8 *dest);
 static chd_error hunk_write_from_memory(chd_file *chd, UINT32 hunknum, const UINT8 *src);
 
+/* internal hunk cache */
+static void hunk_cache_free(chd_file *chd);
+static chd_error hunk_cache_read(chd_file *chd, UINT32 hunknum, UINT8 *dest);
+static hunk_cache_entry *hunk_cache_find(chd_file *chd, UINT32 hunknum);
+static hunk_cache_entry *hunk_cache_victim(chd_file *chd);
+static void hunk_cache_queue_readahead(chd_file *chd, UINT32 hunknum);
+
 /* internal map access */
 static chd_error map_write_initial(core_file *file, chd_file *parent, const chd_header *header);
 static chd_error map_read(chd_file *chd);
@@ -515,6 +547,16 @@ INLINE void wait_for_pending_async(chd_file *chd)
 		if (!wait_successful)
 			osd_break_into_debugger("Pending async operation never completed!");
 	}
+
+	/* read-aheads are ours alone, so retire them here */
+	if (chd->readaheaditem != NULL)
+	{
+		int wait_successful = osd_work_item_wait(chd->readaheaditem, 10 * osd_ticks_per_second());
+		if (!wait_successful)
+			osd_break_into_debugger("Pending read-ahead never completed!");
+		osd_work_item_release(chd->readaheaditem);
+		chd->readaheaditem = NULL;
+	}
 }
 
 
@@ -716,6 +758,14 @@ chd_error chd_open_file(core_file *file, int mode, chd_file *parent, chd_file **
 	if (err != CHDERR_NONE)
 		EARLY_EXIT(err);
 
+	/* set up the hunk cache; A/V hunks decompress into caller-configured buffers, so skip those */
+	if (newchd->header.compression != CHDCOMPRESSION_AV)
+	{
+		err = chd_set_cache(newchd, CHD_DEFAULT_CACHE_HUNKS, TRUE);
+		if (err != CHDERR_NONE)
+			EARLY_EXIT(err);
+	}
+
 	/* all done */
 	*chd = newchd;
 	return CHDERR_NONE;
@@ -839,6 +889,8 @@ void chd_close(chd_file *chd)
 		free(chd->compare);
 	if (chd->cache != NULL)
 		free(chd->cache);
+	if (PRINTF_CACHE_STATS) printf("Hunk cache: %d hits, %d misses, %d read ahead\n", (int)chd->cachehits, (int)chd->cachemisses, (int)chd->cachereadaheads);
+	hunk_cache_free(chd);
 
 	/* free the hunk map */
 	if (chd->map != NULL)
@@ -1036,8 +1088,8 @@ chd_error chd_read(chd_file *chd, UINT32 hunknum, void *buffer)
 	/* wait for any pending async operations */
 	wait_for_pending_async(chd);
 
-	/* perform the read */
-	return hunk_read_into_memory(chd, hunknum, (UINT8 *)buffer);
+	/* perform the read through the cache */
+	return hunk_cache_read(chd, hunknum, (UINT8 *)buffer);
 }
 
 
@@ -1153,6 +1205,84 @@ chd_error chd_async_complete(chd_file *chd)
 
 
 
+/***************************************************************************
+    HUNK CACHE MANAGEMENT
+***************************************************************************/
+
+/*-------------------------------------------------
+    chd_set_cache - set the number of hunks
+    cached by chd_read and whether sequential
+    reads trigger a background read-ahead
+-------------------------------------------------*/
+
+chd_error chd_set_cache(chd_file *chd, UINT32 hunks, int readahead)
+{
+	UINT32 entrynum;
+
+	/* punt if NULL or invalid */
+	if (chd == NULL || chd->cookie != COOKIE_VALUE)
+		return CHDERR_INVALID_PARAMETER;
+
+	/* A/V hunks can't be cached */
+	if (hunks != 0 && chd->header.compression == CHDCOMPRESSION_AV)
+		return CHDERR_NOT_SUPPORTED;
+
+	/* wait for any pending async operations, then throw away the old cache */
+	wait_for_pending_async(chd);
+	hunk_cache_free(chd);
+
+	/* read-ahead needs somewhere to put the data */
+	chd->readahead = (hunks != 0 && readahead);
+	chd->lastread = ~0;
+	if (hunks == 0)
+		return CHDERR_NONE;
+
+	/* allocate the entries and their data */
+	chd->hunkcache = (hunk_cache_entry *)malloc(hunks * sizeof(chd->hunkcache[0]));
+	chd->hunkcachedata = (UINT8 *)malloc((size_t)hunks * chd->header.hunkbytes);
+	if (chd->hunkcache == NULL || chd->hunkcachedata == NULL)
+	{
+		hunk_cache_free(chd);
+		chd->readahead = FALSE;
+		return CHDERR_OUT_OF_MEMORY;
+	}
+
+	/* mark everything empty */
+	for (entrynum = 0; entrynum < hunks; entrynum++)
+	{
+		chd->hunkcache[entrynum].hunknum = ~0;
+		chd->hunkcache[entrynum].lastuse = 0;
+		chd->hunkcache[entrynum].data = chd->hunkcachedata + (size_t)entrynum * chd->header.hunkbytes;
+	}
+	chd->hunkcachesize = hunks;
+	return CHDERR_NONE;
+}
+
+
+/*-------------------------------------------------
+    chd_get_cache_stats - return statistics about
+    the hunk cache, for tuning
+-------------------------------------------------*/
+
+chd_error chd_get_cache_stats(chd_file *chd, chd_cache_stats *stats)
+{
+	/* punt if NULL or invalid */
+	if (chd == NULL || chd->cookie != COOKIE_VALUE || stats == NULL)
+		return CHDERR_INVALID_PARAMETER;
+
+	/* let any read-ahead finish so the counts are stable */
+	wait_for_pending_async(chd);
+
+	stats->hunks = chd->hunkcachesize;
+	stats->readahead = chd->readahead;
+	stats->hits = chd->cachehits;
+	stats->misses = chd->cachemisses;
+	stats->readaheads = chd->cachereadaheads;
+	return CHDERR_NONE;
+}
+
+
+
 /***************************************************************************
     METADATA MANAGEMENT
 ***************************************************************************/
@@ -1682,6 +1812,30 @@ static void *async_write_callback(void *param, int threadid)
 
 
 
+/*-------------------------------------------------
+    async_readahead_callback - decompress the
+    next sequential hunk into the cache
+-------------------------------------------------*/
+
+static void *async_readahead_callback(void *param, int threadid)
+{
+	chd_file *chd = (chd_file *)param;
+	chd_error err;
+
+	/* read the hunk into its cache entry, and only publish it if that worked */
+	err = hunk_read_into_memory(chd, chd->readaheadhunk, chd->readaheadentry->data);
+	if (err == CHDERR_NONE)
+	{
+		chd->readaheadentry->hunknum = chd->readaheadhunk;
+		chd->cachereadaheads++;
+	}
+
+	/* return the error */
+	return (void *)err;
+}
+
+
+
 /***************************************************************************
     INTERNAL HEADER OPERATIONS
 ***************************************************************************/
@@ -1988,6 +2142,138 @@ static chd_error hunk_read_into_memory(chd_file *chd, UINT32 hunknum, UINT8 *des
 }
 
 
+/*-------------------------------------------------
+    hunk_cache_free - release the hunk cache
+-------------------------------------------------*/
+
+static void hunk_cache_free(chd_file *chd)
+{
+	if (chd->hunkcache != NULL)
+		free(chd->hunkcache);
+	if (chd->hunkcachedata != NULL)
+		free(chd->hunkcachedata);
+	chd->hunkcache = NULL;
+	chd->hunkcachedata = NULL;
+	chd->hunkcachesize = 0;
+}
+
+
+/*-------------------------------------------------
+    hunk_cache_find - return the cache entry
+    holding the given hunk, or NULL
+-------------------------------------------------*/
+
+static hunk_cache_entry *hunk_cache_find(chd_file *chd, UINT32 hunknum)
+{
+	UINT32 entrynum;
+
+	for (entrynum = 0; entrynum < chd->hunkcachesize; entrynum++)
+		if (chd->hunkcache[entrynum].hunknum == hunknum)
+			return &chd->hunkcache[entrynum];
+	return NULL;
+}
+
+
+/*-------------------------------------------------
+    hunk_cache_victim - return the least recently
+    used cache entry, emptied
+-------------------------------------------------*/
+
+static hunk_cache_entry *hunk_cache_victim(chd_file *chd)
+{
+	hunk_cache_entry *victim = &chd->hunkcache[0];
+	UINT32 entrynum;
+
+	/* empty entries have a timestamp of 0, so they go first */
+	for (entrynum = 1; entrynum < chd->hunkcachesize; entrynum++)
+		if (chd->hunkcache[entrynum].lastuse < victim->lastuse)
+			victim = &chd->hunkcache[entrynum];
+
+	victim->hunknum = ~0;
+	victim->lastuse = 0;
+	return victim;
+}
+
+
+/*-------------------------------------------------
+    hunk_cache_read - read a hunk through the LRU
+    cache, reading ahead on sequential access
+-------------------------------------------------*/
+
+static chd_error hunk_cache_read(chd_file *chd, UINT32 hunknum, UINT8 *dest)
+{
+	hunk_cache_entry *entry;
+	chd_error err;
+
+	/* no cache, or nowhere to copy to, means read directly */
+	if (chd->hunkcachesize == 0 || dest == NULL)
+		return hunk_read_into_memory(chd, hunknum, dest);
+
+	/* if we have it, just copy it out */
+	entry = hunk_cache_find(chd, hunknum);
+	if (entry != NULL)
+		chd->cachehits++;
+
+	/* otherwise, decompress into the oldest entry */
+	else
+	{
+		chd->cachemisses++;
+		entry = hunk_cache_victim(chd);
+		err = hunk_read_into_memory(chd, hunknum, entry->data);
+		if (err != CHDERR_NONE)
+			return err;
+		entry->hunknum = hunknum;
+	}
+
+	/* the LRU clock wraps eventually; reset the timestamps when it does */
+	if (++chd->hunkcacheclock == 0)
+	{
+		UINT32 entrynum;
+		for (entrynum = 0; entrynum < chd->hunkcachesize; entrynum++)
+			chd->hunkcache[entrynum].lastuse = (chd->hunkcache[entrynum].hunknum != ~0) ? 1 : 0;
+		chd->hunkcacheclock = 2;
+	}
+	entry->lastuse = chd->hunkcacheclock;
+	memcpy(dest, entry->data, chd->header.hunkbytes);
+
+	/* if this continues a sequential run, start on the next hunk */
+	if (chd->readahead && hunknum == chd->lastread + 1)
+		hunk_cache_queue_readahead(chd, hunknum + 1);
+	chd->lastread = hunknum;
+	return CHDERR_NONE;
+}
+
+
+/*-------------------------------------------------
+    hunk_cache_queue_readahead - decompress a hunk
+    into the cache in the background
+-------------------------------------------------*/
+
+static void hunk_cache_queue_readahead(chd_file *chd, UINT32 hunknum)
+{
+	/* only compressed hunks in this file are worth it; that also keeps the parent untouched */
+	if (hunknum >= chd->header.totalhunks || chd->hunkcachesize < 2)
+		return;
+	if ((chd->map[hunknum].flags & MAP_ENTRY_FLAG_TYPE_MASK) != MAP_ENTRY_TYPE_COMPRESSED)
+		return;
+	if (hunk_cache_find(chd, hunknum) != NULL)
+		return;
+
+	/* if no queue yet, create one on the fly */
+	if (chd->workqueue == NULL)
+	{
+		chd->workqueue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
+		if (chd->workqueue == NULL)
+			return;
+	}
+
+	/* claim the oldest entry and start; everyone waits on this before touching the file */
+	chd->readaheadentry = hunk_cache_victim(chd);
+	chd->readaheadhunk = hunknum;
+	chd->readaheaditem = osd_work_item_queue(chd->workqueue, async_readahead_callback, chd, 0);
+}
+
+
 /*-------------------------------------------------
     hunk_write_from_memory - write a hunk from
     memory into a CHD
@@ -2006,6 +2292,17 @@ static chd_error hunk_write_from_memory(chd_file *chd, UINT32 hunknum, const UIN
 	if (hunknum > chd->maxhunk)
 		chd->maxhunk = hunknum;
 
+	/* forget any cached copy of the old data */
+	if (chd->hunkcachesize != 0)
+	{
+		hunk_cache_entry *cached = hunk_cache_find(chd, hunknum);
+		if (cached != NULL)
+		{
+			cached->hunknum = ~0;
+			cached->lastuse = 0;
+		}
+	}
+
 	/* first compute the CRC of the original data */
 	newentry.crc = 0;
 	if (src != NULL)
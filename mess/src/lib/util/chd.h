@@ -154,6 +154,9 @@
 #define CHDCOMPRESSION_ZLIB_PLUS	2
 #define CHDCOMPRESSION_AV			3
 
+/* default number of decompressed hunks cached per file */
+#define CHD_DEFAULT_CACHE_HUNKS		16
+
 /* A/V codec configuration parameters */
 #define AV_CODEC_COMPRESS_CONFIG	1
 #define AV_CODEC_DECOMPRESS_CONFIG	2
@@ -276,6 +279,18 @@ struct _chd_verify_result
 };
 
 
+/* structure for returning hunk cache statistics */
+typedef struct _chd_cache_stats chd_cache_stats;
+struct _chd_cache_stats
+{
+	UINT32		hunks;						/* number of hunks the cache holds */
+	UINT8		readahead;					/* is sequential read-ahead enabled? */
+	UINT64		hits;						/* reads satisfied from the cache */
+	UINT64		misses;						/* reads that had to be decompressed */
+	UINT64		readaheads;					/* hunks decompressed ahead of use */
+};
+
+
 
 /***************************************************************************
     FUNCTION PROTOTYPES
@@ -339,6 +354,16 @@ chd_error chd_async_complete(chd_file *chd);
 
 
 
+/* ----- hunk cache management ----- */
+
+/* set the number of decompressed hunks to keep, and whether to read ahead sequentially */
+chd_error chd_set_cache(chd_file *chd, UINT32 hunks, int readahead);
+
+/* return hit/miss statistics for the hunk cache */
+chd_error chd_get_cache_stats(chd_file *chd, chd_cache_stats *stats);
+
+
+
 /* ----- metadata management ----- */
 
 /* get indexed metadata of a particular sort */
@@ -50,8 +50,8 @@
     CONSTANTS
 ***************************************************************************/
 
-/* number of open files to cache */
-#define ZIP_CACHE_SIZE	8
+/* number of closed files to keep parsed */
+#define ZIP_CACHE_SIZE	32
 
 /* offsets in end of central directory structure */
 #define ZIPESIG			0x00
@@ -123,6 +123,7 @@ INLINE UINT32 read_dword(UINT8 *buf)
 ***************************************************************************/
 
 static zip_file *zip_cache[ZIP_CACHE_SIZE];
+static zip_file *zip_open_list;
 
 
 
@@ -131,10 +132,12 @@ static zip_file *zip_cache[ZIP_CACHE_SIZE];
 ***************************************************************************/
 
 /* cache management */
+static zip_error clone_zip_file(const zip_file *source, zip_file **zip);
 static void free_zip_file(zip_file *zip);
 
 /* ZIP file parsing */
 static zip_error read_ecd(zip_file *zip);
+static zip_error build_crc_index(zip_file *zip);
 static zip_error get_compressed_data_offset(zip_file *zip, UINT64 *offset);
 
 /* decompression interfaces */
@@ -171,12 +174,29 @@ zip_error zip_file_open(const char *filename, zip_file **zip)
 		/* if we have a valid entry and it matches our filename, use it and remove from the cache */
 		if (cached != NULL && cached->filename != NULL && strcmp(filename, cached->filename) == 0)
 		{
+			if (cachenum != ARRAY_LENGTH(zip_cache) - 1)
+				memmove(&zip_cache[cachenum], &zip_cache[cachenum + 1], (ARRAY_LENGTH(zip_cache) - 1 - cachenum) * sizeof(zip_cache[0]));
+			zip_cache[ARRAY_LENGTH(zip_cache) - 1] = NULL;
+			cached->next_open = zip_open_list;
+			zip_open_list = cached;
 			*zip = cached;
-			zip_cache[cachenum] = NULL;
 			return ZIPERR_NONE;
 		}
 	}
 
+	/* if someone else has this file open, copy their central directory rather than reparsing it */
+	for (newzip = zip_open_list; newzip != NULL; newzip = newzip->next_open)
+		if (strcmp(filename, newzip->filename) == 0)
+		{
+			ziperr = clone_zip_file(newzip, zip);
+			if (ziperr == ZIPERR_NONE)
+			{
+				(*zip)->next_open = zip_open_list;
+				zip_open_list = *zip;
+			}
+			return ziperr;
+		}
+
 	/* allocate memory for the zip_file structure */
 	newzip = (zip_file *)malloc(sizeof(*newzip));
 	if (newzip == NULL)
@@ -219,6 +239,11 @@ zip_error zip_file_open(const char *filename, zip_file **zip)
 		goto error;
 	}
 
+	/* index the entries by CRC */
+	ziperr = build_crc_index(newzip);
+	if (ziperr != ZIPERR_NONE)
+		goto error;
+
 	/* make a copy of the filename for caching purposes */
 	string = (char *)malloc(strlen(filename) + 1);
 	if (string == NULL)
@@ -228,6 +253,8 @@ zip_error zip_file_open(const char *filename, zip_file **zip)
 	}
 	strcpy(string, filename);
 	newzip->filename = string;
+	newzip->next_open = zip_open_list;
+	zip_open_list = newzip;
 	*zip = newzip;
 	return ZIPERR_NONE;
 
@@ -244,8 +271,18 @@ error:
 
 void zip_file_close(zip_file *zip)
 {
+	zip_file **prevptr;
 	int cachenum;
 
+	/* remove us from the open list */
+	for (prevptr = &zip_open_list; *prevptr != NULL; prevptr = &(*prevptr)->next_open)
+		if (*prevptr == zip)
+		{
+			*prevptr = zip->next_open;
+			break;
+		}
+	zip->next_open = NULL;
+
 	/* close the open files */
 	if (zip->file != NULL)
 		osd_close(zip->file);
@@ -361,9 +398,49 @@ const zip_file_header *zip_file_next_file(zip_file *zip)
 }
 
 
+/*-------------------------------------------------
+    zip_file_first_crc - return the first entry
+    in the ZIP with the given CRC
+-------------------------------------------------*/
+
+const zip_file_header *zip_file_first_crc(zip_file *zip, UINT32 crc)
+{
+	/* start at the head of the hash chain for this CRC */
+	zip->crc_target = crc;
+	zip->crc_pos = (zip->crc_index != NULL) ? zip->crc_index[crc & (zip->crc_buckets - 1)] : 0;
+	return zip_file_next_crc(zip);
+}
+
+
+/*-------------------------------------------------
+    zip_file_next_crc - return the next entry
+    in the ZIP with the same CRC
+-------------------------------------------------*/
+
+const zip_file_header *zip_file_next_crc(zip_file *zip)
+{
+	/* walk the chain until we find a true match */
+	while (zip->crc_pos != 0)
+	{
+		UINT32 entry = zip->crc_pos - 1;
+		UINT32 offset = zip->crc_index[zip->crc_buckets + zip->entries + entry];
+
+		zip->crc_pos = zip->crc_index[zip->crc_buckets + entry];
+		if (read_dword(zip->cd + offset + ZIPCCRC) == zip->crc_target)
+		{
+			/* parse it just as if we had iterated to it */
+			zip->cd_pos = offset;
+			return zip_file_next_file(zip);
+		}
+	}
+	return NULL;
+}
+
+
 /*-------------------------------------------------
     zip_file_decompress - decompress a file
-    from a ZIP into the target buffer
+    from a ZIP into the target buffer; separate
+    handles may decompress concurrently
 -------------------------------------------------*/
 
 zip_error zip_file_decompress(zip_file *zip, void *buffer, UINT32 length)
@@ -408,6 +485,55 @@ zip_error zip_file_decompress(zip_file *zip, void *buffer, UINT32 length)
     CACHE MANAGEMENT
 ***************************************************************************/
 
+/*-------------------------------------------------
+    clone_zip_file - make a new handle from an
+    already-parsed zip_file without touching
+    the disk
+-------------------------------------------------*/
+
+static zip_error clone_zip_file(const zip_file *source, zip_file **zip)
+{
+	UINT32 indexsize = source->crc_buckets + 2 * source->entries;
+	zip_file *newzip;
+	char *string;
+
+	/* allocate memory for the zip_file structure; the file is opened on demand */
+	newzip = (zip_file *)malloc(sizeof(*newzip));
+	if (newzip == NULL)
+		return ZIPERR_OUT_OF_MEMORY;
+	memset(newzip, 0, sizeof(*newzip));
+	newzip->length = source->length;
+	newzip->ecd = source->ecd;
+	newzip->ecd.raw = NULL;
+	newzip->entries = source->entries;
+	newzip->crc_buckets = source->crc_buckets;
+
+	/* copy all the parsed data */
+	string = (char *)malloc(strlen(source->filename) + 1);
+	newzip->ecd.raw = (UINT8 *)malloc(source->ecd.rawlength + 1);
+	newzip->cd = (UINT8 *)malloc(source->ecd.cd_size + 1);
+	newzip->crc_index = (UINT32 *)malloc(indexsize * sizeof(newzip->crc_index[0]));
+	newzip->filename = string;
+	if (string == NULL || newzip->ecd.raw == NULL || newzip->cd == NULL || newzip->crc_index == NULL)
+	{
+		free_zip_file(newzip);
+		return ZIPERR_OUT_OF_MEMORY;
+	}
+	strcpy(string, source->filename);
+	memcpy(newzip->ecd.raw, source->ecd.raw, source->ecd.rawlength + 1);
+	newzip->ecd.comment = (const char *)(newzip->ecd.raw + ZIPECOM);
+	memcpy(newzip->cd, source->cd, source->ecd.cd_size);
+	memcpy(newzip->crc_index, source->crc_index, indexsize * sizeof(newzip->crc_index[0]));
+
+	/* undo the filename termination of the source's current header in our copy */
+	if (source->header.raw != NULL)
+		newzip->cd[source->header.raw - source->cd + ZIPCFN + source->header.filename_length] = source->header.saved;
+
+	*zip = newzip;
+	return ZIPERR_NONE;
+}
+
+
 /*-------------------------------------------------
     free_zip_file - free all the data for a
     zip_file
@@ -425,6 +551,8 @@ static void free_zip_file(zip_file *zip)
 			free(zip->ecd.raw);
 		if (zip->cd != NULL)
 			free(zip->cd);
+		if (zip->crc_index != NULL)
+			free(zip->crc_index);
 		free(zip);
 	}
 }
@@ -508,6 +636,56 @@ static zip_error read_ecd(zip_file *zip)
 }
 
 
+/*-------------------------------------------------
+    build_crc_index - hash the central directory
+    entries by CRC
+-------------------------------------------------*/
+
+static zip_error build_crc_index(zip_file *zip)
+{
+	UINT32 *heads, *links, *offsets;
+	UINT32 pos, entry;
+
+	/* count the entries */
+	zip->entries = 0;
+	for (pos = 0; pos + ZIPCFN <= zip->ecd.cd_size; zip->entries++)
+	{
+		UINT32 rawlength = ZIPCFN + read_word(zip->cd + pos + ZIPCFNL) + read_word(zip->cd + pos + ZIPCXTL) + read_word(zip->cd + pos + ZIPCCML);
+		if (pos + rawlength > zip->ecd.cd_size)
+			break;
+		pos += rawlength;
+	}
+
+	/* size the hash table to the next power of 2 */
+	for (zip->crc_buckets = 1; zip->crc_buckets < zip->entries; zip->crc_buckets <<= 1) ;
+
+	/* allocate the heads, links and offsets in one block */
+	zip->crc_index = (UINT32 *)malloc((zip->crc_buckets + 2 * zip->entries) * sizeof(zip->crc_index[0]));
+	if (zip->crc_index == NULL)
+		return ZIPERR_OUT_OF_MEMORY;
+	heads = zip->crc_index;
+	links = heads + zip->crc_buckets;
+	offsets = links + zip->entries;
+	memset(heads, 0, zip->crc_buckets * sizeof(heads[0]));
+
+	/* record where each entry lives */
+	for (pos = 0, entry = 0; entry < zip->entries; entry++)
+	{
+		offsets[entry] = pos;
+		pos += ZIPCFN + read_word(zip->cd + pos + ZIPCFNL) + read_word(zip->cd + pos + ZIPCXTL) + read_word(zip->cd + pos + ZIPCCML);
+	}
+
+	/* link them in backwards so that each chain is in directory order */
+	for (entry = zip->entries; entry > 0; entry--)
+	{
+		UINT32 bucket = read_dword(zip->cd + offsets[entry - 1] + ZIPCCRC) & (zip->crc_buckets - 1);
+		links[entry - 1] = heads[bucket];
+		heads[bucket] = entry;
+	}
+	return ZIPERR_NONE;
+}
+
+
 /*-------------------------------------------------
     get_compressed_data_offset - return the
     offset of the compressed data
@@ -132,6 +132,12 @@ struct _zip_file
 
 	UINT8 *			cd;						/* central directory raw data */
 	UINT32			cd_pos;					/* position in central directory */
+	UINT32			entries;				/* number of entries in the central directory */
+	UINT32 *		crc_index;				/* CRC hash heads, chain links and directory offsets */
+	UINT32			crc_buckets;			/* number of CRC hash buckets (power of 2) */
+	UINT32			crc_pos;				/* next entry in the current CRC chain (1-based) */
+	UINT32			crc_target;				/* CRC being searched for */
+	zip_file *		next_open;				/* next open ZIP file */
 	zip_file_header	header;					/* current file header */
 
 	UINT8			buffer[ZIP_DECOMPRESS_BUFSIZE];	/* buffer for decompression */
@@ -164,7 +170,13 @@ const zip_file_header *zip_file_first_file(zip_file *zip);
 /* find the next file in the ZIP */
 const zip_file_header *zip_file_next_file(zip_file *zip);
 
-/* decompress the most recently found file in the ZIP */
+/* find the first file in the ZIP with the given CRC */
+const zip_file_header *zip_file_first_crc(zip_file *zip, UINT32 crc);
+
+/* find the next file in the ZIP with the same CRC */
+const zip_file_header *zip_file_next_crc(zip_file *zip);
+
+/* decompress the most recently found file in the ZIP; separate handles may do this concurrently */
 zip_error zip_file_decompress(zip_file *zip, void *buffer, UINT32 length);
 
 
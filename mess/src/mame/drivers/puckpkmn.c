@@ -135,8 +135,8 @@ static ADDRESS_MAP_START( puckpkmn_map, AS_PROGRAM, 16 )
 	AM_RANGE(0x700018, 0x700019) AM_READ_PORT("DSW2")
 	AM_RANGE(0x700022, 0x700023) AM_DEVREADWRITE8_MODERN("oki", okim6295_device, read, write, 0x00ff)
 	AM_RANGE(0xa04000, 0xa04003) AM_DEVREADWRITE8("ymsnd", megadriv_68k_YM2612_read, megadriv_68k_YM2612_write, 0xffff)
-	AM_RANGE(0xc00000, 0xc0001f) AM_READWRITE(megadriv_vdp_r, megadriv_vdp_w)
-	AM_RANGE(0xe00000, 0xe0ffff) AM_RAM AM_MIRROR(0x1f0000) AM_BASE(&megadrive_ram)
+	AM_RANGE(0xc00000, 0xc0001f) AM_DEVREADWRITE("gen_vdp", megadriv_vdp_r, megadriv_vdp_w)
+	AM_RANGE(0xe00000, 0xe0ffff) AM_RAM AM_MIRROR(0x1f0000) AM_BASE_MEMBER(md_base_state, m_megadrive_ram)
 
 	/* Unknown reads/writes: */
 	AM_RANGE(0xa00000, 0xa00551) AM_WRITENOP							/* ? */
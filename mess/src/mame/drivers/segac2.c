@@ -110,7 +110,7 @@ static MACHINE_START( segac2 )
 static MACHINE_RESET( segac2 )
 {
 	segac2_state *state = machine.driver_data<segac2_state>();
-	megadrive_ram = reinterpret_cast<UINT16 *>(memory_get_shared(machine, "nvram"));
+	state->m_megadrive_ram = reinterpret_cast<UINT16 *>(memory_get_shared(machine, "nvram"));
 
 	/* set up interrupts and such */
 	MACHINE_RESET_CALL(megadriv);
@@ -198,8 +198,10 @@ static READ16_HANDLER( palette_r )
 static WRITE16_HANDLER( palette_w )
 {
 	segac2_state *state = space->machine().driver_data<segac2_state>();
+	sega_genesis_vdp_device *vdp = space->machine().device<sega_genesis_vdp_device>("gen_vdp");
 	int r, g, b, newword;
 	int tmpr, tmpg, tmpb;
+	UINT16 shadow, highlight;
 
 	/* adjust for the palette bank */
 	offset &= 0x1ff;
@@ -207,6 +209,9 @@ static WRITE16_HANDLER( palette_w )
 		offset = ((offset << 1) & 0x100) | ((offset << 2) & 0x80) | ((~offset >> 2) & 0x40) | ((offset >> 1) & 0x20) | (offset & 0x1f);
 	offset += state->m_palbank * 0x200;
 
+	/* the VDP renderer reads the lookup tables written below */
+	vdp->sync_render();
+
 	/* combine data */
 	COMBINE_DATA(&state->m_paletteram[offset]);
 	newword = state->m_paletteram[offset];
@@ -219,19 +224,18 @@ static WRITE16_HANDLER( palette_w )
 	/* set the color */
 	palette_set_color_rgb(space->machine(), offset, pal5bit(r), pal5bit(g), pal5bit(b));
 
-	megadrive_vdp_palette_lookup[offset] = (b) | (g << 5) | (r << 10);
-	megadrive_vdp_palette_lookup_sprite[offset] = (b) | (g << 5) | (r << 10);
-
 	tmpr = r >> 1;
 	tmpg = g >> 1;
 	tmpb = b >> 1;
-	megadrive_vdp_palette_lookup_shadow[offset] = (tmpb) | (tmpg << 5) | (tmpr << 10);
+	shadow = (tmpb) | (tmpg << 5) | (tmpr << 10);
 
 	// how is it calculated on c2?
 	tmpr = tmpr | 0x10;
 	tmpg = tmpg | 0x10;
 	tmpb = tmpb | 0x10;
-	megadrive_vdp_palette_lookup_highlight[offset] = (tmpb) | (tmpg << 5) | (tmpr << 10);
+	highlight = (tmpb) | (tmpg << 5) | (tmpr << 10);
+
+	vdp->set_palette_lookup(offset, (b) | (g << 5) | (r << 10), shadow, highlight);
 }
 
 
@@ -268,8 +272,11 @@ static WRITE16_HANDLER( palette_w )
 static void recompute_palette_tables( running_machine &machine )
 {
 	segac2_state *state = machine.driver_data<segac2_state>();
+	sega_genesis_vdp_device *vdp = machine.device<sega_genesis_vdp_device>("gen_vdp");
 	int i;
 
+	vdp->sync_render();
+
 	for (i = 0; i < 4; i++)
 	{
 		int bgpal = 0x000 + state->m_bg_palbase * 0x40 + i * 0x10;
@@ -277,13 +284,13 @@ static void recompute_palette_tables( running_machine &machine )
 
 		if (!state->m_segac2_alt_palette_mode)
 		{
-			segac2_bg_pal_lookup[i] = 0x200 * state->m_palbank + bgpal;
-			segac2_sp_pal_lookup[i] = 0x200 * state->m_palbank + sppal;
+			vdp->set_segac2_pal_lookup(i, 0x200 * state->m_palbank + bgpal,
+			                              0x200 * state->m_palbank + sppal);
 		}
 		else
 		{
-			segac2_bg_pal_lookup[i] = 0x200 * state->m_palbank + ((bgpal << 1) & 0x180) + ((~bgpal >> 2) & 0x40) + (bgpal & 0x30);
-			segac2_sp_pal_lookup[i] = 0x200 * state->m_palbank + ((~sppal << 2) & 0x100) + ((sppal << 2) & 0x80) + ((~sppal >> 2) & 0x40) + ((sppal >> 2) & 0x20) + (sppal & 0x10);
+			vdp->set_segac2_pal_lookup(i, 0x200 * state->m_palbank + ((bgpal << 1) & 0x180) + ((~bgpal >> 2) & 0x40) + (bgpal & 0x30),
+			                              0x200 * state->m_palbank + ((~sppal << 2) & 0x100) + ((sppal << 2) & 0x80) + ((~sppal >> 2) & 0x40) + ((sppal >> 2) & 0x20) + (sppal & 0x10));
 		}
 	}
 
@@ -610,7 +617,7 @@ static ADDRESS_MAP_START( main_map, AS_PROGRAM, 16 )
 	AM_RANGE(0x840100, 0x840107) AM_MIRROR(0x13fef8) AM_DEVREADWRITE8("ymsnd", ym3438_r, ym3438_w, 0x00ff)
 	AM_RANGE(0x880100, 0x880101) AM_MIRROR(0x13fefe) AM_WRITE(counter_timer_w)
 	AM_RANGE(0x8c0000, 0x8c0fff) AM_MIRROR(0x13f000) AM_READWRITE(palette_r, palette_w) AM_BASE_MEMBER(segac2_state, m_paletteram)
-	AM_RANGE(0xc00000, 0xc0001f) AM_MIRROR(0x18ff00) AM_READWRITE(megadriv_vdp_r, megadriv_vdp_w)
+	AM_RANGE(0xc00000, 0xc0001f) AM_MIRROR(0x18ff00) AM_DEVREADWRITE("gen_vdp", megadriv_vdp_r, megadriv_vdp_w)
 	AM_RANGE(0xe00000, 0xe0ffff) AM_MIRROR(0x1f0000) AM_RAM AM_SHARE("nvram")
 ADDRESS_MAP_END
 
@@ -1319,11 +1326,6 @@ static const ym3438_interface ym3438_intf =
 static VIDEO_START(segac2_new)
 {
 	VIDEO_START_CALL(megadriv);
-
-	megadrive_vdp_palette_lookup = auto_alloc_array(machine, UINT16, 0x1000/2);
-	megadrive_vdp_palette_lookup_sprite = auto_alloc_array(machine, UINT16, 0x1000/2);
-	megadrive_vdp_palette_lookup_shadow = auto_alloc_array(machine, UINT16, 0x1000/2);
-	megadrive_vdp_palette_lookup_highlight = auto_alloc_array(machine, UINT16, 0x1000/2);
 }
 
 static SCREEN_UPDATE(segac2_new)
@@ -1825,7 +1827,7 @@ static void segac2_common_init(running_machine& machine, int (*func)(int in))
 
 	state->m_prot_func = func;
 
-	genvdp_use_cram = 0;
+	machine.device<sega_genesis_vdp_device>("gen_vdp")->set_use_cram(0);
 	genesis_always_irq6 = 1;
 	genesis_other_hacks = 0;
 
@@ -38,15 +38,14 @@ MACHINE_CONFIG_EXTERN( md_bootleg );	// for topshoot.c & hshavoc.c
 
 extern UINT16* megadriv_backupram;
 extern int megadriv_backupram_length;
-extern UINT16* megadrive_ram;
 
 extern UINT8 megatech_bios_port_cc_dc_r(running_machine &machine, int offset, int ctrl);
-extern void megadriv_stop_scanline_timer(void);
+extern void megadriv_stop_scanline_timer(running_machine &machine);
 
 void megatech_set_megadrive_z80_as_megadrive_z80(running_machine &machine, const char* tag);
 
-extern READ16_HANDLER( megadriv_vdp_r );
-extern WRITE16_HANDLER( megadriv_vdp_w );
+extern READ16_DEVICE_HANDLER( megadriv_vdp_r );
+extern WRITE16_DEVICE_HANDLER( megadriv_vdp_w );
 
 /* These handlers are needed by megaplay.c */
 extern READ16_HANDLER( megadriv_68k_io_read );
@@ -69,16 +68,6 @@ VIDEO_START( megadriv );
 SCREEN_UPDATE( megadriv );
 SCREEN_EOF( megadriv );
 
-
-extern UINT16* megadrive_vdp_palette_lookup;
-extern UINT16* megadrive_vdp_palette_lookup_sprite; // for C2
-extern UINT16* megadrive_vdp_palette_lookup_shadow;
-extern UINT16* megadrive_vdp_palette_lookup_highlight;
-
-extern int segac2_bg_pal_lookup[4];
-extern int segac2_sp_pal_lookup[4];
-
-extern int genvdp_use_cram;
 extern int genesis_always_irq6;
 extern int genesis_other_hacks;
 
@@ -86,6 +75,157 @@ extern int megadrive_6buttons_pad;
 extern int megadrive_region_export;
 extern int megadrive_region_pal;
 
+/* Genesis VDP; its state and its timers live in the device rather than in file-scope statics */
+
+#define MCFG_SEGA_GEN_VDP_ADD(_tag) \
+	MCFG_DEVICE_ADD(_tag, SEGA_GEN_VDP, 0)
+
+class sega_genesis_vdp_device : public device_t
+{
+public:
+	sega_genesis_vdp_device(const machine_config &mconfig, const char *tag, device_t *owner, UINT32 clock);
+
+	// CPU-facing ports
+	void data_port_w(int data);
+	void ctrl_port_w(int data);
+	UINT16 data_port_r();
+	UINT16 ctrl_port_r();
+	UINT16 read_hv_counters();
+	UINT16 get_hposition();
+
+	// getters
+	int vblank_flag() const { return m_vblank_flag; }
+	int framerate() const { return m_framerate; }
+	int total_scanlines() const { return m_total_scanlines; }
+
+	// configuration, from the driver
+	void set_use_cram(int use_cram) { m_use_cram = use_cram; }
+	void set_framerate(int framerate) { m_framerate = framerate; }
+	void set_palette_lookup(int offset, UINT16 normal, UINT16 shadow, UINT16 highlight);
+	void set_segac2_pal_lookup(int index, int bgpal, int sppal);
+
+	// frame/scanline sequencing, driven by the device's timers
+	void reset_timing(bool reset_scanline_counter);
+	void stop_scanline_timer();
+	void handle_render_timer();
+	void handle_scanline_timer();
+	void handle_irq6_timer();
+	void handle_eof();
+	void irq_acknowledge(int irqline);
+
+	// video
+	void video_start();
+	void screen_update(bitmap_t *bitmap, const rectangle *cliprect);
+
+	// joins any scanlines still being rendered on the worker
+	void sync_render();
+
+protected:
+	virtual machine_config_constructor device_mconfig_additions() const;
+	virtual void device_start();
+	virtual void device_stop();
+
+private:
+	// reads 68k memory for DMA transfers
+	UINT16 (*m_get_word_from_68k_mem)(running_machine &machine, UINT32 source);
+
+	// timing details
+	int m_framerate;
+	int m_total_scanlines;
+	int m_visible_scanlines;
+	int m_irq6_scanline;
+	int m_z80irq_scanline;
+	int m_scanline_counter;
+	int m_max_hposition;
+	int m_irq4counter;
+
+	// interrupt and status flags
+	int m_imode;
+	int m_imode_odd_frame;
+	int m_vblank_flag;
+	int m_irq6_pending;
+	int m_irq4_pending;
+	int m_sprite_collision;
+
+	// command and address latches
+	int m_vdp_command_pending; // 2nd half of command pending..
+	UINT16 m_vdp_command_part1;
+	UINT16 m_vdp_command_part2;
+	UINT8 m_vdp_code;
+	UINT16 m_vdp_address;
+	UINT16 m_vdp_register[0x20];
+	UINT8 m_vram_fill_pending;
+	UINT16 m_vram_fill_length;
+
+	// memories
+	UINT16 *m_vdp_vram;
+	UINT16 *m_vdp_cram;
+	UINT16 *m_vdp_vsram;
+	/* The VDP keeps a 0x400 byte on-chip cache of the Sprite Attribute Table
+       to speed up processing */
+	UINT16 *m_internal_sprite_attribute_table;
+
+	// rendering
+	int m_use_cram; // c2 uses it's own palette ram
+	UINT8 *m_sprite_renderline;
+	UINT8 *m_highpri_renderline;
+	UINT32 *m_video_renderline;
+	bitmap_t *m_render_bitmap;
+	UINT16 *m_palette_lookup;
+	UINT16 *m_palette_lookup_sprite; // for C2
+	UINT16 *m_palette_lookup_shadow;
+	UINT16 *m_palette_lookup_highlight;
+	int m_segac2_bg_pal_lookup[4];
+	int m_segac2_sp_pal_lookup[4];
+
+	// our timers
+	timer_device *m_frame_timer;
+	timer_device *m_scanline_timer;
+	timer_device *m_render_timer;
+	timer_device *m_irq6_on_timer;
+	timer_device *m_irq4_on_timer;
+
+	// a scanline handed off to the render worker
+	struct render_job
+	{
+		sega_genesis_vdp_device *	m_vdp;
+		int							m_scanline;
+	};
+
+	static void *render_line_callback(void *param, int threadid);
+	void render_barrier();
+
+	// deferred rendering state
+	osd_work_queue *m_render_queue;			// single-worker queue, so lines complete in order
+	render_job		m_render_jobs[512];		// one slot per visible line, reused each frame
+	int				m_render_pending;		// lines queued since the last join
+	int				m_render_deferred;		// nonzero if this frame renders on the worker
+	int				m_raster_writes;		// VDP writes seen during active display this frame
+
+	void vdp_vram_write(UINT16 data);
+	void vdp_vsram_write(UINT16 data);
+	void write_cram_value(int offset, int data);
+	void vdp_cram_write(UINT16 data);
+	void set_register(int regnum, UINT8 value);
+	void update_code_and_address();
+	void insta_vram_copy(UINT32 source, UINT16 length);
+	void insta_68k_to_vram_dma(UINT32 source, int length);
+	void insta_68k_to_cram_dma(UINT32 source, UINT16 length);
+	void insta_68k_to_vsram_dma(UINT32 source, UINT16 length);
+	void handle_dma_bits();
+	UINT16 vdp_vram_r();
+	UINT16 vdp_vsram_r();
+	UINT16 vdp_cram_r();
+
+	void render_spriteline_to_spritebuffer(int scanline);
+	void render_videoline_to_videobuffer(int scanline);
+	void render_videobuffer_to_screenbuffer(int scanline);
+	void render_scanline(int scanline);
+};
+
+extern const device_type SEGA_GEN_VDP;
+
+
 /* Megaplay - Megatech specific */
 /* It might be possible to move the following structs in the drivers */
 
@@ -97,6 +237,8 @@ class md_base_state : public driver_device
 public:
 	md_base_state(const machine_config &mconfig, device_type type, const char *tag)
 	: driver_device(mconfig, type, tag) { }
+
+	UINT16 *m_megadrive_ram;
 };
 
 class md_boot_state : public md_base_state
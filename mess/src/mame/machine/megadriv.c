@@ -274,23 +274,20 @@ a tilemap-like structure, from which data is copied)
 #include "machine/nvram.h"
 
 
-#define MEGADRIV_VDP_VRAM(address) megadrive_vdp_vram[(address)&0x7fff]
+#define MEGADRIV_VDP_VRAM(address) m_vdp_vram[(address)&0x7fff]
 
 #define HAZE_MD 0 // to make appear / disappear the Region DipSwitch
 
-/* timing details */
-static int megadriv_framerate;
-static int megadrive_total_scanlines;
-static int megadrive_visible_scanlines;
-static int megadrive_irq6_scanline;
-//int megadrive_irq6_hpos = 320;
-static int megadrive_z80irq_scanline;
-//int megadrive_z80irq_hpos = 320;
-static int megadrive_imode = 0;
-static int megadrive_imode_odd_frame = 0;
-static int megadrive_vblank_flag = 0;
-static int megadrive_irq6_pending = 0;
-static int megadrive_irq4_pending = 0;
+/* visible scanlines are rendered on a worker thread and joined before anything
+   the renderer reads changes; a frame with more VDP writes than this during
+   active display (raster effects) is followed by one rendered inline */
+#define MEGADRIVE_DEFERRED_RENDER 1
+#define MEGADRIVE_RASTER_WRITE_LIMIT 32
+
+INLINE sega_genesis_vdp_device *megadrive_vdp(running_machine &machine)
+{
+	return machine.device<sega_genesis_vdp_device>("gen_vdp");
+}
 
 /* 32x! */
 static cpu_device *_32x_master_cpu;
@@ -354,38 +351,13 @@ static cpu_device *_svp_cpu;
 
 static cpu_device *_genesis_snd_z80_cpu;
 
-int segac2_bg_pal_lookup[4];
-int segac2_sp_pal_lookup[4];
-
 // hacks for C2
-int genvdp_use_cram = 0; // c2 uses it's own palette ram
 int genesis_always_irq6 = 0; // c2 never enables the irq6, different source??
 int genesis_other_hacks = 0; // misc hacks
 
-INLINE UINT16 get_hposition(void);
-
-static UINT8* sprite_renderline;
-static UINT8* highpri_renderline;
-static UINT32* video_renderline;
-UINT16* megadrive_vdp_palette_lookup;
-UINT16* megadrive_vdp_palette_lookup_sprite; // for C2
-UINT16* megadrive_vdp_palette_lookup_shadow;
-UINT16* megadrive_vdp_palette_lookup_highlight;
-UINT16* megadrive_ram;
-static UINT8 megadrive_vram_fill_pending = 0;
-static UINT16 megadrive_vram_fill_length = 0;
-static int genesis_scanline_counter = 0;
-static int megadrive_sprite_collision = 0;
-static int megadrive_max_hposition;
 int megadrive_region_export;
 int megadrive_region_pal;
 
-
-static timer_device* frame_timer;
-static timer_device* scanline_timer;
-static timer_device* irq6_on_timer;
-static timer_device* irq4_on_timer;
-static bitmap_t* render_bitmap;
 //emu_timer* vblankirq_off_timer;
 
 /* Sega CD stuff */
@@ -458,20 +430,6 @@ static WRITE16_HANDLER( megadriv_68k_req_z80_reset );
 
 
 
-
-static int megadrive_vdp_command_pending; // 2nd half of command pending..
-static UINT16 megadrive_vdp_command_part1;
-static UINT16 megadrive_vdp_command_part2;
-static UINT8  megadrive_vdp_code;
-static UINT16 megadrive_vdp_address;
-static UINT16 megadrive_vdp_register[0x20];
-static UINT16* megadrive_vdp_vram;
-static UINT16* megadrive_vdp_cram;
-static UINT16* megadrive_vdp_vsram;
-/* The VDP keeps a 0x400 byte on-chip cache of the Sprite Attribute Table
-   to speed up processing */
-static UINT16* megadrive_vdp_internal_sprite_attribute_table;
-
 /*
 
  $00 - Mode Set Register No. 1
@@ -488,13 +446,13 @@ static UINT16* megadrive_vdp_internal_sprite_attribute_table;
 
  */
 
-#define MEGADRIVE_REG0_UNUSED          ((megadrive_vdp_register[0x00]&0xc0)>>6)
-#define MEGADRIVE_REG0_BLANK_LEFT      ((megadrive_vdp_register[0x00]&0x20)>>5) // like SMS, not used by any commercial games?
-#define MEGADRIVE_REG0_IRQ4_ENABLE     ((megadrive_vdp_register[0x00]&0x10)>>4)
-#define MEGADRIVE_REG0_INVALID_MODE    ((megadrive_vdp_register[0x00]&0x08)>>3) // invalid display mode, unhandled
-#define MEGADRIVE_REG0_SPECIAL_PAL     ((megadrive_vdp_register[0x00]&0x04)>>2) // strange palette mode, unhandled
-#define MEGADRIVE_REG0_HVLATCH_ENABLE  ((megadrive_vdp_register[0x00]&0x02)>>1) // HV Latch, used by lightgun games
-#define MEGADRIVE_REG0_DISPLAY_DISABLE ((megadrive_vdp_register[0x00]&0x01)>>0)
+#define MEGADRIVE_REG0_UNUSED          ((m_vdp_register[0x00]&0xc0)>>6)
+#define MEGADRIVE_REG0_BLANK_LEFT      ((m_vdp_register[0x00]&0x20)>>5) // like SMS, not used by any commercial games?
+#define MEGADRIVE_REG0_IRQ4_ENABLE     ((m_vdp_register[0x00]&0x10)>>4)
+#define MEGADRIVE_REG0_INVALID_MODE    ((m_vdp_register[0x00]&0x08)>>3) // invalid display mode, unhandled
+#define MEGADRIVE_REG0_SPECIAL_PAL     ((m_vdp_register[0x00]&0x04)>>2) // strange palette mode, unhandled
+#define MEGADRIVE_REG0_HVLATCH_ENABLE  ((m_vdp_register[0x00]&0x02)>>1) // HV Latch, used by lightgun games
+#define MEGADRIVE_REG0_DISPLAY_DISABLE ((m_vdp_register[0x00]&0x01)>>0)
 
 /*
 
@@ -512,85 +470,85 @@ static UINT16* megadrive_vdp_internal_sprite_attribute_table;
 
 */
 
-#define MEGADRIVE_REG01_TMS9918_SELECT  ((megadrive_vdp_register[0x01]&0x80)>>7)
-#define MEGADRIVE_REG01_DISP_ENABLE     ((megadrive_vdp_register[0x01]&0x40)>>6)
-#define MEGADRIVE_REG01_IRQ6_ENABLE     ((megadrive_vdp_register[0x01]&0x20)>>5)
-#define MEGADRIVE_REG01_DMA_ENABLE      ((megadrive_vdp_register[0x01]&0x10)>>4)
-#define MEGADRIVE_REG01_240_LINE        ((megadrive_vdp_register[0x01]&0x08)>>3)
-#define MEGADRIVE_REG01_SMS_SELECT      ((megadrive_vdp_register[0x01]&0x04)>>2)
-#define MEGADRIVE_REG01_UNUSED          ((megadrive_vdp_register[0x01]&0x02)>>1)
-#define MEGADRIVE_REG01_STRANGE_VIDEO   ((megadrive_vdp_register[0x01]&0x01)>>0) // unhandled, does strange things to the display
+#define MEGADRIVE_REG01_TMS9918_SELECT  ((m_vdp_register[0x01]&0x80)>>7)
+#define MEGADRIVE_REG01_DISP_ENABLE     ((m_vdp_register[0x01]&0x40)>>6)
+#define MEGADRIVE_REG01_IRQ6_ENABLE     ((m_vdp_register[0x01]&0x20)>>5)
+#define MEGADRIVE_REG01_DMA_ENABLE      ((m_vdp_register[0x01]&0x10)>>4)
+#define MEGADRIVE_REG01_240_LINE        ((m_vdp_register[0x01]&0x08)>>3)
+#define MEGADRIVE_REG01_SMS_SELECT      ((m_vdp_register[0x01]&0x04)>>2)
+#define MEGADRIVE_REG01_UNUSED          ((m_vdp_register[0x01]&0x02)>>1)
+#define MEGADRIVE_REG01_STRANGE_VIDEO   ((m_vdp_register[0x01]&0x01)>>0) // unhandled, does strange things to the display
 
-#define MEGADRIVE_REG02_UNUSED1         ((megadrive_vdp_register[0x02]&0xc0)>>6)
-#define MEGADRIVE_REG02_PATTERN_ADDR_A  ((megadrive_vdp_register[0x02]&0x38)>>3)
-#define MEGADRIVE_REG02_UNUSED2         ((megadrive_vdp_register[0x02]&0x07)>>0)
+#define MEGADRIVE_REG02_UNUSED1         ((m_vdp_register[0x02]&0xc0)>>6)
+#define MEGADRIVE_REG02_PATTERN_ADDR_A  ((m_vdp_register[0x02]&0x38)>>3)
+#define MEGADRIVE_REG02_UNUSED2         ((m_vdp_register[0x02]&0x07)>>0)
 
-#define MEGADRIVE_REG03_UNUSED1         ((megadrive_vdp_register[0x03]&0xc0)>>6)
-#define MEGADRIVE_REG03_PATTERN_ADDR_W  ((megadrive_vdp_register[0x03]&0x3e)>>1)
-#define MEGADRIVE_REG03_UNUSED2         ((megadrive_vdp_register[0x03]&0x01)>>0)
+#define MEGADRIVE_REG03_UNUSED1         ((m_vdp_register[0x03]&0xc0)>>6)
+#define MEGADRIVE_REG03_PATTERN_ADDR_W  ((m_vdp_register[0x03]&0x3e)>>1)
+#define MEGADRIVE_REG03_UNUSED2         ((m_vdp_register[0x03]&0x01)>>0)
 
-#define MEGADRIVE_REG04_UNUSED          ((megadrive_vdp_register[0x04]&0xf8)>>3)
-#define MEGADRIVE_REG04_PATTERN_ADDR_B  ((megadrive_vdp_register[0x04]&0x07)>>0)
+#define MEGADRIVE_REG04_UNUSED          ((m_vdp_register[0x04]&0xf8)>>3)
+#define MEGADRIVE_REG04_PATTERN_ADDR_B  ((m_vdp_register[0x04]&0x07)>>0)
 
-#define MEGADRIVE_REG05_UNUSED          ((megadrive_vdp_register[0x05]&0x80)>>7)
-#define MEGADRIVE_REG05_SPRITE_ADDR     ((megadrive_vdp_register[0x05]&0x7f)>>0)
+#define MEGADRIVE_REG05_UNUSED          ((m_vdp_register[0x05]&0x80)>>7)
+#define MEGADRIVE_REG05_SPRITE_ADDR     ((m_vdp_register[0x05]&0x7f)>>0)
 
 /* 6? */
 
-#define MEGADRIVE_REG07_UNUSED          ((megadrive_vdp_register[0x07]&0xc0)>>6)
-#define MEGADRIVE_REG07_BGCOLOUR        ((megadrive_vdp_register[0x07]&0x3f)>>0)
+#define MEGADRIVE_REG07_UNUSED          ((m_vdp_register[0x07]&0xc0)>>6)
+#define MEGADRIVE_REG07_BGCOLOUR        ((m_vdp_register[0x07]&0x3f)>>0)
 
 /* 8? */
 /* 9? */
 
-#define MEGADRIVE_REG0A_HINT_VALUE      ((megadrive_vdp_register[0x0a]&0xff)>>0)
+#define MEGADRIVE_REG0A_HINT_VALUE      ((m_vdp_register[0x0a]&0xff)>>0)
 
-#define MEGADRIVE_REG0B_UNUSED          ((megadrive_vdp_register[0x0b]&0xf0)>>4)
-#define MEGADRIVE_REG0B_IRQ2_ENABLE     ((megadrive_vdp_register[0x0b]&0x08)>>3)
-#define MEGADRIVE_REG0B_VSCROLL_MODE    ((megadrive_vdp_register[0x0b]&0x04)>>2)
-#define MEGADRIVE_REG0B_HSCROLL_MODE    ((megadrive_vdp_register[0x0b]&0x03)>>0)
+#define MEGADRIVE_REG0B_UNUSED          ((m_vdp_register[0x0b]&0xf0)>>4)
+#define MEGADRIVE_REG0B_IRQ2_ENABLE     ((m_vdp_register[0x0b]&0x08)>>3)
+#define MEGADRIVE_REG0B_VSCROLL_MODE    ((m_vdp_register[0x0b]&0x04)>>2)
+#define MEGADRIVE_REG0B_HSCROLL_MODE    ((m_vdp_register[0x0b]&0x03)>>0)
 
-#define MEGADRIVE_REG0C_RS0             ((megadrive_vdp_register[0x0c]&0x80)>>7)
-#define MEGADRIVE_REG0C_UNUSED1         ((megadrive_vdp_register[0x0c]&0x40)>>6)
-#define MEGADRIVE_REG0C_SPECIAL         ((megadrive_vdp_register[0x0c]&0x20)>>5)
-#define MEGADRIVE_REG0C_UNUSED2         ((megadrive_vdp_register[0x0c]&0x10)>>4)
-#define MEGADRIVE_REG0C_SHADOW_HIGLIGHT ((megadrive_vdp_register[0x0c]&0x08)>>3)
-#define MEGADRIVE_REG0C_INTERLEAVE      ((megadrive_vdp_register[0x0c]&0x06)>>1)
-#define MEGADRIVE_REG0C_RS1             ((megadrive_vdp_register[0x0c]&0x01)>>0)
+#define MEGADRIVE_REG0C_RS0             ((m_vdp_register[0x0c]&0x80)>>7)
+#define MEGADRIVE_REG0C_UNUSED1         ((m_vdp_register[0x0c]&0x40)>>6)
+#define MEGADRIVE_REG0C_SPECIAL         ((m_vdp_register[0x0c]&0x20)>>5)
+#define MEGADRIVE_REG0C_UNUSED2         ((m_vdp_register[0x0c]&0x10)>>4)
+#define MEGADRIVE_REG0C_SHADOW_HIGLIGHT ((m_vdp_register[0x0c]&0x08)>>3)
+#define MEGADRIVE_REG0C_INTERLEAVE      ((m_vdp_register[0x0c]&0x06)>>1)
+#define MEGADRIVE_REG0C_RS1             ((m_vdp_register[0x0c]&0x01)>>0)
 
-#define MEGADRIVE_REG0D_UNUSED          ((megadrive_vdp_register[0x0d]&0xc0)>>6)
-#define MEGADRIVE_REG0D_HSCROLL_ADDR    ((megadrive_vdp_register[0x0d]&0x3f)>>0)
+#define MEGADRIVE_REG0D_UNUSED          ((m_vdp_register[0x0d]&0xc0)>>6)
+#define MEGADRIVE_REG0D_HSCROLL_ADDR    ((m_vdp_register[0x0d]&0x3f)>>0)
 
 /* e? */
 
-#define MEGADRIVE_REG0F_AUTO_INC        ((megadrive_vdp_register[0x0f]&0xff)>>0)
+#define MEGADRIVE_REG0F_AUTO_INC        ((m_vdp_register[0x0f]&0xff)>>0)
 
-#define MEGADRIVE_REG10_UNUSED1        ((megadrive_vdp_register[0x10]&0xc0)>>6)
-#define MEGADRIVE_REG10_VSCROLL_SIZE   ((megadrive_vdp_register[0x10]&0x30)>>4)
-#define MEGADRIVE_REG10_UNUSED2        ((megadrive_vdp_register[0x10]&0x0c)>>2)
-#define MEGADRIVE_REG10_HSCROLL_SIZE   ((megadrive_vdp_register[0x10]&0x03)>>0)
+#define MEGADRIVE_REG10_UNUSED1        ((m_vdp_register[0x10]&0xc0)>>6)
+#define MEGADRIVE_REG10_VSCROLL_SIZE   ((m_vdp_register[0x10]&0x30)>>4)
+#define MEGADRIVE_REG10_UNUSED2        ((m_vdp_register[0x10]&0x0c)>>2)
+#define MEGADRIVE_REG10_HSCROLL_SIZE   ((m_vdp_register[0x10]&0x03)>>0)
 
-#define MEGADRIVE_REG11_WINDOW_RIGHT   ((megadrive_vdp_register[0x11]&0x80)>>7)
-#define MEGADRIVE_REG11_UNUSED         ((megadrive_vdp_register[0x11]&0x60)>>5)
-#define MEGADRIVE_REG11_WINDOW_HPOS      ((megadrive_vdp_register[0x11]&0x1f)>>0)
+#define MEGADRIVE_REG11_WINDOW_RIGHT   ((m_vdp_register[0x11]&0x80)>>7)
+#define MEGADRIVE_REG11_UNUSED         ((m_vdp_register[0x11]&0x60)>>5)
+#define MEGADRIVE_REG11_WINDOW_HPOS      ((m_vdp_register[0x11]&0x1f)>>0)
 
-#define MEGADRIVE_REG12_WINDOW_DOWN    ((megadrive_vdp_register[0x12]&0x80)>>7)
-#define MEGADRIVE_REG12_UNUSED         ((megadrive_vdp_register[0x12]&0x60)>>5)
-#define MEGADRIVE_REG12_WINDOW_VPOS      ((megadrive_vdp_register[0x12]&0x1f)>>0)
+#define MEGADRIVE_REG12_WINDOW_DOWN    ((m_vdp_register[0x12]&0x80)>>7)
+#define MEGADRIVE_REG12_UNUSED         ((m_vdp_register[0x12]&0x60)>>5)
+#define MEGADRIVE_REG12_WINDOW_VPOS      ((m_vdp_register[0x12]&0x1f)>>0)
 
-#define MEGADRIVE_REG13_DMALENGTH1     ((megadrive_vdp_register[0x13]&0xff)>>0)
+#define MEGADRIVE_REG13_DMALENGTH1     ((m_vdp_register[0x13]&0xff)>>0)
 
-#define MEGADRIVE_REG14_DMALENGTH2      ((megadrive_vdp_register[0x14]&0xff)>>0)
+#define MEGADRIVE_REG14_DMALENGTH2      ((m_vdp_register[0x14]&0xff)>>0)
 
-#define MEGADRIVE_REG15_DMASOURCE1      ((megadrive_vdp_register[0x15]&0xff)>>0)
-#define MEGADRIVE_REG16_DMASOURCE2      ((megadrive_vdp_register[0x16]&0xff)>>0)
+#define MEGADRIVE_REG15_DMASOURCE1      ((m_vdp_register[0x15]&0xff)>>0)
+#define MEGADRIVE_REG16_DMASOURCE2      ((m_vdp_register[0x16]&0xff)>>0)
 
-#define MEGADRIVE_REG17_DMASOURCE3      ((megadrive_vdp_register[0x17]&0xff)>>0)
-#define MEGADRIVE_REG17_DMATYPE         ((megadrive_vdp_register[0x17]&0xc0)>>6)
-#define MEGADRIVE_REG17_UNUSED          ((megadrive_vdp_register[0x17]&0x3f)>>0)
+#define MEGADRIVE_REG17_DMASOURCE3      ((m_vdp_register[0x17]&0xff)>>0)
+#define MEGADRIVE_REG17_DMATYPE         ((m_vdp_register[0x17]&0xc0)>>6)
+#define MEGADRIVE_REG17_UNUSED          ((m_vdp_register[0x17]&0x3f)>>0)
 
 
-static void vdp_vram_write(UINT16 data)
+void sega_genesis_vdp_device::vdp_vram_write(UINT16 data)
 {
 
 	UINT16 sprite_base_address = MEGADRIVE_REG0C_RS1?((MEGADRIVE_REG05_SPRITE_ADDR&0x7e)<<9):((MEGADRIVE_REG05_SPRITE_ADDR&0x7f)<<9);
@@ -598,72 +556,73 @@ static void vdp_vram_write(UINT16 data)
 	int lowlimit = sprite_base_address;
 	int highlimit = sprite_base_address+spritetable_size;
 
-	if (megadrive_vdp_address&1)
+	if (m_vdp_address&1)
 	{
 		data = ((data&0x00ff)<<8)|((data&0xff00)>>8);
 	}
 
-	MEGADRIV_VDP_VRAM(megadrive_vdp_address>>1) = data;
+	MEGADRIV_VDP_VRAM(m_vdp_address>>1) = data;
 
 	/* The VDP stores an Internal copy of any data written to the Sprite Attribute Table.
        This data is _NOT_ invalidated when the Sprite Base Address changes, thus allowing
        for some funky effects, as used by Castlevania Bloodlines Stage 6-3 */
-	if (megadrive_vdp_address>=lowlimit && megadrive_vdp_address<highlimit)
+	if (m_vdp_address>=lowlimit && m_vdp_address<highlimit)
 	{
-//      mame_printf_debug("spritebase is %04x-%04x vram address is %04x, write %04x\n",lowlimit, highlimit-1, megadrive_vdp_address, data);
-		megadrive_vdp_internal_sprite_attribute_table[(megadrive_vdp_address&(spritetable_size-1))>>1] = data;
+//      mame_printf_debug("spritebase is %04x-%04x vram address is %04x, write %04x\n",lowlimit, highlimit-1, m_vdp_address, data);
+		m_internal_sprite_attribute_table[(m_vdp_address&(spritetable_size-1))>>1] = data;
 	}
 
-	megadrive_vdp_address+=MEGADRIVE_REG0F_AUTO_INC;
-	megadrive_vdp_address &= 0xffff;
+	m_vdp_address+=MEGADRIVE_REG0F_AUTO_INC;
+	m_vdp_address &= 0xffff;
 }
 
-static void vdp_vsram_write(UINT16 data)
+void sega_genesis_vdp_device::vdp_vsram_write(UINT16 data)
 {
-	megadrive_vdp_vsram[(megadrive_vdp_address&0x7e)>>1] = data;
+	m_vdp_vsram[(m_vdp_address&0x7e)>>1] = data;
 
-	//logerror("Wrote to VSRAM addr %04x data %04x\n",megadrive_vdp_address&0xfffe,megadrive_vdp_vsram[megadrive_vdp_address>>1]);
+	//logerror("Wrote to VSRAM addr %04x data %04x\n",m_vdp_address&0xfffe,m_vdp_vsram[m_vdp_address>>1]);
 
-	megadrive_vdp_address+=MEGADRIVE_REG0F_AUTO_INC;
+	m_vdp_address+=MEGADRIVE_REG0F_AUTO_INC;
 
-	megadrive_vdp_address &=0xffff;
+	m_vdp_address &=0xffff;
 }
 
-static void write_cram_value(running_machine &machine, int offset, int data)
+void sega_genesis_vdp_device::write_cram_value(int offset, int data)
 {
-	megadrive_vdp_cram[offset] = data;
+	m_vdp_cram[offset] = data;
 
-	//logerror("Wrote to CRAM addr %04x data %04x\n",megadrive_vdp_address&0xfffe,megadrive_vdp_cram[megadrive_vdp_address>>1]);
-	if (genvdp_use_cram)
+	//logerror("Wrote to CRAM addr %04x data %04x\n",m_vdp_address&0xfffe,m_vdp_cram[m_vdp_address>>1]);
+	if (m_use_cram)
 	{
 		int r,g,b;
 		r = ((data >> 1)&0x07);
 		g = ((data >> 5)&0x07);
 		b = ((data >> 9)&0x07);
-		palette_set_color_rgb(machine,offset,pal3bit(r),pal3bit(g),pal3bit(b));
-		megadrive_vdp_palette_lookup[offset] = (b<<2) | (g<<7) | (r<<12);
-		megadrive_vdp_palette_lookup_sprite[offset] = (b<<2) | (g<<7) | (r<<12);
-		megadrive_vdp_palette_lookup_shadow[offset] = (b<<1) | (g<<6) | (r<<11);
-		megadrive_vdp_palette_lookup_highlight[offset] = ((b|0x08)<<1) | ((g|0x08)<<6) | ((r|0x08)<<11);
+		palette_set_color_rgb(machine(),offset,pal3bit(r),pal3bit(g),pal3bit(b));
+		m_palette_lookup[offset] = (b<<2) | (g<<7) | (r<<12);
+		m_palette_lookup_sprite[offset] = (b<<2) | (g<<7) | (r<<12);
+		m_palette_lookup_shadow[offset] = (b<<1) | (g<<6) | (r<<11);
+		m_palette_lookup_highlight[offset] = ((b|0x08)<<1) | ((g|0x08)<<6) | ((r|0x08)<<11);
 	}
 }
 
-static void vdp_cram_write(running_machine &machine, UINT16 data)
+void sega_genesis_vdp_device::vdp_cram_write(UINT16 data)
 {
 	int offset;
-	offset = (megadrive_vdp_address&0x7e)>>1;
+	offset = (m_vdp_address&0x7e)>>1;
 
-	write_cram_value(machine, offset,data);
+	write_cram_value(offset,data);
 
-	megadrive_vdp_address+=MEGADRIVE_REG0F_AUTO_INC;
+	m_vdp_address+=MEGADRIVE_REG0F_AUTO_INC;
 
-	megadrive_vdp_address &=0xffff;
+	m_vdp_address &=0xffff;
 }
 
 
-static void megadriv_vdp_data_port_w(running_machine &machine, int data)
+void sega_genesis_vdp_device::data_port_w(int data)
 {
-	megadrive_vdp_command_pending = 0;
+	render_barrier();
+	m_vdp_command_pending = 0;
 
  /*
  0000b : VRAM read
@@ -673,53 +632,53 @@ static void megadriv_vdp_data_port_w(running_machine &machine, int data)
  0101b : VSRAM write
  1000b : CRAM read
  */
-//  logerror("write to vdp data port %04x with code %04x, write address %04x\n",data, megadrive_vdp_code, megadrive_vdp_address );
+//  logerror("write to vdp data port %04x with code %04x, write address %04x\n",data, m_vdp_code, m_vdp_address );
 
-	if (megadrive_vram_fill_pending)
+	if (m_vram_fill_pending)
 	{
 		int count;
 
-		megadrive_vdp_address&=0xffff;
+		m_vdp_address&=0xffff;
 
-		if (megadrive_vdp_address&1)
+		if (m_vdp_address&1)
 		{
-			MEGADRIV_VDP_VRAM((megadrive_vdp_address>>1))   = (MEGADRIV_VDP_VRAM((megadrive_vdp_address>>1))&0xff00) | (data&0x00ff);
+			MEGADRIV_VDP_VRAM((m_vdp_address>>1))   = (MEGADRIV_VDP_VRAM((m_vdp_address>>1))&0xff00) | (data&0x00ff);
 		}
 		else
 		{
-			MEGADRIV_VDP_VRAM((megadrive_vdp_address>>1))   = (MEGADRIV_VDP_VRAM((megadrive_vdp_address>>1))&0x00ff) | ((data&0x00ff)<<8);
+			MEGADRIV_VDP_VRAM((m_vdp_address>>1))   = (MEGADRIV_VDP_VRAM((m_vdp_address>>1))&0x00ff) | ((data&0x00ff)<<8);
 		}
 
 
-		for (count=0;count<=megadrive_vram_fill_length;count++) // <= for james pond 3
+		for (count=0;count<=m_vram_fill_length;count++) // <= for james pond 3
 		{
-			if (megadrive_vdp_address&1)
+			if (m_vdp_address&1)
 			{
-				MEGADRIV_VDP_VRAM((megadrive_vdp_address>>1))   = (MEGADRIV_VDP_VRAM((megadrive_vdp_address>>1))&0x00ff) | (data&0xff00);
+				MEGADRIV_VDP_VRAM((m_vdp_address>>1))   = (MEGADRIV_VDP_VRAM((m_vdp_address>>1))&0x00ff) | (data&0xff00);
 			}
 			else
 			{
-				MEGADRIV_VDP_VRAM((megadrive_vdp_address>>1))   = (MEGADRIV_VDP_VRAM((megadrive_vdp_address>>1))&0xff00) | ((data&0xff00)>>8);
+				MEGADRIV_VDP_VRAM((m_vdp_address>>1))   = (MEGADRIV_VDP_VRAM((m_vdp_address>>1))&0xff00) | ((data&0xff00)>>8);
 			}
 
-			megadrive_vdp_address+=MEGADRIVE_REG0F_AUTO_INC;
-			megadrive_vdp_address&=0xffff;
+			m_vdp_address+=MEGADRIVE_REG0F_AUTO_INC;
+			m_vdp_address&=0xffff;
 
 		}
 
-		megadrive_vdp_register[0x13] = 0;
-		megadrive_vdp_register[0x14] = 0;
+		m_vdp_register[0x13] = 0;
+		m_vdp_register[0x14] = 0;
 
-	//  megadrive_vdp_register[0x15] = (source>>1) & 0xff;
-	//  megadrive_vdp_register[0x16] = (source>>9) & 0xff;
-	//  megadrive_vdp_register[0x17] = (source>>17) & 0xff;
+	//  m_vdp_register[0x15] = (source>>1) & 0xff;
+	//  m_vdp_register[0x16] = (source>>9) & 0xff;
+	//  m_vdp_register[0x17] = (source>>17) & 0xff;
 
 
 	}
 	else
 	{
 
-		switch (megadrive_vdp_code & 0x000f)
+		switch (m_vdp_code & 0x000f)
 		{
 			case 0x0000:
 				logerror("Attempting to WRITE to DATA PORT in VRAM READ MODE\n");
@@ -730,7 +689,7 @@ static void megadriv_vdp_data_port_w(running_machine &machine, int data)
 				break;
 
 			case 0x0003:
-				vdp_cram_write(machine, data);
+				vdp_cram_write(data);
 				break;
 
 			case 0x0004:
@@ -746,7 +705,7 @@ static void megadriv_vdp_data_port_w(running_machine &machine, int data)
 				break;
 
 			default:
-				logerror("Attempting to WRITE to DATA PORT in #UNDEFINED# MODE %1x %04x\n",megadrive_vdp_code&0xf, data);
+				logerror("Attempting to WRITE to DATA PORT in #UNDEFINED# MODE %1x %04x\n",m_vdp_code&0xf, data);
 				break;
 		}
 	}
@@ -757,9 +716,9 @@ static void megadriv_vdp_data_port_w(running_machine &machine, int data)
 
 
 
-static void megadrive_vdp_set_register(running_machine &machine, int regnum, UINT8 value)
+void sega_genesis_vdp_device::set_register(int regnum, UINT8 value)
 {
-	megadrive_vdp_register[regnum] = value;
+	m_vdp_register[regnum] = value;
 
 	/* We need special handling for the IRQ enable registers, some games turn
        off the irqs before they are taken, delaying them until the IRQ is turned
@@ -769,55 +728,53 @@ static void megadrive_vdp_set_register(running_machine &machine, int regnum, UIN
 	{
 	//mame_printf_debug("setting reg 0, irq enable is now %d\n",MEGADRIVE_REG0_IRQ4_ENABLE);
 
-		if (megadrive_irq4_pending)
+		if (m_irq4_pending)
 		{
 			if (MEGADRIVE_REG0_IRQ4_ENABLE)
-				cputag_set_input_line(machine, "maincpu", 4, HOLD_LINE);
+				cputag_set_input_line(machine(), "maincpu", 4, HOLD_LINE);
 			else
-				cputag_set_input_line(machine, "maincpu", 4, CLEAR_LINE);
+				cputag_set_input_line(machine(), "maincpu", 4, CLEAR_LINE);
 		}
 
 		/* ??? Fatal Rewind needs this but I'm not sure it's accurate behavior
            it causes flickering in roadrash */
-	//  megadrive_irq6_pending = 0;
-	//  megadrive_irq4_pending = 0;
+	//  m_irq6_pending = 0;
+	//  m_irq4_pending = 0;
 
 	}
 
 	if (regnum == 0x01)
 	{
-		if (megadrive_irq6_pending)
+		if (m_irq6_pending)
 		{
 			if (MEGADRIVE_REG01_IRQ6_ENABLE )
-				cputag_set_input_line(machine, "maincpu", 6, HOLD_LINE);
+				cputag_set_input_line(machine(), "maincpu", 6, HOLD_LINE);
 			else
-				cputag_set_input_line(machine, "maincpu", 6, CLEAR_LINE);
+				cputag_set_input_line(machine(), "maincpu", 6, CLEAR_LINE);
 		}
 
 		/* ??? */
-	//  megadrive_irq6_pending = 0;
-	//  megadrive_irq4_pending = 0;
+	//  m_irq6_pending = 0;
+	//  m_irq4_pending = 0;
 
 	}
 
 
 //  if (regnum == 0x0a)
-//      mame_printf_debug("Set HINT Reload Register to %d on scanline %d\n",value, genesis_scanline_counter);
+//      mame_printf_debug("Set HINT Reload Register to %d on scanline %d\n",value, m_scanline_counter);
 
-//  mame_printf_debug("%s: Setting VDP Register #%02x to %02x\n",machine.describe_context(), regnum,value);
+//  mame_printf_debug("%s: Setting VDP Register #%02x to %02x\n",machine().describe_context(), regnum,value);
 }
 
-static void update_megadrive_vdp_code_and_address(void)
+void sega_genesis_vdp_device::update_code_and_address()
 {
-	megadrive_vdp_code = ((megadrive_vdp_command_part1 & 0xc000) >> 14) |
-	                     ((megadrive_vdp_command_part2 & 0x00f0) >> 2);
+	m_vdp_code = ((m_vdp_command_part1 & 0xc000) >> 14) |
+	                     ((m_vdp_command_part2 & 0x00f0) >> 2);
 
-	megadrive_vdp_address = ((megadrive_vdp_command_part1 & 0x3fff) >> 0) |
-                            ((megadrive_vdp_command_part2 & 0x0003) << 14);
+	m_vdp_address = ((m_vdp_command_part1 & 0x3fff) >> 0) |
+                            ((m_vdp_command_part2 & 0x0003) << 14);
 }
 
-static UINT16 (*vdp_get_word_from_68k_mem)(running_machine &machine, UINT32 source);
-
 static UINT16 vdp_get_word_from_68k_mem_default(running_machine &machine, UINT32 source)
 {
 	// should we limit the valid areas here?
@@ -881,7 +838,7 @@ static UINT16 vdp_get_word_from_68k_mem_default(running_machine &machine, UINT32
    as the 68k address bus isn't accessed */
 
 /* Wani Wani World, James Pond 3, Pirates Gold! */
-static void megadrive_do_insta_vram_copy(UINT32 source, UINT16 length)
+void sega_genesis_vdp_device::insta_vram_copy(UINT32 source, UINT16 length)
 {
 	int x;
 
@@ -889,54 +846,54 @@ static void megadrive_do_insta_vram_copy(UINT32 source, UINT16 length)
 	{
 		UINT8 source_byte;
 
-		//mame_printf_debug("vram copy length %04x source %04x dest %04x\n",length, source, megadrive_vdp_address );
+		//mame_printf_debug("vram copy length %04x source %04x dest %04x\n",length, source, m_vdp_address );
 		if (source&1) source_byte = MEGADRIV_VDP_VRAM((source&0xffff)>>1)&0x00ff;
 		else  source_byte = (MEGADRIV_VDP_VRAM((source&0xffff)>>1)&0xff00)>>8;
 
-		if (megadrive_vdp_address&1)
+		if (m_vdp_address&1)
 		{
-			MEGADRIV_VDP_VRAM((megadrive_vdp_address&0xffff)>>1) = (MEGADRIV_VDP_VRAM((megadrive_vdp_address&0xffff)>>1)&0xff00) | source_byte;
+			MEGADRIV_VDP_VRAM((m_vdp_address&0xffff)>>1) = (MEGADRIV_VDP_VRAM((m_vdp_address&0xffff)>>1)&0xff00) | source_byte;
 		}
 		else
 		{
-			MEGADRIV_VDP_VRAM((megadrive_vdp_address&0xffff)>>1) = (MEGADRIV_VDP_VRAM((megadrive_vdp_address&0xffff)>>1)&0x00ff) | (source_byte<<8);
+			MEGADRIV_VDP_VRAM((m_vdp_address&0xffff)>>1) = (MEGADRIV_VDP_VRAM((m_vdp_address&0xffff)>>1)&0x00ff) | (source_byte<<8);
 		}
 
 		source++;
-		megadrive_vdp_address+=MEGADRIVE_REG0F_AUTO_INC;
-		megadrive_vdp_address&=0xffff;
+		m_vdp_address+=MEGADRIVE_REG0F_AUTO_INC;
+		m_vdp_address&=0xffff;
 	}
 }
 
 /* Instant, but we pause the 68k a bit */
-static void megadrive_do_insta_68k_to_vram_dma(running_machine &machine, UINT32 source,int length)
+void sega_genesis_vdp_device::insta_68k_to_vram_dma(UINT32 source, int length)
 {
 	int count;
 
 	if (length==0x00) length = 0xffff;
 
 	/* This is a hack until real DMA timings are implemented */
-	device_spin_until_time(machine.device("maincpu"), attotime::from_nsec(length * 1000 / 3500));
+	device_spin_until_time(machine().device("maincpu"), attotime::from_nsec(length * 1000 / 3500));
 
 	for (count = 0;count<(length>>1);count++)
 	{
-		vdp_vram_write(vdp_get_word_from_68k_mem(machine, source));
+		vdp_vram_write(m_get_word_from_68k_mem(machine(), source));
 		source+=2;
 		if (source>0xffffff) source = 0xe00000;
 	}
 
-	megadrive_vdp_address&=0xffff;
+	m_vdp_address&=0xffff;
 
-	megadrive_vdp_register[0x13] = 0;
-	megadrive_vdp_register[0x14] = 0;
+	m_vdp_register[0x13] = 0;
+	m_vdp_register[0x14] = 0;
 
-	megadrive_vdp_register[0x15] = (source>>1) & 0xff;
-	megadrive_vdp_register[0x16] = (source>>9) & 0xff;
-	megadrive_vdp_register[0x17] = (source>>17) & 0xff;
+	m_vdp_register[0x15] = (source>>1) & 0xff;
+	m_vdp_register[0x16] = (source>>9) & 0xff;
+	m_vdp_register[0x17] = (source>>17) & 0xff;
 }
 
 
-static void megadrive_do_insta_68k_to_cram_dma(running_machine &machine,UINT32 source,UINT16 length)
+void sega_genesis_vdp_device::insta_68k_to_cram_dma(UINT32 source, UINT16 length)
 {
 	int count;
 
@@ -944,27 +901,27 @@ static void megadrive_do_insta_68k_to_cram_dma(running_machine &machine,UINT32 s
 
 	for (count = 0;count<(length>>1);count++)
 	{
-		//if (megadrive_vdp_address>=0x80) return; // abandon
+		//if (m_vdp_address>=0x80) return; // abandon
 
-		write_cram_value(machine, (megadrive_vdp_address&0x7e)>>1, vdp_get_word_from_68k_mem(machine, source));
+		write_cram_value((m_vdp_address&0x7e)>>1, m_get_word_from_68k_mem(machine(), source));
 		source+=2;
 
 		if (source>0xffffff) source = 0xfe0000;
 
-		megadrive_vdp_address+=MEGADRIVE_REG0F_AUTO_INC;
-		megadrive_vdp_address&=0xffff;
+		m_vdp_address+=MEGADRIVE_REG0F_AUTO_INC;
+		m_vdp_address&=0xffff;
 	}
 
-	megadrive_vdp_register[0x13] = 0;
-	megadrive_vdp_register[0x14] = 0;
+	m_vdp_register[0x13] = 0;
+	m_vdp_register[0x14] = 0;
 
-	megadrive_vdp_register[0x15] = (source>>1) & 0xff;
-	megadrive_vdp_register[0x16] = (source>>9) & 0xff;
-	megadrive_vdp_register[0x17] = (source>>17) & 0xff;
+	m_vdp_register[0x15] = (source>>1) & 0xff;
+	m_vdp_register[0x16] = (source>>9) & 0xff;
+	m_vdp_register[0x17] = (source>>17) & 0xff;
 
 }
 
-static void megadrive_do_insta_68k_to_vsram_dma(running_machine &machine,UINT32 source,UINT16 length)
+void sega_genesis_vdp_device::insta_68k_to_vsram_dma(UINT32 source, UINT16 length)
 {
 	int count;
 
@@ -972,43 +929,43 @@ static void megadrive_do_insta_68k_to_vsram_dma(running_machine &machine,UINT32
 
 	for (count = 0;count<(length>>1);count++)
 	{
-		if (megadrive_vdp_address>=0x80) return; // abandon
+		if (m_vdp_address>=0x80) return; // abandon
 
-		megadrive_vdp_vsram[(megadrive_vdp_address&0x7e)>>1] = vdp_get_word_from_68k_mem(machine, source);
+		m_vdp_vsram[(m_vdp_address&0x7e)>>1] = m_get_word_from_68k_mem(machine(), source);
 		source+=2;
 
 		if (source>0xffffff) source = 0xfe0000;
 
-		megadrive_vdp_address+=MEGADRIVE_REG0F_AUTO_INC;
-		megadrive_vdp_address&=0xffff;
+		m_vdp_address+=MEGADRIVE_REG0F_AUTO_INC;
+		m_vdp_address&=0xffff;
 	}
 
-	megadrive_vdp_register[0x13] = 0;
-	megadrive_vdp_register[0x14] = 0;
+	m_vdp_register[0x13] = 0;
+	m_vdp_register[0x14] = 0;
 
-	megadrive_vdp_register[0x15] = (source>>1) & 0xff;
-	megadrive_vdp_register[0x16] = (source>>9) & 0xff;
-	megadrive_vdp_register[0x17] = (source>>17) & 0xff;
+	m_vdp_register[0x15] = (source>>1) & 0xff;
+	m_vdp_register[0x16] = (source>>9) & 0xff;
+	m_vdp_register[0x17] = (source>>17) & 0xff;
 }
 
 /* This can be simplified quite a lot.. */
-static void handle_dma_bits(running_machine &machine)
+void sega_genesis_vdp_device::handle_dma_bits()
 {
 #if 0
-	if (megadrive_vdp_code&0x20)
+	if (m_vdp_code&0x20)
 	{
 		UINT32 source;
 		UINT16 length;
 		source = (MEGADRIVE_REG15_DMASOURCE1 | (MEGADRIVE_REG16_DMASOURCE2<<8) | ((MEGADRIVE_REG17_DMASOURCE3&0xff)<<16))<<1;
 		length = (MEGADRIVE_REG13_DMALENGTH1 | (MEGADRIVE_REG14_DMALENGTH2<<8))<<1;
-		mame_printf_debug("%s 68k DMAtran set source %06x length %04x dest %04x enabled %01x code %02x %02x\n", machine.describe_context(), source, length, megadrive_vdp_address,MEGADRIVE_REG01_DMA_ENABLE, megadrive_vdp_code,MEGADRIVE_REG0F_AUTO_INC);
+		mame_printf_debug("%s 68k DMAtran set source %06x length %04x dest %04x enabled %01x code %02x %02x\n", machine().describe_context(), source, length, m_vdp_address,MEGADRIVE_REG01_DMA_ENABLE, m_vdp_code,MEGADRIVE_REG0F_AUTO_INC);
 	}
 #endif
-	if (megadrive_vdp_code==0x20)
+	if (m_vdp_code==0x20)
 	{
 		mame_printf_debug("DMA bit set 0x20 but invalid??\n");
 	}
-	else if (megadrive_vdp_code==0x21 || megadrive_vdp_code==0x31) /* 0x31 used by tecmo cup */
+	else if (m_vdp_code==0x21 || m_vdp_code==0x31) /* 0x31 used by tecmo cup */
 	{
 		if (MEGADRIVE_REG17_DMATYPE==0x0 || MEGADRIVE_REG17_DMATYPE==0x1)
 		{
@@ -1018,8 +975,8 @@ static void handle_dma_bits(running_machine &machine)
 			length = (MEGADRIVE_REG13_DMALENGTH1 | (MEGADRIVE_REG14_DMALENGTH2<<8))<<1;
 
 			/* The 68k is frozen during this transfer, it should be safe to throw a few cycles away and do 'instant' DMA because the 68k can't detect it being in progress (can the z80?) */
-			//mame_printf_debug("68k->VRAM DMA transfer source %06x length %04x dest %04x enabled %01x\n", source, length, megadrive_vdp_address,MEGADRIVE_REG01_DMA_ENABLE);
-			if (MEGADRIVE_REG01_DMA_ENABLE) megadrive_do_insta_68k_to_vram_dma(machine,source,length);
+			//mame_printf_debug("68k->VRAM DMA transfer source %06x length %04x dest %04x enabled %01x\n", source, length, m_vdp_address,MEGADRIVE_REG01_DMA_ENABLE);
+			if (MEGADRIVE_REG01_DMA_ENABLE) insta_68k_to_vram_dma(source,length);
 
 		}
 		else if (MEGADRIVE_REG17_DMATYPE==0x2)
@@ -1027,8 +984,8 @@ static void handle_dma_bits(running_machine &machine)
 			//mame_printf_debug("vram fill length %02x %02x other regs! %02x %02x %02x(Mode Bits %02x) Enable %02x\n", MEGADRIVE_REG13_DMALENGTH1, MEGADRIVE_REG14_DMALENGTH2, MEGADRIVE_REG15_DMASOURCE1, MEGADRIVE_REG16_DMASOURCE2, MEGADRIVE_REG17_DMASOURCE3, MEGADRIVE_REG17_DMATYPE, MEGADRIVE_REG01_DMA_ENABLE);
 			if (MEGADRIVE_REG01_DMA_ENABLE)
 			{
-				megadrive_vram_fill_pending = 1;
-				megadrive_vram_fill_length = (MEGADRIVE_REG13_DMALENGTH1 | (MEGADRIVE_REG14_DMALENGTH2<<8));
+				m_vram_fill_pending = 1;
+				m_vram_fill_length = (MEGADRIVE_REG13_DMALENGTH1 | (MEGADRIVE_REG14_DMALENGTH2<<8));
 			}
 		}
 		else if (MEGADRIVE_REG17_DMATYPE==0x3)
@@ -1039,10 +996,10 @@ static void handle_dma_bits(running_machine &machine)
 			length = (MEGADRIVE_REG13_DMALENGTH1 | (MEGADRIVE_REG14_DMALENGTH2<<8)); // length in bytes
 			//mame_printf_debug("setting vram copy mode length registers are %02x %02x other regs! %02x %02x %02x(Mode Bits %02x) Enable %02x\n", MEGADRIVE_REG13_DMALENGTH1, MEGADRIVE_REG14_DMALENGTH2, MEGADRIVE_REG15_DMASOURCE1, MEGADRIVE_REG16_DMASOURCE2, MEGADRIVE_REG17_DMASOURCE3, MEGADRIVE_REG17_DMATYPE, MEGADRIVE_REG01_DMA_ENABLE);
 
-			if (MEGADRIVE_REG01_DMA_ENABLE) megadrive_do_insta_vram_copy(source, length);
+			if (MEGADRIVE_REG01_DMA_ENABLE) insta_vram_copy(source, length);
 		}
 	}
-	else if (megadrive_vdp_code==0x23)
+	else if (m_vdp_code==0x23)
 	{
 		if (MEGADRIVE_REG17_DMATYPE==0x0 || MEGADRIVE_REG17_DMATYPE==0x1)
 		{
@@ -1052,16 +1009,16 @@ static void handle_dma_bits(running_machine &machine)
 			length = (MEGADRIVE_REG13_DMALENGTH1 | (MEGADRIVE_REG14_DMALENGTH2<<8))<<1;
 
 			/* The 68k is frozen during this transfer, it should be safe to throw a few cycles away and do 'instant' DMA because the 68k can't detect it being in progress (can the z80?) */
-			//mame_printf_debug("68k->CRAM DMA transfer source %06x length %04x dest %04x enabled %01x\n", source, length, megadrive_vdp_address,MEGADRIVE_REG01_DMA_ENABLE);
-			if (MEGADRIVE_REG01_DMA_ENABLE) megadrive_do_insta_68k_to_cram_dma(machine,source,length);
+			//mame_printf_debug("68k->CRAM DMA transfer source %06x length %04x dest %04x enabled %01x\n", source, length, m_vdp_address,MEGADRIVE_REG01_DMA_ENABLE);
+			if (MEGADRIVE_REG01_DMA_ENABLE) insta_68k_to_cram_dma(source,length);
 		}
 		else if (MEGADRIVE_REG17_DMATYPE==0x2)
 		{
 			//mame_printf_debug("vram fill length %02x %02x other regs! %02x %02x %02x(Mode Bits %02x) Enable %02x\n", MEGADRIVE_REG13_DMALENGTH1, MEGADRIVE_REG14_DMALENGTH2, MEGADRIVE_REG15_DMASOURCE1, MEGADRIVE_REG16_DMASOURCE2, MEGADRIVE_REG17_DMASOURCE3, MEGADRIVE_REG17_DMATYPE, MEGADRIVE_REG01_DMA_ENABLE);
 			if (MEGADRIVE_REG01_DMA_ENABLE)
 			{
-				megadrive_vram_fill_pending = 1;
-				megadrive_vram_fill_length = (MEGADRIVE_REG13_DMALENGTH1 | (MEGADRIVE_REG14_DMALENGTH2<<8));
+				m_vram_fill_pending = 1;
+				m_vram_fill_length = (MEGADRIVE_REG13_DMALENGTH1 | (MEGADRIVE_REG14_DMALENGTH2<<8));
 			}
 		}
 		else if (MEGADRIVE_REG17_DMATYPE==0x3)
@@ -1069,7 +1026,7 @@ static void handle_dma_bits(running_machine &machine)
 			mame_printf_debug("setting vram copy (INVALID?) mode length registers are %02x %02x other regs! %02x %02x %02x(Mode Bits %02x) Enable %02x\n", MEGADRIVE_REG13_DMALENGTH1, MEGADRIVE_REG14_DMALENGTH2, MEGADRIVE_REG15_DMASOURCE1, MEGADRIVE_REG16_DMASOURCE2, MEGADRIVE_REG17_DMASOURCE3, MEGADRIVE_REG17_DMATYPE, MEGADRIVE_REG01_DMA_ENABLE);
 		}
 	}
-	else if (megadrive_vdp_code==0x25)
+	else if (m_vdp_code==0x25)
 	{
 		if (MEGADRIVE_REG17_DMATYPE==0x0 || MEGADRIVE_REG17_DMATYPE==0x1)
 		{
@@ -1079,16 +1036,16 @@ static void handle_dma_bits(running_machine &machine)
 			length = (MEGADRIVE_REG13_DMALENGTH1 | (MEGADRIVE_REG14_DMALENGTH2<<8))<<1;
 
 			/* The 68k is frozen during this transfer, it should be safe to throw a few cycles away and do 'instant' DMA because the 68k can't detect it being in progress (can the z80?) */
-			//mame_printf_debug("68k->VSRAM DMA transfer source %06x length %04x dest %04x enabled %01x\n", source, length, megadrive_vdp_address,MEGADRIVE_REG01_DMA_ENABLE);
-			if (MEGADRIVE_REG01_DMA_ENABLE) megadrive_do_insta_68k_to_vsram_dma(machine,source,length);
+			//mame_printf_debug("68k->VSRAM DMA transfer source %06x length %04x dest %04x enabled %01x\n", source, length, m_vdp_address,MEGADRIVE_REG01_DMA_ENABLE);
+			if (MEGADRIVE_REG01_DMA_ENABLE) insta_68k_to_vsram_dma(source,length);
 		}
 		else if (MEGADRIVE_REG17_DMATYPE==0x2)
 		{
 			//mame_printf_debug("vram fill length %02x %02x other regs! %02x %02x %02x(Mode Bits %02x) Enable %02x\n", MEGADRIVE_REG13_DMALENGTH1, MEGADRIVE_REG14_DMALENGTH2, MEGADRIVE_REG15_DMASOURCE1, MEGADRIVE_REG16_DMASOURCE2, MEGADRIVE_REG17_DMASOURCE3, MEGADRIVE_REG17_DMATYPE, MEGADRIVE_REG01_DMA_ENABLE);
 			if (MEGADRIVE_REG01_DMA_ENABLE)
 			{
-				megadrive_vram_fill_pending = 1;
-				megadrive_vram_fill_length = (MEGADRIVE_REG13_DMALENGTH1 | (MEGADRIVE_REG14_DMALENGTH2<<8));
+				m_vram_fill_pending = 1;
+				m_vram_fill_length = (MEGADRIVE_REG13_DMALENGTH1 | (MEGADRIVE_REG14_DMALENGTH2<<8));
 			}
 		}
 		else if (MEGADRIVE_REG17_DMATYPE==0x3)
@@ -1096,7 +1053,7 @@ static void handle_dma_bits(running_machine &machine)
 			mame_printf_debug("setting vram copy (INVALID?) mode length registers are %02x %02x other regs! %02x %02x %02x(Mode Bits %02x) Enable %02x\n", MEGADRIVE_REG13_DMALENGTH1, MEGADRIVE_REG14_DMALENGTH2, MEGADRIVE_REG15_DMASOURCE1, MEGADRIVE_REG16_DMASOURCE2, MEGADRIVE_REG17_DMASOURCE3, MEGADRIVE_REG17_DMATYPE, MEGADRIVE_REG01_DMA_ENABLE);
 		}
 	}
-	else if (megadrive_vdp_code==0x30)
+	else if (m_vdp_code==0x30)
 	{
 		if (MEGADRIVE_REG17_DMATYPE==0x0)
 		{
@@ -1118,26 +1075,27 @@ static void handle_dma_bits(running_machine &machine)
 			length = (MEGADRIVE_REG13_DMALENGTH1 | (MEGADRIVE_REG14_DMALENGTH2<<8)); // length in bytes
 			//mame_printf_debug("setting vram copy mode length registers are %02x %02x other regs! %02x %02x %02x(Mode Bits %02x) Enable %02x\n", MEGADRIVE_REG13_DMALENGTH1, MEGADRIVE_REG14_DMALENGTH2, MEGADRIVE_REG15_DMASOURCE1, MEGADRIVE_REG16_DMASOURCE2, MEGADRIVE_REG17_DMASOURCE3, MEGADRIVE_REG17_DMATYPE, MEGADRIVE_REG01_DMA_ENABLE);
 
-			if (MEGADRIVE_REG01_DMA_ENABLE) megadrive_do_insta_vram_copy(source, length);
+			if (MEGADRIVE_REG01_DMA_ENABLE) insta_vram_copy(source, length);
 		}
 	}
 }
 
-static void megadriv_vdp_ctrl_port_w(running_machine &machine, int data)
+void sega_genesis_vdp_device::ctrl_port_w(int data)
 {
 //  logerror("write to vdp control port %04x\n",data);
-	megadrive_vram_fill_pending = 0; // ??
+	render_barrier();
+	m_vram_fill_pending = 0; // ??
 
-	if (megadrive_vdp_command_pending)
+	if (m_vdp_command_pending)
 	{
 		/* 2nd part of 32-bit command */
-		megadrive_vdp_command_pending = 0;
-		megadrive_vdp_command_part2 = data;
+		m_vdp_command_pending = 0;
+		m_vdp_command_part2 = data;
 
-		update_megadrive_vdp_code_and_address();
-		handle_dma_bits(machine);
+		update_code_and_address();
+		handle_dma_bits();
 
-		//logerror("VDP Write Part 2 setting Code %02x Address %04x\n",megadrive_vdp_code, megadrive_vdp_address);
+		//logerror("VDP Write Part 2 setting Code %02x Address %04x\n",m_vdp_code, m_vdp_address);
 
 	}
 	else
@@ -1149,23 +1107,25 @@ static void megadriv_vdp_ctrl_port_w(running_machine &machine, int data)
 
 			if (regnum &0x20) mame_printf_debug("reg error\n");
 
-			megadrive_vdp_set_register(machine, regnum&0x1f,value);
-			megadrive_vdp_code = 0;
-			megadrive_vdp_address = 0;
+			set_register(regnum&0x1f,value);
+			m_vdp_code = 0;
+			m_vdp_address = 0;
 		}
 		else
 		{
-			megadrive_vdp_command_pending = 1;
-			megadrive_vdp_command_part1 = data;
-			update_megadrive_vdp_code_and_address();
-			//logerror("VDP Write Part 1 setting Code %02x Address %04x\n",megadrive_vdp_code, megadrive_vdp_address);
+			m_vdp_command_pending = 1;
+			m_vdp_command_part1 = data;
+			update_code_and_address();
+			//logerror("VDP Write Part 1 setting Code %02x Address %04x\n",m_vdp_code, m_vdp_address);
 		}
 
 	}
 }
 
-WRITE16_HANDLER( megadriv_vdp_w )
+WRITE16_DEVICE_HANDLER( megadriv_vdp_w )
 {
+	sega_genesis_vdp_device *vdp = downcast<sega_genesis_vdp_device *>(device);
+
 	switch (offset<<1)
 	{
 		case 0x00:
@@ -1180,13 +1140,13 @@ WRITE16_HANDLER( megadriv_vdp_w )
 				data = (data&0xff00) | data>>8;
 			//  mame_printf_debug("8-bit write VDP data port access, offset %04x data %04x mem_mask %04x\n",offset,data,mem_mask);
 			}
-			megadriv_vdp_data_port_w(space->machine(), data);
+			vdp->data_port_w(data);
 			break;
 
 		case 0x04:
 		case 0x06:
 			if ((!ACCESSING_BITS_8_15) || (!ACCESSING_BITS_0_7)) mame_printf_debug("8-bit write VDP control port access, offset %04x data %04x mem_mask %04x\n",offset,data,mem_mask);
-			megadriv_vdp_ctrl_port_w(space->machine(), data);
+			vdp->ctrl_port_w(data);
 			break;
 
 		case 0x08:
@@ -1200,8 +1160,8 @@ WRITE16_HANDLER( megadriv_vdp_w )
 		case 0x12:
 		case 0x14:
 		case 0x16:
-			if (ACCESSING_BITS_0_7) sn76496_w(space->machine().device("snsnd"), 0, data & 0xff);
-			//if (ACCESSING_BITS_8_15) sn76496_w(space->machine().device("snsnd"), 0, (data >>8) & 0xff);
+			if (ACCESSING_BITS_0_7) sn76496_w(device->machine().device("snsnd"), 0, data & 0xff);
+			//if (ACCESSING_BITS_8_15) sn76496_w(device->machine().device("snsnd"), 0, (data >>8) & 0xff);
 			break;
 
 		default:
@@ -1209,52 +1169,52 @@ WRITE16_HANDLER( megadriv_vdp_w )
 	}
 }
 
-static UINT16 vdp_vram_r(void)
+UINT16 sega_genesis_vdp_device::vdp_vram_r()
 {
-	return MEGADRIV_VDP_VRAM((megadrive_vdp_address&0xfffe)>>1);
+	return MEGADRIV_VDP_VRAM((m_vdp_address&0xfffe)>>1);
 }
 
-static UINT16 vdp_vsram_r(void)
+UINT16 sega_genesis_vdp_device::vdp_vsram_r()
 {
-	return megadrive_vdp_vsram[(megadrive_vdp_address&0x7e)>>1];
+	return m_vdp_vsram[(m_vdp_address&0x7e)>>1];
 }
 
-static UINT16 vdp_cram_r(void)
+UINT16 sega_genesis_vdp_device::vdp_cram_r()
 {
 
-	return megadrive_vdp_cram[(megadrive_vdp_address&0x7e)>>1];
+	return m_vdp_cram[(m_vdp_address&0x7e)>>1];
 }
 
-static UINT16 megadriv_vdp_data_port_r(running_machine &machine)
+UINT16 sega_genesis_vdp_device::data_port_r()
 {
 	UINT16 retdata=0;
 
-	//return machine.rand();
+	//return machine().rand();
 
-	megadrive_vdp_command_pending = 0;
+	m_vdp_command_pending = 0;
 
-	switch (megadrive_vdp_code & 0x000f)
+	switch (m_vdp_code & 0x000f)
 	{
 		case 0x0000:
 			retdata = vdp_vram_r();
-			megadrive_vdp_address+=MEGADRIVE_REG0F_AUTO_INC;
-			megadrive_vdp_address&=0xffff;
+			m_vdp_address+=MEGADRIVE_REG0F_AUTO_INC;
+			m_vdp_address&=0xffff;
 			break;
 
 		case 0x0001:
 			logerror("Attempting to READ from DATA PORT in VRAM WRITE MODE\n");
-			retdata = machine.rand();
+			retdata = machine().rand();
 			break;
 
 		case 0x0003:
 			logerror("Attempting to READ from DATA PORT in CRAM WRITE MODE\n");
-			retdata = machine.rand();
+			retdata = machine().rand();
 			break;
 
 		case 0x0004:
 			retdata = vdp_vsram_r();
-			megadrive_vdp_address+=MEGADRIVE_REG0F_AUTO_INC;
-			megadrive_vdp_address&=0xffff;
+			m_vdp_address+=MEGADRIVE_REG0F_AUTO_INC;
+			m_vdp_address&=0xffff;
 			break;
 
 		case 0x0005:
@@ -1263,17 +1223,17 @@ static UINT16 megadriv_vdp_data_port_r(running_machine &machine)
 
 		case 0x0008:
 			retdata = vdp_cram_r();
-			megadrive_vdp_address+=MEGADRIVE_REG0F_AUTO_INC;
-			megadrive_vdp_address&=0xffff;
+			m_vdp_address+=MEGADRIVE_REG0F_AUTO_INC;
+			m_vdp_address&=0xffff;
 			break;
 
 		default:
 			logerror("Attempting to READ from DATA PORT in #UNDEFINED# MODE\n");
-			retdata = machine.rand();
+			retdata = machine().rand();
 			break;
 	}
 
-//  mame_printf_debug("vdp_data_port_r %04x %04x %04x\n",megadrive_vdp_code, megadrive_vdp_address, retdata);
+//  mame_printf_debug("vdp_data_port_r %04x %04x %04x\n",m_vdp_code, m_vdp_address, retdata);
 
 //  logerror("Read VDP Data Port\n");
 	return retdata;
@@ -1342,8 +1302,11 @@ PAL, 256x224
 
 
 
-static UINT16 megadriv_vdp_ctrl_port_r(void)
+UINT16 sega_genesis_vdp_device::ctrl_port_r()
 {
+	/* the sprite collision flag is set by the renderer */
+	sync_render();
+
 	/* Battletoads is very fussy about the vblank flag
        it wants it to be 1. in scanline 224 */
 
@@ -1357,7 +1320,7 @@ static UINT16 megadriv_vdp_ctrl_port_r(void)
 	/* Megalo Mania also fussy - cares about pending flag*/
 
 	int megadrive_sprite_overflow = 0;
-	int megadrive_odd_frame = megadrive_imode_odd_frame^1;
+	int megadrive_odd_frame = m_imode_odd_frame^1;
 	int megadrive_hblank_flag = 0;
 	int megadrive_dma_active = 0;
 	int vblank;
@@ -1369,7 +1332,7 @@ static UINT16 megadriv_vdp_ctrl_port_r(void)
 	if (hpos>400) megadrive_hblank_flag = 1;
 	if (hpos>460) megadrive_hblank_flag = 0;
 
-	vblank = megadrive_vblank_flag;
+	vblank = m_vblank_flag;
 
 	/* extra case */
 	if (MEGADRIVE_REG01_DISP_ENABLE==0) vblank = 1;
@@ -1406,9 +1369,9 @@ static UINT16 megadriv_vdp_ctrl_port_r(void)
 	       (1<<10) | // ALWAYS 1
 	       (fifo_empty<<9 ) | // FIFO EMPTY
 	       (fifo_full<<8 ) | // FIFO FULL
-	       (megadrive_irq6_pending << 7) | // exmutants has a tight loop checking this ..
+	       (m_irq6_pending << 7) | // exmutants has a tight loop checking this ..
 	       (megadrive_sprite_overflow << 6) |
-	       (megadrive_sprite_collision << 5) |
+	       (m_sprite_collision << 5) |
 	       (megadrive_odd_frame << 4) |
 	       (vblank << 3) |
 	       (megadrive_hblank_flag << 2) |
@@ -1508,13 +1471,13 @@ static const UINT8 vc_pal_240[] =
 
 
 
-static UINT16 megadriv_read_hv_counters(void)
+UINT16 sega_genesis_vdp_device::read_hv_counters()
 {
 	/* Bubble and Squeek wants vcount=0xe0 */
 	/* Dracula is very sensitive to this */
 	/* Marvel Land is sensitive to this */
 
-	int vpos = genesis_scanline_counter;
+	int vpos = m_scanline_counter;
 	UINT16 hpos = get_hposition();
 
 //  if (hpos>424) vpos++; // fixes dracula, breaks road rash
@@ -1523,7 +1486,7 @@ static UINT16 megadriv_read_hv_counters(void)
 	/* shouldn't happen.. */
 	if (vpos<0)
 	{
-		vpos = megadrive_total_scanlines;
+		vpos = m_total_scanlines;
 		mame_printf_debug("negative vpos?!\n");
 	}
 
@@ -1531,11 +1494,11 @@ static UINT16 megadriv_read_hv_counters(void)
 	{
 		if (!megadrive_region_pal)
 		{
-			vpos = vc_ntsc_240[vpos%megadrive_total_scanlines];
+			vpos = vc_ntsc_240[vpos%m_total_scanlines];
 		}
 		else
 		{
-			vpos = vc_pal_240[vpos%megadrive_total_scanlines];
+			vpos = vc_pal_240[vpos%m_total_scanlines];
 		}
 
 	}
@@ -1543,11 +1506,11 @@ static UINT16 megadriv_read_hv_counters(void)
 	{
 		if (!megadrive_region_pal)
 		{
-			vpos = vc_ntsc_224[vpos%megadrive_total_scanlines];
+			vpos = vc_ntsc_224[vpos%m_total_scanlines];
 		}
 		else
 		{
-			vpos = vc_pal_224[vpos%megadrive_total_scanlines];
+			vpos = vc_pal_224[vpos%m_total_scanlines];
 		}
 	}
 
@@ -1557,8 +1520,9 @@ static UINT16 megadriv_read_hv_counters(void)
 
 }
 
-READ16_HANDLER( megadriv_vdp_r )
+READ16_DEVICE_HANDLER( megadriv_vdp_r )
 {
+	sega_genesis_vdp_device *vdp = downcast<sega_genesis_vdp_device *>(device);
 	UINT16 retvalue = 0;
 
 
@@ -1569,15 +1533,15 @@ READ16_HANDLER( megadriv_vdp_r )
 		case 0x00:
 		case 0x02:
 			if ((!ACCESSING_BITS_8_15) || (!ACCESSING_BITS_0_7)) mame_printf_debug("8-bit VDP read data port access, offset %04x mem_mask %04x\n",offset,mem_mask);
-			retvalue = megadriv_vdp_data_port_r(space->machine());
+			retvalue = vdp->data_port_r();
 			break;
 
 		case 0x04:
 		case 0x06:
 		//  if ((!ACCESSING_BITS_8_15) || (!ACCESSING_BITS_0_7)) mame_printf_debug("8-bit VDP read control port access, offset %04x mem_mask %04x\n",offset,mem_mask);
-			retvalue = megadriv_vdp_ctrl_port_r();
+			retvalue = vdp->ctrl_port_r();
 		//  retvalue = space->machine().rand();
-		//  mame_printf_debug("%06x: Read Control Port at scanline %d hpos %d (return %04x)\n",cpu_get_pc(&space->device()),genesis_scanline_counter, get_hposition(),retvalue);
+		//  mame_printf_debug("%06x: Read Control Port at scanline %d hpos %d (return %04x)\n",cpu_get_pc(&space->device()),m_scanline_counter, get_hposition(),retvalue);
 			break;
 
 		case 0x08:
@@ -1585,9 +1549,9 @@ READ16_HANDLER( megadriv_vdp_r )
 		case 0x0c:
 		case 0x0e:
 		//  if ((!ACCESSING_BITS_8_15) || (!ACCESSING_BITS_0_7)) mame_printf_debug("8-bit VDP read HV counter port access, offset %04x mem_mask %04x\n",offset,mem_mask);
-			retvalue = megadriv_read_hv_counters();
+			retvalue = vdp->read_hv_counters();
 		//  retvalue = space->machine().rand();
-		//  mame_printf_debug("%06x: Read HV counters at scanline %d hpos %d (return %04x)\n",cpu_get_pc(&space->device()),genesis_scanline_counter, get_hposition(),retvalue);
+		//  mame_printf_debug("%06x: Read HV counters at scanline %d hpos %d (return %04x)\n",cpu_get_pc(&space->device()),m_scanline_counter, get_hposition(),retvalue);
 			break;
 
 		case 0x10:
@@ -2086,14 +2050,14 @@ static ADDRESS_MAP_START( megadriv_map, AS_PROGRAM, 16 )
 	AM_RANGE(0xa11200, 0xa11201) AM_WRITE(megadriv_68k_req_z80_reset)
 
 	/* these are fake - remove allocs in VIDEO_START to use these to view ram instead */
-//  AM_RANGE(0xb00000, 0xb0ffff) AM_RAM AM_BASE(&megadrive_vdp_vram)
-//  AM_RANGE(0xb10000, 0xb1007f) AM_RAM AM_BASE(&megadrive_vdp_vsram)
-//  AM_RANGE(0xb10100, 0xb1017f) AM_RAM AM_BASE(&megadrive_vdp_cram)
+//  AM_RANGE(0xb00000, 0xb0ffff) AM_RAM AM_BASE(&m_vdp_vram)
+//  AM_RANGE(0xb10000, 0xb1007f) AM_RAM AM_BASE(&m_vdp_vsram)
+//  AM_RANGE(0xb10100, 0xb1017f) AM_RAM AM_BASE(&m_vdp_cram)
 
-	AM_RANGE(0xc00000, 0xc0001f) AM_READWRITE(megadriv_vdp_r,megadriv_vdp_w)
-	AM_RANGE(0xd00000, 0xd0001f) AM_READWRITE(megadriv_vdp_r,megadriv_vdp_w) // the earth defend
+	AM_RANGE(0xc00000, 0xc0001f) AM_DEVREADWRITE("gen_vdp", megadriv_vdp_r, megadriv_vdp_w)
+	AM_RANGE(0xd00000, 0xd0001f) AM_DEVREADWRITE("gen_vdp", megadriv_vdp_r, megadriv_vdp_w) // the earth defend
 
-	AM_RANGE(0xe00000, 0xe0ffff) AM_RAM AM_MIRROR(0x1f0000) AM_BASE(&megadrive_ram)
+	AM_RANGE(0xe00000, 0xe0ffff) AM_RAM AM_MIRROR(0x1f0000) AM_BASE_MEMBER(md_base_state, m_megadrive_ram)
 //  AM_RANGE(0xff0000, 0xffffff) AM_READONLY
 	/*       0xe00000 - 0xffffff) == MAIN RAM (64kb, Mirrored, most games use ff0000 - ffffff) */
 ADDRESS_MAP_END
@@ -2389,10 +2353,10 @@ static ADDRESS_MAP_START( md_bootleg_map, AS_PROGRAM, 16 )
 	AM_RANGE(0xa11100, 0xa11101) AM_READWRITE(megadriv_68k_check_z80_bus, megadriv_68k_req_z80_bus)
 	AM_RANGE(0xa11200, 0xa11201) AM_WRITE(megadriv_68k_req_z80_reset)
 
-	AM_RANGE(0xc00000, 0xc0001f) AM_READWRITE(megadriv_vdp_r, megadriv_vdp_w)
-	AM_RANGE(0xd00000, 0xd0001f) AM_READWRITE(megadriv_vdp_r, megadriv_vdp_w) // the earth defend
+	AM_RANGE(0xc00000, 0xc0001f) AM_DEVREADWRITE("gen_vdp", megadriv_vdp_r, megadriv_vdp_w)
+	AM_RANGE(0xd00000, 0xd0001f) AM_DEVREADWRITE("gen_vdp", megadriv_vdp_r, megadriv_vdp_w) // the earth defend
 
-	AM_RANGE(0xe00000, 0xe0ffff) AM_RAM AM_MIRROR(0x1f0000) AM_BASE(&megadrive_ram)
+	AM_RANGE(0xe00000, 0xe0ffff) AM_RAM AM_MIRROR(0x1f0000) AM_BASE_MEMBER(md_base_state, m_megadrive_ram)
 ADDRESS_MAP_END
 
 MACHINE_CONFIG_DERIVED( md_bootleg, megadriv )
@@ -3187,19 +3151,20 @@ static READ16_HANDLER( _32x_common_vdp_regs_r )
 
 		case 0x0a/2:
 			UINT16 retdata = _32x_a1518a_reg;
-			UINT16 hpos = get_hposition();
+			sega_genesis_vdp_device *vdp = megadrive_vdp(space->machine());
+			UINT16 hpos = vdp->get_hposition();
 			int megadrive_hblank_flag = 0;
 
-			if (megadrive_vblank_flag) retdata |= 0x8000;
+			if (vdp->vblank_flag()) retdata |= 0x8000;
 
 			if (hpos>400) megadrive_hblank_flag = 1;
 			if (hpos>460) megadrive_hblank_flag = 0;
 
 			if (megadrive_hblank_flag) retdata |= 0x4000;
 
-			if (megadrive_vblank_flag) { retdata |= 2; } // framebuffer approval (TODO: condition is unknown at current time)
+			if (vdp->vblank_flag()) { retdata |= 2; } // framebuffer approval (TODO: condition is unknown at current time)
 
-			if (megadrive_hblank_flag && megadrive_vblank_flag) { retdata |= 0x2000; } // palette approval (TODO: active high or low?)
+			if (megadrive_hblank_flag && vdp->vblank_flag()) { retdata |= 0x2000; } // palette approval (TODO: active high or low?)
 
 			return retdata;
 	}
@@ -3215,7 +3180,7 @@ void _32x_check_framebuffer_swap(void)
 	{
 
 		// this logic should be correct, but makes things worse?
-		//if (genesis_scanline_counter >= megadrive_irq6_scanline)
+		//if (m_scanline_counter >= m_irq6_scanline)
 		{
 			_32x_a1518a_reg = _32x_fb_swap & 1;
 
@@ -6087,7 +6052,8 @@ static TIMER_DEVICE_CALLBACK( scd_dma_timer_callback )
 	// timed reset of flags
 	scd_mode_dmna_ret_flags |= 0x0021;
 
-	scd_dma_timer->adjust(attotime::from_hz(megadriv_framerate) / megadrive_total_scanlines);
+	sega_genesis_vdp_device *vdp = megadrive_vdp(timer.machine());
+	scd_dma_timer->adjust(attotime::from_hz(vdp->framerate()) / vdp->total_scanlines());
 }
 
 
@@ -7220,67 +7186,181 @@ MACHINE_CONFIG_END
 //static attotime time_elapsed_since_crap;
 
 
-VIDEO_START(megadriv)
+/*****************************************************************************************/
+
+const device_type SEGA_GEN_VDP = &device_creator<sega_genesis_vdp_device>;
+
+sega_genesis_vdp_device::sega_genesis_vdp_device(const machine_config &mconfig, const char *tag, device_t *owner, UINT32 clock)
+	: device_t(mconfig, SEGA_GEN_VDP, "sega_genesis_vdp_device", tag, owner, clock)
 {
-	int x;
+}
 
-	render_bitmap = machine.primary_screen->alloc_compatible_bitmap();
+void sega_genesis_vdp_device::device_start()
+{
+	int x;
 
-	megadrive_vdp_vram  = auto_alloc_array(machine, UINT16, 0x10000/2);
-	megadrive_vdp_cram  = auto_alloc_array(machine, UINT16, 0x80/2);
-	megadrive_vdp_vsram = auto_alloc_array(machine, UINT16, 0x80/2);
-	megadrive_vdp_internal_sprite_attribute_table = auto_alloc_array(machine, UINT16, 0x400/2);
+	m_get_word_from_68k_mem = vdp_get_word_from_68k_mem_default;
+
+	m_frame_timer = subdevice<timer_device>("frame_timer");
+	m_scanline_timer = subdevice<timer_device>("scanline_timer");
+	m_render_timer = subdevice<timer_device>("render_timer");
+	m_irq6_on_timer = subdevice<timer_device>("irq6_timer");
+	m_irq4_on_timer = subdevice<timer_device>("irq4_timer");
+	m_render_bitmap = NULL;
+	m_use_cram = 0;
+
+	m_framerate = 60;
+	m_total_scanlines = 262;
+	m_visible_scanlines = 224;
+	m_irq6_scanline = 224;
+	m_z80irq_scanline = 226;
+	m_scanline_counter = 0;
+	m_irq4counter = -1;
+
+	m_imode = 0;
+	m_imode_odd_frame = 0;
+	m_vblank_flag = 0;
+	m_irq6_pending = 0;
+	m_irq4_pending = 0;
+	m_sprite_collision = 0;
+
+	m_vdp_command_pending = 0;
+	m_vdp_command_part1 = 0;
+	m_vdp_command_part2 = 0;
+	m_vdp_code = 0;
+	m_vdp_address = 0;
+	m_vram_fill_pending = 0;
+	m_vram_fill_length = 0;
+
+	m_vdp_vram  = auto_alloc_array(machine(), UINT16, 0x10000/2);
+	m_vdp_cram  = auto_alloc_array(machine(), UINT16, 0x80/2);
+	m_vdp_vsram = auto_alloc_array(machine(), UINT16, 0x80/2);
+	m_internal_sprite_attribute_table = auto_alloc_array(machine(), UINT16, 0x400/2);
 
 	for (x=0;x<0x20;x++)
-		megadrive_vdp_register[x]=0;
-//  memset(megadrive_vdp_vram, 0xff, 0x10000);
-//  memset(megadrive_vdp_cram, 0xff, 0x80);
-//  memset(megadrive_vdp_vsram, 0xff, 0x80);
+		m_vdp_register[x]=0;
+//  memset(m_vdp_vram, 0xff, 0x10000);
+//  memset(m_vdp_cram, 0xff, 0x80);
+//  memset(m_vdp_vsram, 0xff, 0x80);
 
-	memset(megadrive_vdp_vram, 0x00, 0x10000);
-	memset(megadrive_vdp_cram, 0x00, 0x80);
-	memset(megadrive_vdp_vsram, 0x00, 0x80);
-	memset(megadrive_vdp_internal_sprite_attribute_table, 0x00, 0x400);
+	memset(m_vdp_vram, 0x00, 0x10000);
+	memset(m_vdp_cram, 0x00, 0x80);
+	memset(m_vdp_vsram, 0x00, 0x80);
+	memset(m_internal_sprite_attribute_table, 0x00, 0x400);
 
-	megadrive_max_hposition = 480;
+	m_max_hposition = 480;
 
-	sprite_renderline = auto_alloc_array(machine, UINT8, 1024);
-	highpri_renderline = auto_alloc_array(machine, UINT8, 320);
-	video_renderline = auto_alloc_array(machine, UINT32, 320);
+	m_sprite_renderline = auto_alloc_array(machine(), UINT8, 1024);
+	m_highpri_renderline = auto_alloc_array(machine(), UINT8, 320);
+	m_video_renderline = auto_alloc_array(machine(), UINT32, 320);
 
-	megadrive_vdp_palette_lookup = auto_alloc_array(machine, UINT16, 0x40);
-	megadrive_vdp_palette_lookup_sprite = auto_alloc_array(machine, UINT16, 0x40);
+	/* sized for the C2, which drives these from its own palette RAM */
+	m_palette_lookup = auto_alloc_array_clear(machine(), UINT16, 0x1000/2);
+	m_palette_lookup_sprite = auto_alloc_array_clear(machine(), UINT16, 0x1000/2);
 
-	megadrive_vdp_palette_lookup_shadow = auto_alloc_array(machine, UINT16, 0x40);
-	megadrive_vdp_palette_lookup_highlight = auto_alloc_array(machine, UINT16, 0x40);
+	m_palette_lookup_shadow = auto_alloc_array_clear(machine(), UINT16, 0x1000/2);
+	m_palette_lookup_highlight = auto_alloc_array_clear(machine(), UINT16, 0x1000/2);
 
-	memset(megadrive_vdp_palette_lookup,0x00,0x40*2);
-	memset(megadrive_vdp_palette_lookup_sprite,0x00,0x40*2);
+	/* no special lookups */
+	m_segac2_bg_pal_lookup[0] = 0x00;
+	m_segac2_bg_pal_lookup[1] = 0x10;
+	m_segac2_bg_pal_lookup[2] = 0x20;
+	m_segac2_bg_pal_lookup[3] = 0x30;
 
-	memset(megadrive_vdp_palette_lookup_shadow,0x00,0x40*2);
-	memset(megadrive_vdp_palette_lookup_highlight,0x00,0x40*2);
+	m_segac2_sp_pal_lookup[0] = 0x00;
+	m_segac2_sp_pal_lookup[1] = 0x10;
+	m_segac2_sp_pal_lookup[2] = 0x20;
+	m_segac2_sp_pal_lookup[3] = 0x30;
 
-	/* no special lookups */
-	segac2_bg_pal_lookup[0] = 0x00;
-	segac2_bg_pal_lookup[1] = 0x10;
-	segac2_bg_pal_lookup[2] = 0x20;
-	segac2_bg_pal_lookup[3] = 0x30;
+	save_item(NAME(m_framerate));
+	save_item(NAME(m_total_scanlines));
+	save_item(NAME(m_visible_scanlines));
+	save_item(NAME(m_irq6_scanline));
+	save_item(NAME(m_z80irq_scanline));
+	save_item(NAME(m_scanline_counter));
+	save_item(NAME(m_irq4counter));
+	save_item(NAME(m_imode));
+	save_item(NAME(m_imode_odd_frame));
+	save_item(NAME(m_vblank_flag));
+	save_item(NAME(m_irq6_pending));
+	save_item(NAME(m_irq4_pending));
+	save_item(NAME(m_sprite_collision));
+	save_item(NAME(m_vdp_command_pending));
+	save_item(NAME(m_vdp_command_part1));
+	save_item(NAME(m_vdp_command_part2));
+	save_item(NAME(m_vdp_code));
+	save_item(NAME(m_vdp_address));
+	save_item(NAME(m_vdp_register));
+	save_item(NAME(m_vram_fill_pending));
+	save_item(NAME(m_vram_fill_length));
+	save_item(NAME(m_segac2_bg_pal_lookup));
+	save_item(NAME(m_segac2_sp_pal_lookup));
+	save_pointer(NAME(m_vdp_vram), 0x10000/2);
+	save_pointer(NAME(m_vdp_cram), 0x80/2);
+	save_pointer(NAME(m_vdp_vsram), 0x80/2);
+	save_pointer(NAME(m_internal_sprite_attribute_table), 0x400/2);
+	save_pointer(NAME(m_palette_lookup), 0x1000/2);
+	save_pointer(NAME(m_palette_lookup_sprite), 0x1000/2);
+	save_pointer(NAME(m_palette_lookup_shadow), 0x1000/2);
+	save_pointer(NAME(m_palette_lookup_highlight), 0x1000/2);
 
-	segac2_sp_pal_lookup[0] = 0x00;
-	segac2_sp_pal_lookup[1] = 0x10;
-	segac2_sp_pal_lookup[2] = 0x20;
-	segac2_sp_pal_lookup[3] = 0x30;
+	/* lines still on the worker must land before the state is saved */
+	m_render_queue = MEGADRIVE_DEFERRED_RENDER ? osd_work_queue_alloc(0) : NULL;
+	m_render_pending = 0;
+	m_render_deferred = 0;
+	m_raster_writes = 0;
+	machine().save().register_presave(save_prepost_delegate(FUNC(sega_genesis_vdp_device::sync_render), this));
 }
 
-SCREEN_UPDATE(megadriv)
+void sega_genesis_vdp_device::device_stop()
+{
+	if (m_render_queue != NULL)
+	{
+		sync_render();
+		osd_work_queue_free(m_render_queue);
+		m_render_queue = NULL;
+	}
+}
+
+void sega_genesis_vdp_device::set_palette_lookup(int offset, UINT16 normal, UINT16 shadow, UINT16 highlight)
+{
+	m_palette_lookup[offset] = normal;
+	m_palette_lookup_sprite[offset] = normal;
+	m_palette_lookup_shadow[offset] = shadow;
+	m_palette_lookup_highlight[offset] = highlight;
+}
+
+void sega_genesis_vdp_device::set_segac2_pal_lookup(int index, int bgpal, int sppal)
+{
+	m_segac2_bg_pal_lookup[index] = bgpal;
+	m_segac2_sp_pal_lookup[index] = sppal;
+}
+
+void sega_genesis_vdp_device::video_start()
+{
+	m_render_bitmap = machine().primary_screen->alloc_compatible_bitmap();
+}
+
+void sega_genesis_vdp_device::screen_update(bitmap_t *bitmap, const rectangle *cliprect)
 {
 	/* Copy our screen buffer here */
-	copybitmap(bitmap, render_bitmap, 0, 0, 0, 0, cliprect);
+	sync_render();
+	copybitmap(bitmap, m_render_bitmap, 0, 0, 0, 0, cliprect);
+}
+
+VIDEO_START(megadriv)
+{
+	megadrive_vdp(machine)->video_start();
+}
+
+SCREEN_UPDATE(megadriv)
+{
+	megadrive_vdp(screen->machine())->screen_update(bitmap, cliprect);
 
 //  int xxx;
 	/* reference */
 
-//  time_elapsed_since_crap = frame_timer->time_elapsed();
+//  time_elapsed_since_crap = m_frame_timer->time_elapsed();
 //  xxx = screen->machine().device<device>("maincpu")->attotime_to_cycles(time_elapsed_since_crap);
 //  mame_printf_debug("update cycles %d, %08x %08x\n",xxx, (UINT32)(time_elapsed_since_crap.attoseconds>>32),(UINT32)(time_elapsed_since_crap.attoseconds&0xffffffff));
 
@@ -7333,7 +7413,7 @@ static TIMER_DEVICE_CALLBACK( frame_timer_callback )
 
 */
 
-static void genesis_render_spriteline_to_spritebuffer(int scanline)
+void sega_genesis_vdp_device::render_spriteline_to_spritebuffer(int scanline)
 {
 	int screenwidth;
 	int maxsprites=0;
@@ -7354,7 +7434,7 @@ static void genesis_render_spriteline_to_spritebuffer(int scanline)
 
 
 	/* Clear our Render Buffer */
-	memset(sprite_renderline, 0, 1024);
+	memset(m_sprite_renderline, 0, 1024);
 
 
 	{
@@ -7374,26 +7454,26 @@ static void genesis_render_spriteline_to_spritebuffer(int scanline)
 		{
 			//UINT16 value1,value2,value3,value4;
 
-			//value1 = megadrive_vdp_vram[((base_address>>1)+spritenum*4)+0x0];
-			//value2 = megadrive_vdp_vram[((base_address>>1)+spritenum*4)+0x1];
-			//value3 = megadrive_vdp_vram[((base_address>>1)+spritenum*4)+0x2];
-			//value4 = megadrive_vdp_vram[((base_address>>1)+spritenum*4)+0x3];
+			//value1 = m_vdp_vram[((base_address>>1)+spritenum*4)+0x0];
+			//value2 = m_vdp_vram[((base_address>>1)+spritenum*4)+0x1];
+			//value3 = m_vdp_vram[((base_address>>1)+spritenum*4)+0x2];
+			//value4 = m_vdp_vram[((base_address>>1)+spritenum*4)+0x3];
 
-			ypos  = (megadrive_vdp_internal_sprite_attribute_table[(spritenum*4)+0x0] & 0x01ff)>>0; /* 0x03ff? */ // puyo puyo requires 0x1ff mask, not 0x3ff, see speech bubble corners
-			height= (megadrive_vdp_internal_sprite_attribute_table[(spritenum*4)+0x1] & 0x0300)>>8;
-			width = (megadrive_vdp_internal_sprite_attribute_table[(spritenum*4)+0x1] & 0x0c00)>>10;
-			link  = (megadrive_vdp_internal_sprite_attribute_table[(spritenum*4)+0x1] & 0x007f)>>0;
+			ypos  = (m_internal_sprite_attribute_table[(spritenum*4)+0x0] & 0x01ff)>>0; /* 0x03ff? */ // puyo puyo requires 0x1ff mask, not 0x3ff, see speech bubble corners
+			height= (m_internal_sprite_attribute_table[(spritenum*4)+0x1] & 0x0300)>>8;
+			width = (m_internal_sprite_attribute_table[(spritenum*4)+0x1] & 0x0c00)>>10;
+			link  = (m_internal_sprite_attribute_table[(spritenum*4)+0x1] & 0x007f)>>0;
 			xpos  = (MEGADRIV_VDP_VRAM(((base_address>>1)+spritenum*4)+0x3) & 0x01ff)>>0; /* 0x03ff? */ // pirates gold has a sprite with co-ord 0x200...
 
-			if(megadrive_imode==3)
+			if(m_imode==3)
 			{
-				ypos  = (megadrive_vdp_internal_sprite_attribute_table[(spritenum*4)+0x0] & 0x03ff)>>0; /* 0x3ff requried in interlace mode (sonic 2 2 player) */
+				ypos  = (m_internal_sprite_attribute_table[(spritenum*4)+0x0] & 0x03ff)>>0; /* 0x3ff requried in interlace mode (sonic 2 2 player) */
 				drawypos = ypos - 256;
 				drawheight = (height+1)*16;
 			}
 			else
 			{
-				ypos  = (megadrive_vdp_internal_sprite_attribute_table[(spritenum*4)+0x0] & 0x01ff)>>0; /* 0x03ff? */ // puyo puyo requires 0x1ff mask, not 0x3ff, see speech bubble corners
+				ypos  = (m_internal_sprite_attribute_table[(spritenum*4)+0x0] & 0x01ff)>>0; /* 0x03ff? */ // puyo puyo requires 0x1ff mask, not 0x3ff, see speech bubble corners
 				drawypos = ypos - 128;
 				drawheight = (height+1)*8;
 			}
@@ -7411,7 +7491,7 @@ static void genesis_render_spriteline_to_spritebuffer(int scanline)
 				colour= (MEGADRIV_VDP_VRAM(((base_address>>1)+spritenum*4)+0x2) & 0x6000)>>13;
 				pri   = (MEGADRIV_VDP_VRAM(((base_address>>1)+spritenum*4)+0x2) & 0x8000)>>15;
 
-				if(megadrive_imode==3)
+				if(m_imode==3)
 				{
 					addr<<=1;
 					addr &=0x7ff;
@@ -7453,7 +7533,7 @@ static void genesis_render_spriteline_to_spritebuffer(int scanline)
 							UINT32 gfxdata;
 							int loopcount;
 
-							if(megadrive_imode==3)
+							if(m_imode==3)
 							{
 								if (!yflip) base_addr = (addr<<4)+(xtile*((height+1)*(2*16)))+(yline*2);
 								else base_addr = (addr<<4)+(xtile*((height+1)*(2*16)))+((((height+1)*16)-yline-1)*2);
@@ -7471,7 +7551,7 @@ static void genesis_render_spriteline_to_spritebuffer(int scanline)
 							for(loopcount=0;loopcount<8;loopcount++)
 							{
 								dat = (gfxdata & 0xf0000000)>>28; gfxdata <<=4;
-								if (dat) { if (!sprite_renderline[xxx]) { sprite_renderline[xxx] = dat | (colour<<4)| pri; } else { megadrive_sprite_collision = 1; } }
+								if (dat) { if (!m_sprite_renderline[xxx]) { m_sprite_renderline[xxx] = dat | (colour<<4)| pri; } else { m_sprite_collision = 1; } }
 								xxx++;xxx&=0x1ff;
 								if (--maxpixels == 0x00) return;
 							}
@@ -7485,7 +7565,7 @@ static void genesis_render_spriteline_to_spritebuffer(int scanline)
 
 							int loopcount;
 
-							if(megadrive_imode==3)
+							if(m_imode==3)
 							{
 								if (!yflip) base_addr = (addr<<4)+(((width-xtile))*((height+1)*(2*16)))+(yline*2);
 								else base_addr =      (addr<<4)+(((width-xtile))*((height+1)*(2*16)))+((((height+1)*16)-yline-1)*2);
@@ -7504,7 +7584,7 @@ static void genesis_render_spriteline_to_spritebuffer(int scanline)
 							for(loopcount=0;loopcount<8;loopcount++)
 							{
 								dat = (gfxdata & 0x0000000f)>>0; gfxdata >>=4;
-								if (dat) { if (!sprite_renderline[xxx]) { sprite_renderline[xxx] = dat | (colour<<4)| pri; } else { megadrive_sprite_collision = 1; } }
+								if (dat) { if (!m_sprite_renderline[xxx]) { m_sprite_renderline[xxx] = dat | (colour<<4)| pri; } else { m_sprite_collision = 1; } }
 								xxx++;xxx&=0x1ff;
 								if (--maxpixels == 0x00) return;
 							}
@@ -7524,7 +7604,7 @@ static void genesis_render_spriteline_to_spritebuffer(int scanline)
 }
 
 /* Clean up this function (!) */
-static void genesis_render_videoline_to_videobuffer(int scanline)
+void sega_genesis_vdp_device::render_videoline_to_videobuffer(int scanline)
 {
 	UINT16 base_a;
 	UINT16 base_w=0;
@@ -7559,10 +7639,10 @@ static void genesis_render_videoline_to_videobuffer(int scanline)
 	/* Clear our Render Buffer */
 	for (x=0;x<320;x++)
 	{
-		video_renderline[x]=MEGADRIVE_REG07_BGCOLOUR | 0x20000; // mark as BG
+		m_video_renderline[x]=MEGADRIVE_REG07_BGCOLOUR | 0x20000; // mark as BG
 	}
 
-	memset(highpri_renderline, 0, 320);
+	memset(m_highpri_renderline, 0, 320);
 
 	/* is this line enabled? */
 	if (!MEGADRIVE_REG01_DISP_ENABLE)
@@ -7681,7 +7761,7 @@ static void genesis_render_videoline_to_videobuffer(int scanline)
 			break;
 
 		case 0x01: // 'Broken' Line Scroll
-			if(megadrive_imode==3)
+			if(m_imode==3)
 			{
 				hscroll_a = MEGADRIV_VDP_VRAM((hscroll_base>>1)+0+((scanline>>1)&7)*2);
 				hscroll_b = MEGADRIV_VDP_VRAM((hscroll_base>>1)+1+((scanline>>1)&7)*2);
@@ -7694,7 +7774,7 @@ static void genesis_render_videoline_to_videobuffer(int scanline)
 			break;
 
 		case 0x02: // Cell Scroll
-			if(megadrive_imode==3)
+			if(m_imode==3)
 			{
 				hscroll_a = MEGADRIV_VDP_VRAM((hscroll_base>>1)+0+((scanline>>1)&~7)*2);
 				hscroll_b = MEGADRIV_VDP_VRAM((hscroll_base>>1)+1+((scanline>>1)&~7)*2);
@@ -7707,7 +7787,7 @@ static void genesis_render_videoline_to_videobuffer(int scanline)
 			break;
 
 		case 0x03: // Full Line Scroll
-			if(megadrive_imode==3)
+			if(m_imode==3)
 			{
 				hscroll_a = MEGADRIV_VDP_VRAM((hscroll_base>>1)+0+(scanline>>1)*2);
 				hscroll_b = MEGADRIV_VDP_VRAM((hscroll_base>>1)+1+(scanline>>1)*2);
@@ -7749,17 +7829,17 @@ static void genesis_render_videoline_to_videobuffer(int scanline)
 
 				if (MEGADRIVE_REG0B_VSCROLL_MODE)
 				{
-					if (hscroll_b&0xf) vscroll = megadrive_vdp_vsram[((column-1)*2+1)&0x3f];
-					else vscroll = megadrive_vdp_vsram[((column)*2+1)&0x3f];
+					if (hscroll_b&0xf) vscroll = m_vdp_vsram[((column-1)*2+1)&0x3f];
+					else vscroll = m_vdp_vsram[((column)*2+1)&0x3f];
 				}
 				else
 				{
-					vscroll = megadrive_vdp_vsram[1];
+					vscroll = m_vdp_vsram[1];
 				}
 
 				hcolumn = ((column*2-1)-(hscroll_b>>3))&(hsize-1);
 
-				if(megadrive_imode==3)
+				if(m_imode==3)
 				{
 					vcolumn = (vscroll + scanline)&((vsize*16)-1);
 					tile_base = (base_b>>1)+((vcolumn>>4)*hsize)+hcolumn;
@@ -7780,7 +7860,7 @@ static void genesis_render_videoline_to_videobuffer(int scanline)
 				tile_pri = (tile_dat&0x8000)>>15;
 				tile_addr = ((tile_dat&0x07ff)<<4);
 
-				if(megadrive_imode==3)
+				if(m_imode==3)
 				{
 					tile_addr <<=1;
 					tile_addr &=0x7fff;
@@ -7801,7 +7881,7 @@ static void genesis_render_videoline_to_videobuffer(int scanline)
 
 					for (shift=hscroll_part;shift<8;shift++)
 					{
-						dat = (gfxdata>>(28-(shift*4)))&0x000f;  if (!tile_pri) { if(dat) video_renderline[dpos] = dat | (tile_colour<<4); }  else highpri_renderline[dpos]  = dat | (tile_colour<<4) | 0x80;
+						dat = (gfxdata>>(28-(shift*4)))&0x000f;  if (!tile_pri) { if(dat) m_video_renderline[dpos] = dat | (tile_colour<<4); }  else m_highpri_renderline[dpos]  = dat | (tile_colour<<4) | 0x80;
 						dpos++;
 					}
 				}
@@ -7811,24 +7891,24 @@ static void genesis_render_videoline_to_videobuffer(int scanline)
 					int shift;
 					for (shift=hscroll_part;shift<8;shift++)
 					{
-						dat = (gfxdata>>(shift*4) )&0x000f;  if (!tile_pri) { if(dat) video_renderline[dpos] = dat | (tile_colour<<4); }  else highpri_renderline[dpos]  = dat | (tile_colour<<4) | 0x80;
+						dat = (gfxdata>>(shift*4) )&0x000f;  if (!tile_pri) { if(dat) m_video_renderline[dpos] = dat | (tile_colour<<4); }  else m_highpri_renderline[dpos]  = dat | (tile_colour<<4) | 0x80;
 						dpos++;
 					}
 				}
 
 				if (MEGADRIVE_REG0B_VSCROLL_MODE)
 				{
-					if (hscroll_b&0xf) vscroll = megadrive_vdp_vsram[((column-1)*2+1)&0x3f];
-					else vscroll = megadrive_vdp_vsram[((column)*2+1)&0x3f];
+					if (hscroll_b&0xf) vscroll = m_vdp_vsram[((column-1)*2+1)&0x3f];
+					else vscroll = m_vdp_vsram[((column)*2+1)&0x3f];
 				}
 				else
 				{
-					vscroll = megadrive_vdp_vsram[1];
+					vscroll = m_vdp_vsram[1];
 				}
 
 				hcolumn = ((column*2)-(hscroll_b>>3))&(hsize-1);
 
-				if(megadrive_imode==3)
+				if(m_imode==3)
 				{
 					vcolumn = (vscroll + scanline)&((vsize*16)-1);
 					tile_base = (base_b>>1)+((vcolumn>>4)*hsize)+hcolumn;
@@ -7847,7 +7927,7 @@ static void genesis_render_videoline_to_videobuffer(int scanline)
 				tile_pri = (tile_dat&0x8000)>>15;
 				tile_addr = ((tile_dat&0x07ff)<<4);
 
-				if(megadrive_imode==3)
+				if(m_imode==3)
 				{
 					tile_addr <<=1;
 					tile_addr &=0x7fff;
@@ -7869,7 +7949,7 @@ static void genesis_render_videoline_to_videobuffer(int scanline)
 
 					for (shift=0;shift<8;shift++)
 					{
-						dat = (gfxdata>>(28-(shift*4)))&0x000f;  if (!tile_pri) { if(dat) video_renderline[dpos] = dat | (tile_colour<<4); }  else highpri_renderline[dpos]  = dat | (tile_colour<<4) | 0x80;
+						dat = (gfxdata>>(28-(shift*4)))&0x000f;  if (!tile_pri) { if(dat) m_video_renderline[dpos] = dat | (tile_colour<<4); }  else m_highpri_renderline[dpos]  = dat | (tile_colour<<4) | 0x80;
 						dpos++;
 					}
 				}
@@ -7879,23 +7959,23 @@ static void genesis_render_videoline_to_videobuffer(int scanline)
 					int shift;
 					for (shift=0;shift<8;shift++)
 					{
-						dat = (gfxdata>>(shift*4))&0x000f;  if (!tile_pri) { if(dat) video_renderline[dpos] = dat | (tile_colour<<4); }  else highpri_renderline[dpos]  = dat | (tile_colour<<4) | 0x80;
+						dat = (gfxdata>>(shift*4))&0x000f;  if (!tile_pri) { if(dat) m_video_renderline[dpos] = dat | (tile_colour<<4); }  else m_highpri_renderline[dpos]  = dat | (tile_colour<<4) | 0x80;
 						dpos++;
 					}
 				}
 
 				if (MEGADRIVE_REG0B_VSCROLL_MODE)
 				{
-					vscroll = megadrive_vdp_vsram[((column)*2+1)&0x3f];
+					vscroll = m_vdp_vsram[((column)*2+1)&0x3f];
 				}
 				else
 				{
-					vscroll = megadrive_vdp_vsram[1];
+					vscroll = m_vdp_vsram[1];
 				}
 
 				hcolumn = ((column*2+1)-(hscroll_b>>3))&(hsize-1);
 
-				if(megadrive_imode==3)
+				if(m_imode==3)
 				{
 					vcolumn = (vscroll + scanline)&((vsize*16)-1);
 					tile_base = (base_b>>1)+((vcolumn>>4)*hsize)+hcolumn;
@@ -7914,7 +7994,7 @@ static void genesis_render_videoline_to_videobuffer(int scanline)
 				tile_pri = (tile_dat&0x8000)>>15;
 				tile_addr = ((tile_dat&0x07ff)<<4);
 
-				if(megadrive_imode==3)
+				if(m_imode==3)
 				{
 					tile_addr <<=1;
 					tile_addr &=0x7fff;
@@ -7936,7 +8016,7 @@ static void genesis_render_videoline_to_videobuffer(int scanline)
 
 					for (shift=0;shift<(hscroll_part);shift++)
 					{
-						dat = (gfxdata>>(28-(shift*4)))&0x000f;  if (!tile_pri) { if(dat) video_renderline[dpos] = dat | (tile_colour<<4); }  else highpri_renderline[dpos]  = dat | (tile_colour<<4) | 0x80;
+						dat = (gfxdata>>(28-(shift*4)))&0x000f;  if (!tile_pri) { if(dat) m_video_renderline[dpos] = dat | (tile_colour<<4); }  else m_highpri_renderline[dpos]  = dat | (tile_colour<<4) | 0x80;
 						dpos++;
 					}
 				}
@@ -7946,7 +8026,7 @@ static void genesis_render_videoline_to_videobuffer(int scanline)
 					int shift;
 					for (shift=0;shift<(hscroll_part);shift++)
 					{
-						dat = (gfxdata>>(shift*4) )&0x000f;  if (!tile_pri) { if(dat) video_renderline[dpos] = dat | (tile_colour<<4); }  else highpri_renderline[dpos]  = dat | (tile_colour<<4) | 0x80;
+						dat = (gfxdata>>(shift*4) )&0x000f;  if (!tile_pri) { if(dat) m_video_renderline[dpos] = dat | (tile_colour<<4); }  else m_highpri_renderline[dpos]  = dat | (tile_colour<<4) | 0x80;
 						dpos++;
 					}
 				}
@@ -7979,7 +8059,7 @@ static void genesis_render_videoline_to_videobuffer(int scanline)
 			dpos = column*16;
 			hcolumn = (column*2)&(window_hsize-1);
 
-			if(megadrive_imode==3)
+			if(m_imode==3)
 			{
 				tile_base = (base_w>>1)+((vcolumn>>4)*window_hsize)+hcolumn;
 			}
@@ -7996,13 +8076,13 @@ static void genesis_render_videoline_to_videobuffer(int scanline)
 			tile_pri = (tile_dat&0x8000)>>15;
 			tile_addr = ((tile_dat&0x07ff)<<4);
 
-			if(megadrive_imode==3)
+			if(m_imode==3)
 			{
 				tile_addr <<=1;
 				tile_addr &=0x7fff;
 			}
 
-			if(megadrive_imode==3)
+			if(m_imode==3)
 			{
 				if (!tile_yflip) tile_addr+=(vcolumn&0xf)*2;
 				else tile_addr+=((0xf-vcolumn)&0xf)*2;
@@ -8024,12 +8104,12 @@ static void genesis_render_videoline_to_videobuffer(int scanline)
 					dat = (gfxdata>>(28-(shift*4)))&0x000f;
 					if (!tile_pri)
 					{
-						if(dat) video_renderline[dpos] = dat | (tile_colour<<4);
+						if(dat) m_video_renderline[dpos] = dat | (tile_colour<<4);
 					}
 					else
 					{
-						if (dat) highpri_renderline[dpos]  = dat | (tile_colour<<4) | 0x80;
-						else highpri_renderline[dpos] = highpri_renderline[dpos]|0x80;
+						if (dat) m_highpri_renderline[dpos]  = dat | (tile_colour<<4) | 0x80;
+						else m_highpri_renderline[dpos] = m_highpri_renderline[dpos]|0x80;
 					}
 					dpos++;
 				}
@@ -8043,12 +8123,12 @@ static void genesis_render_videoline_to_videobuffer(int scanline)
 					dat = (gfxdata>>(shift*4) )&0x000f;
 					if (!tile_pri)
 					{
-						if(dat) video_renderline[dpos] = dat | (tile_colour<<4);
+						if(dat) m_video_renderline[dpos] = dat | (tile_colour<<4);
 					}
 					else
 					{
-						if (dat) highpri_renderline[dpos]  = dat | (tile_colour<<4) | 0x80;
-						else highpri_renderline[dpos] = highpri_renderline[dpos]|0x80;
+						if (dat) m_highpri_renderline[dpos]  = dat | (tile_colour<<4) | 0x80;
+						else m_highpri_renderline[dpos] = m_highpri_renderline[dpos]|0x80;
 					}
 					dpos++;
 
@@ -8057,7 +8137,7 @@ static void genesis_render_videoline_to_videobuffer(int scanline)
 
 
 			hcolumn = (column*2+1)&(window_hsize-1);
-			if(megadrive_imode==3)
+			if(m_imode==3)
 			{
 				tile_base = (base_w>>1)+((vcolumn>>4)*window_hsize)+hcolumn;
 			}
@@ -8073,13 +8153,13 @@ static void genesis_render_videoline_to_videobuffer(int scanline)
 			tile_pri = (tile_dat&0x8000)>>15;
 			tile_addr = ((tile_dat&0x07ff)<<4);
 
-			if(megadrive_imode==3)
+			if(m_imode==3)
 			{
 				tile_addr <<=1;
 				tile_addr &=0x7fff;
 			}
 
-			if(megadrive_imode==3)
+			if(m_imode==3)
 			{
 				if (!tile_yflip) tile_addr+=(vcolumn&0xf)*2;
 				else tile_addr+=((0xf-vcolumn)&0xf)*2;
@@ -8101,12 +8181,12 @@ static void genesis_render_videoline_to_videobuffer(int scanline)
 					dat = (gfxdata>>(28-(shift*4)))&0x000f;
 					if (!tile_pri)
 					{
-						if(dat) video_renderline[dpos] = dat | (tile_colour<<4);
+						if(dat) m_video_renderline[dpos] = dat | (tile_colour<<4);
 					}
 					else
 					{
-						if (dat) highpri_renderline[dpos]  = dat | (tile_colour<<4) | 0x80;
-						else highpri_renderline[dpos] = highpri_renderline[dpos]|0x80;
+						if (dat) m_highpri_renderline[dpos]  = dat | (tile_colour<<4) | 0x80;
+						else m_highpri_renderline[dpos] = m_highpri_renderline[dpos]|0x80;
 					}
 					dpos++;
 				}
@@ -8120,12 +8200,12 @@ static void genesis_render_videoline_to_videobuffer(int scanline)
 					dat = (gfxdata>>(shift*4) )&0x000f;
 					if (!tile_pri)
 					{
-						if(dat) video_renderline[dpos] = dat | (tile_colour<<4);
+						if(dat) m_video_renderline[dpos] = dat | (tile_colour<<4);
 					}
 					else
 					{
-						if (dat) highpri_renderline[dpos]  = dat | (tile_colour<<4) | 0x80;
-						else highpri_renderline[dpos] = highpri_renderline[dpos]|0x80;
+						if (dat) m_highpri_renderline[dpos]  = dat | (tile_colour<<4) | 0x80;
+						else m_highpri_renderline[dpos] = m_highpri_renderline[dpos]|0x80;
 					}
 					dpos++;
 				}
@@ -8156,19 +8236,19 @@ static void genesis_render_videoline_to_videobuffer(int scanline)
 
 				if (MEGADRIVE_REG0B_VSCROLL_MODE)
 				{
-					if (hscroll_a&0xf) vscroll = megadrive_vdp_vsram[((column-1)*2+0)&0x3f];
-					else vscroll = megadrive_vdp_vsram[((column)*2+0)&0x3f];
+					if (hscroll_a&0xf) vscroll = m_vdp_vsram[((column-1)*2+0)&0x3f];
+					else vscroll = m_vdp_vsram[((column)*2+0)&0x3f];
 				}
 				else
 				{
-					vscroll = megadrive_vdp_vsram[0];
+					vscroll = m_vdp_vsram[0];
 				}
 
 
 				if ((!window_is_bugged) || ((hscroll_a&0xf)==0) || (column>non_window_firstcol/16)) hcolumn = ((column*2-1)-(hscroll_a>>3))&(hsize-1);
 				else hcolumn = ((column*2+1)-(hscroll_a>>3))&(hsize-1);
 
-				if(megadrive_imode==3)
+				if(m_imode==3)
 				{
 					vcolumn = (vscroll + scanline)&((vsize*16)-1);
 				}
@@ -8177,7 +8257,7 @@ static void genesis_render_videoline_to_videobuffer(int scanline)
 					vcolumn = (vscroll + scanline)&((vsize*8)-1);
 				}
 
-				if(megadrive_imode==3)
+				if(m_imode==3)
 				{
 					tile_base = (base_a>>1)+((vcolumn>>4)*hsize)+hcolumn;
 				}
@@ -8195,7 +8275,7 @@ static void genesis_render_videoline_to_videobuffer(int scanline)
 				tile_pri = (tile_dat&0x8000)>>15;
 				tile_addr = ((tile_dat&0x07ff)<<4);
 
-				if(megadrive_imode==3)
+				if(m_imode==3)
 				{
 					tile_addr <<=1;
 					tile_addr &=0x7fff;
@@ -8219,12 +8299,12 @@ static void genesis_render_videoline_to_videobuffer(int scanline)
 						dat = (gfxdata>>(28-(shift*4)))&0x000f;
 						if (!tile_pri)
 						{
-							if(dat) video_renderline[dpos] = dat | (tile_colour<<4);
+							if(dat) m_video_renderline[dpos] = dat | (tile_colour<<4);
 						}
 						else
 						{
-							if (dat) highpri_renderline[dpos]  = dat | (tile_colour<<4) | 0x80;
-							else highpri_renderline[dpos] = highpri_renderline[dpos]|0x80;
+							if (dat) m_highpri_renderline[dpos]  = dat | (tile_colour<<4) | 0x80;
+							else m_highpri_renderline[dpos] = m_highpri_renderline[dpos]|0x80;
 						}
 						dpos++;
 					}
@@ -8238,12 +8318,12 @@ static void genesis_render_videoline_to_videobuffer(int scanline)
 						dat = (gfxdata>>(shift*4) )&0x000f;
 						if (!tile_pri)
 						{
-							if(dat) video_renderline[dpos] = dat | (tile_colour<<4);
+							if(dat) m_video_renderline[dpos] = dat | (tile_colour<<4);
 						}
 						else
 						{
-							if (dat) highpri_renderline[dpos]  = dat | (tile_colour<<4) | 0x80;
-							else highpri_renderline[dpos] = highpri_renderline[dpos]|0x80;
+							if (dat) m_highpri_renderline[dpos]  = dat | (tile_colour<<4) | 0x80;
+							else m_highpri_renderline[dpos] = m_highpri_renderline[dpos]|0x80;
 						}
 						dpos++;
 					}
@@ -8251,12 +8331,12 @@ static void genesis_render_videoline_to_videobuffer(int scanline)
 
 				if (MEGADRIVE_REG0B_VSCROLL_MODE)
 				{
-					if (hscroll_a&0xf) vscroll = megadrive_vdp_vsram[((column-1)*2+0)&0x3f];
-					else vscroll = megadrive_vdp_vsram[((column)*2+0)&0x3f];
+					if (hscroll_a&0xf) vscroll = m_vdp_vsram[((column-1)*2+0)&0x3f];
+					else vscroll = m_vdp_vsram[((column)*2+0)&0x3f];
 				}
 				else
 				{
-					vscroll = megadrive_vdp_vsram[0];
+					vscroll = m_vdp_vsram[0];
 				}
 
 				if ((!window_is_bugged) || ((hscroll_a&0xf)==0) || (column>non_window_firstcol/16)) hcolumn = ((column*2)-(hscroll_a>>3))&(hsize-1); // not affected by bug?
@@ -8267,7 +8347,7 @@ static void genesis_render_videoline_to_videobuffer(int scanline)
 				}
 
 
-				if(megadrive_imode==3)
+				if(m_imode==3)
 				{
 					vcolumn = (vscroll + scanline)&((vsize*16)-1);
 					tile_base = (base_a>>1)+((vcolumn>>4)*hsize)+hcolumn;
@@ -8287,7 +8367,7 @@ static void genesis_render_videoline_to_videobuffer(int scanline)
 				tile_addr = ((tile_dat&0x07ff)<<4);
 
 
-				if(megadrive_imode==3)
+				if(m_imode==3)
 				{
 					tile_addr <<=1;
 					tile_addr &=0x7fff;
@@ -8311,12 +8391,12 @@ static void genesis_render_videoline_to_videobuffer(int scanline)
 						dat = (gfxdata>>(28-(shift*4)))&0x000f;
 						if (!tile_pri)
 						{
-							if(dat) video_renderline[dpos] = dat | (tile_colour<<4);
+							if(dat) m_video_renderline[dpos] = dat | (tile_colour<<4);
 						}
 						else
 						{
-							if (dat) highpri_renderline[dpos]  = dat | (tile_colour<<4) | 0x80;
-							else highpri_renderline[dpos] = highpri_renderline[dpos]|0x80;
+							if (dat) m_highpri_renderline[dpos]  = dat | (tile_colour<<4) | 0x80;
+							else m_highpri_renderline[dpos] = m_highpri_renderline[dpos]|0x80;
 						}
 						dpos++;
 					}
@@ -8330,12 +8410,12 @@ static void genesis_render_videoline_to_videobuffer(int scanline)
 						dat = (gfxdata>>(shift*4) )&0x000f;
 						if (!tile_pri)
 						{
-							if(dat) video_renderline[dpos] = dat | (tile_colour<<4);
+							if(dat) m_video_renderline[dpos] = dat | (tile_colour<<4);
 						}
 						else
 						{
-							if (dat) highpri_renderline[dpos]  = dat | (tile_colour<<4) | 0x80;
-							else highpri_renderline[dpos] = highpri_renderline[dpos]|0x80;
+							if (dat) m_highpri_renderline[dpos]  = dat | (tile_colour<<4) | 0x80;
+							else m_highpri_renderline[dpos] = m_highpri_renderline[dpos]|0x80;
 						}
 						dpos++;
 					}
@@ -8343,17 +8423,17 @@ static void genesis_render_videoline_to_videobuffer(int scanline)
 
 				if (MEGADRIVE_REG0B_VSCROLL_MODE)
 				{
-					vscroll = megadrive_vdp_vsram[((column)*2+0)&0x3f];
+					vscroll = m_vdp_vsram[((column)*2+0)&0x3f];
 				}
 				else
 				{
-					vscroll = megadrive_vdp_vsram[0];
+					vscroll = m_vdp_vsram[0];
 				}
 
 				if ((!window_is_bugged) || ((hscroll_a&0xf)==0) || (column>non_window_firstcol/16)) hcolumn = ((column*2+1)-(hscroll_a>>3))&(hsize-1);
 				else hcolumn = ((column*2+1)-(hscroll_a>>3))&(hsize-1);
 
-				if(megadrive_imode==3)
+				if(m_imode==3)
 				{
 					vcolumn = (vscroll + scanline)&((vsize*16)-1);
 					tile_base = (base_a>>1)+((vcolumn>>4)*hsize)+hcolumn;
@@ -8371,13 +8451,13 @@ static void genesis_render_videoline_to_videobuffer(int scanline)
 				tile_pri = (tile_dat&0x8000)>>15;
 				tile_addr = ((tile_dat&0x07ff)<<4);
 
-				if(megadrive_imode==3)
+				if(m_imode==3)
 				{
 					tile_addr <<=1;
 					tile_addr &=0x7fff;
 				}
 
-				if(megadrive_imode==3)
+				if(m_imode==3)
 				{
 					if (!tile_yflip) tile_addr+=(vcolumn&0xf)*2;
 					else tile_addr+=((0xf-vcolumn)&0xf)*2;
@@ -8399,12 +8479,12 @@ static void genesis_render_videoline_to_videobuffer(int scanline)
 						dat = (gfxdata>>(28-(shift*4)))&0x000f;
 						if (!tile_pri)
 						{
-							if(dat) video_renderline[dpos] = dat | (tile_colour<<4);
+							if(dat) m_video_renderline[dpos] = dat | (tile_colour<<4);
 						}
 						else
 						{
-							if (dat) highpri_renderline[dpos]  = dat | (tile_colour<<4) | 0x80;
-							else highpri_renderline[dpos] = highpri_renderline[dpos]|0x80;
+							if (dat) m_highpri_renderline[dpos]  = dat | (tile_colour<<4) | 0x80;
+							else m_highpri_renderline[dpos] = m_highpri_renderline[dpos]|0x80;
 						}
 						dpos++;
 					}
@@ -8418,12 +8498,12 @@ static void genesis_render_videoline_to_videobuffer(int scanline)
 						dat = (gfxdata>>(shift*4) )&0x000f;
 						if (!tile_pri)
 						{
-							if(dat) video_renderline[dpos] = dat | (tile_colour<<4);
+							if(dat) m_video_renderline[dpos] = dat | (tile_colour<<4);
 						}
 						else
 						{
-							if (dat) highpri_renderline[dpos]  = dat | (tile_colour<<4) | 0x80;
-							else highpri_renderline[dpos] = highpri_renderline[dpos]|0x80;
+							if (dat) m_highpri_renderline[dpos]  = dat | (tile_colour<<4) | 0x80;
+							else m_highpri_renderline[dpos] = m_highpri_renderline[dpos]|0x80;
 						}
 						dpos++;
 					}
@@ -8439,41 +8519,41 @@ static void genesis_render_videoline_to_videobuffer(int scanline)
 		{
 			if (!MEGADRIVE_REG0C_SHADOW_HIGLIGHT)
 			{
-				if (sprite_renderline[x+128] & 0x40)
+				if (m_sprite_renderline[x+128] & 0x40)
 				{
-					video_renderline[x] = sprite_renderline[x+128]&0x3f;
-					video_renderline[x] |= 0x10000; // mark as sprite pixel
+					m_video_renderline[x] = m_sprite_renderline[x+128]&0x3f;
+					m_video_renderline[x] |= 0x10000; // mark as sprite pixel
 				}
 			}
 			else
 			{	/* Special Shadow / Highlight processing */
 
-				if (sprite_renderline[x+128] & 0x40)
+				if (m_sprite_renderline[x+128] & 0x40)
 				{
 					UINT8 spritedata;
-					spritedata = sprite_renderline[x+128]&0x3f;
+					spritedata = m_sprite_renderline[x+128]&0x3f;
 
 					if ((spritedata==0x0e) || (spritedata==0x1e) || (spritedata==0x2e))
 					{
 						/* BUG in sprite chip, these colours are always normal intensity */
-						video_renderline[x] = spritedata | 0x4000;
-						video_renderline[x] |= 0x10000; // mark as sprite pixel
+						m_video_renderline[x] = spritedata | 0x4000;
+						m_video_renderline[x] |= 0x10000; // mark as sprite pixel
 					}
 					else if (spritedata==0x3e)
 					{
 						/* Everything below this is half colour, mark with 0x8000 to mark highlight' */
-						video_renderline[x] = video_renderline[x]|0x8000; // spiderwebs..
+						m_video_renderline[x] = m_video_renderline[x]|0x8000; // spiderwebs..
 					}
 					else if (spritedata==0x3f)
 					{
 						/* This is a Shadow operator, but everything below is already low pri, no effect */
-						video_renderline[x] = video_renderline[x]|0x2000;
+						m_video_renderline[x] = m_video_renderline[x]|0x2000;
 
 					}
 					else
 					{
-						video_renderline[x] = spritedata;
-						video_renderline[x] |= 0x10000; // mark as sprite pixel
+						m_video_renderline[x] = spritedata;
+						m_video_renderline[x] |= 0x10000; // mark as sprite pixel
 					}
 
 				}
@@ -8486,23 +8566,23 @@ static void genesis_render_videoline_to_videobuffer(int scanline)
 			{
 				/* Normal Processing */
 				int dat;
-				dat = highpri_renderline[x];
+				dat = m_highpri_renderline[x];
 
 				if (dat&0x80)
 				{
-					 if (dat&0x0f) video_renderline[x] = highpri_renderline[x]&0x3f;
+					 if (dat&0x0f) m_video_renderline[x] = m_highpri_renderline[x]&0x3f;
 				}
 			}
 			else
 			{
 				/* Shadow / Highlight Mode */
 				int dat;
-				dat = highpri_renderline[x];
+				dat = m_highpri_renderline[x];
 
 				if (dat&0x80)
 				{
-					 if (dat&0x0f) video_renderline[x] = (highpri_renderline[x]&0x3f) | 0x4000;
-					 else video_renderline[x] = video_renderline[x] | 0x4000; // set 'normal'
+					 if (dat&0x0f) m_video_renderline[x] = (m_highpri_renderline[x]&0x3f) | 0x4000;
+					 else m_video_renderline[x] = m_video_renderline[x] | 0x4000; // set 'normal'
 				}
 			}
 		}
@@ -8513,33 +8593,33 @@ static void genesis_render_videoline_to_videobuffer(int scanline)
 			if (!MEGADRIVE_REG0C_SHADOW_HIGLIGHT)
 			{
 				/* Normal */
-				if (sprite_renderline[x+128] & 0x80)
+				if (m_sprite_renderline[x+128] & 0x80)
 				{
-					video_renderline[x] = sprite_renderline[x+128]&0x3f;
-					video_renderline[x] |= 0x10000; // mark as sprite pixel
+					m_video_renderline[x] = m_sprite_renderline[x+128]&0x3f;
+					m_video_renderline[x] |= 0x10000; // mark as sprite pixel
 				}
 			}
 			else
 			{
-				if (sprite_renderline[x+128] & 0x80)
+				if (m_sprite_renderline[x+128] & 0x80)
 				{
 					UINT8 spritedata;
-					spritedata = sprite_renderline[x+128]&0x3f;
+					spritedata = m_sprite_renderline[x+128]&0x3f;
 
 					if (spritedata==0x3e)
 					{
 						/* set flag 0x8000 to indicate highlight */
-						video_renderline[x] = video_renderline[x]|0x8000;
+						m_video_renderline[x] = m_video_renderline[x]|0x8000;
 					}
 					else if (spritedata==0x3f)
 					{
 						/* This is a Shadow operator set shadow bit */
-						video_renderline[x] = video_renderline[x]|0x2000;
+						m_video_renderline[x] = m_video_renderline[x]|0x2000;
 					}
 					else
 					{
-						video_renderline[x] = spritedata | 0x4000;
-						video_renderline[x] |= 0x10000; // mark as sprite pixel
+						m_video_renderline[x] = spritedata | 0x4000;
+						m_video_renderline[x] |= 0x10000; // mark as sprite pixel
 					}
 				}
 			}
@@ -8549,11 +8629,11 @@ static void genesis_render_videoline_to_videobuffer(int scanline)
 static UINT32 _32x_linerender[320+258]; // tmp buffer (bigger than it needs to be to simplify RLE decode)
 
 /* This converts our render buffer to real screen colours */
-static void genesis_render_videobuffer_to_screenbuffer(running_machine &machine, int scanline)
+void sega_genesis_vdp_device::render_videobuffer_to_screenbuffer(int scanline)
 {
 	UINT16*lineptr;
 	int x;
-	lineptr = BITMAP_ADDR16(render_bitmap, scanline, 0);
+	lineptr = BITMAP_ADDR16(m_render_bitmap, scanline, 0);
 
 	/* render 32x output to a buffer */
 	if (_32x_is_connected && (_32x_displaymode != 0))
@@ -8667,7 +8747,7 @@ static void genesis_render_videobuffer_to_screenbuffer(running_machine &machine,
 		for (x=0;x<320;x++)
 		{
 			UINT32 dat;
-			dat = video_renderline[x];
+			dat = m_video_renderline[x];
 			int drawn = 0;
 
 			// low priority 32x - if it's the bg pen, we have a 32x, and it's display is enabled...
@@ -8695,9 +8775,9 @@ static void genesis_render_videobuffer_to_screenbuffer(running_machine &machine,
 			if (drawn==0)
 			{
 				if (dat&0x10000)
-					lineptr[x] = megadrive_vdp_palette_lookup_sprite[(dat&0x0f) | segac2_sp_pal_lookup[(dat&0x30)>>4]];
+					lineptr[x] = m_palette_lookup_sprite[(dat&0x0f) | m_segac2_sp_pal_lookup[(dat&0x30)>>4]];
 				else
-					lineptr[x] = megadrive_vdp_palette_lookup[(dat&0x0f) | segac2_bg_pal_lookup[(dat&0x30)>>4]];
+					lineptr[x] = m_palette_lookup[(dat&0x0f) | m_segac2_bg_pal_lookup[(dat&0x30)>>4]];
 			}
 
 
@@ -8710,7 +8790,7 @@ static void genesis_render_videobuffer_to_screenbuffer(running_machine &machine,
 		for (x=0;x<320;x++)
 		{
 			UINT32 dat;
-			dat = video_renderline[x];
+			dat = m_video_renderline[x];
 
 			int drawn = 0;
 
@@ -8747,23 +8827,23 @@ static void genesis_render_videobuffer_to_screenbuffer(running_machine &machine,
 					case 0x10000: // (sprite) low priority, no shadow sprite, no highlight = shadow
 					case 0x12000: // (sprite) low priority, shadow sprite, no highlight = shadow
 					case 0x16000: // (sprite) normal pri,   shadow sprite, no highlight = shadow?
-						lineptr[x] = megadrive_vdp_palette_lookup_shadow[(dat&0x0f)  | segac2_bg_pal_lookup[(dat&0x30)>>4]];
+						lineptr[x] = m_palette_lookup_shadow[(dat&0x0f)  | m_segac2_bg_pal_lookup[(dat&0x30)>>4]];
 						break;
 
 					case 0x4000: // normal pri, no shadow sprite, no highlight = normal;
 					case 0x8000: // low pri, highlight sprite = normal;
-						lineptr[x] = megadrive_vdp_palette_lookup[(dat&0x0f)  | segac2_bg_pal_lookup[(dat&0x30)>>4]];
+						lineptr[x] = m_palette_lookup[(dat&0x0f)  | m_segac2_bg_pal_lookup[(dat&0x30)>>4]];
 						break;
 
 					case 0x14000: // (sprite) normal pri, no shadow sprite, no highlight = normal;
 					case 0x18000: // (sprite) low pri, highlight sprite = normal;
-						lineptr[x] = megadrive_vdp_palette_lookup_sprite[(dat&0x0f)  | segac2_sp_pal_lookup[(dat&0x30)>>4]];
+						lineptr[x] = m_palette_lookup_sprite[(dat&0x0f)  | m_segac2_sp_pal_lookup[(dat&0x30)>>4]];
 						break;
 
 
 					case 0x0c000: // normal pri, highlight set = highlight?
 					case 0x1c000: // (sprite) normal pri, highlight set = highlight?
-						lineptr[x] = megadrive_vdp_palette_lookup_highlight[(dat&0x0f) | segac2_bg_pal_lookup[(dat&0x30)>>4]];
+						lineptr[x] = m_palette_lookup_highlight[(dat&0x0f) | m_segac2_bg_pal_lookup[(dat&0x30)>>4]];
 						break;
 
 					case 0x0a000: // shadow set, highlight set - not possible
@@ -8771,7 +8851,7 @@ static void genesis_render_videobuffer_to_screenbuffer(running_machine &machine,
 					case 0x1a000: // (sprite)shadow set, highlight set - not possible
 					case 0x1e000: // (sprite)shadow set, highlight set, normal set, not possible
 					default:
-						lineptr[x] = machine.rand()&0x3f;
+						lineptr[x] = machine().rand()&0x3f;
 					break;
 				}
 			}
@@ -8802,15 +8882,15 @@ static void genesis_render_videobuffer_to_screenbuffer(running_machine &machine,
 	}
 }
 
-static void genesis_render_scanline(running_machine &machine, int scanline)
+void sega_genesis_vdp_device::render_scanline(int scanline)
 {
 	//if (MEGADRIVE_REG01_DMA_ENABLE==0) mame_printf_debug("off\n");
-	genesis_render_spriteline_to_spritebuffer(genesis_scanline_counter);
-	genesis_render_videoline_to_videobuffer(scanline);
-	genesis_render_videobuffer_to_screenbuffer(machine, scanline);
+	render_spriteline_to_spritebuffer(scanline);
+	render_videoline_to_videobuffer(scanline);
+	render_videobuffer_to_screenbuffer(scanline);
 }
 
-INLINE UINT16 get_hposition(void)
+UINT16 sega_genesis_vdp_device::get_hposition()
 {
 //  static int lowest = 99999;
 //  static int highest = -99999;
@@ -8818,21 +8898,21 @@ INLINE UINT16 get_hposition(void)
 	attotime time_elapsed_since_scanline_timer;
 	UINT16 value4;
 
-	time_elapsed_since_scanline_timer = scanline_timer->time_elapsed();
+	time_elapsed_since_scanline_timer = m_scanline_timer->time_elapsed();
 
-	if (time_elapsed_since_scanline_timer.attoseconds<(ATTOSECONDS_PER_SECOND/megadriv_framerate /megadrive_total_scanlines))
+	if (time_elapsed_since_scanline_timer.attoseconds<(ATTOSECONDS_PER_SECOND/m_framerate /m_total_scanlines))
 	{
-		value4 = (UINT16)(megadrive_max_hposition*((double)(time_elapsed_since_scanline_timer.attoseconds) / (double)(ATTOSECONDS_PER_SECOND/megadriv_framerate /megadrive_total_scanlines)));
+		value4 = (UINT16)(m_max_hposition*((double)(time_elapsed_since_scanline_timer.attoseconds) / (double)(ATTOSECONDS_PER_SECOND/m_framerate /m_total_scanlines)));
 	}
 	else /* in some cases (probably due to rounding errors) we get some stupid results (the odd huge value where the time elapsed is much higher than the scanline time??!).. hopefully by clamping the result to the maximum we limit errors */
 	{
-		value4 = megadrive_max_hposition;
+		value4 = m_max_hposition;
 	}
 
 //  if (value4>highest) highest = value4;
 //  if (value4<lowest) lowest = value4;
 
-	//mame_printf_debug("%d low %d high %d scancounter %d\n", value4, lowest, highest,genesis_scanline_counter);
+	//mame_printf_debug("%d low %d high %d scancounter %d\n", value4, lowest, highest,m_scanline_counter);
 
 	return value4;
 }
@@ -9104,18 +9184,56 @@ INLINE UINT16 get_hposition(void)
      ---------- cycles 127840, 003b363e ba41aaaa (End of frame / start of next)
 */
 
-static int irq4counter;
+void *sega_genesis_vdp_device::render_line_callback(void *param, int threadid)
+{
+	render_job *job = (render_job *)param;
+	job->m_vdp->render_scanline(job->m_scanline);
+	return NULL;
+}
+
+void sega_genesis_vdp_device::sync_render()
+{
+	if (m_render_pending != 0)
+	{
+		/* 10 seconds should be enough for a few scanlines! */
+		if (!osd_work_queue_wait(m_render_queue, osd_ticks_per_second() * 10))
+			osd_break_into_debugger("Deferred VDP render never completed!");
+		m_render_pending = 0;
+	}
+}
 
-static timer_device* render_timer;
+/* called before any CPU write that may change what the renderer reads */
+void sega_genesis_vdp_device::render_barrier()
+{
+	if (m_scanline_counter >= 0 && m_scanline_counter < m_visible_scanlines)
+		m_raster_writes++;
+	sync_render();
+}
 
-static TIMER_DEVICE_CALLBACK( render_timer_callback )
+void sega_genesis_vdp_device::handle_render_timer()
 {
-	if (genesis_scanline_counter>=0 && genesis_scanline_counter<megadrive_visible_scanlines)
+	if (m_scanline_counter>=0 && m_scanline_counter<m_visible_scanlines)
 	{
-		genesis_render_scanline(timer.machine(), genesis_scanline_counter);
+		if (m_render_deferred)
+		{
+			render_job *job = &m_render_jobs[m_scanline_counter];
+
+			assert(m_scanline_counter < ARRAY_LENGTH(m_render_jobs));
+			job->m_vdp = this;
+			job->m_scanline = m_scanline_counter;
+			osd_work_item_queue(m_render_queue, render_line_callback, job, WORK_ITEM_FLAG_AUTO_RELEASE);
+			m_render_pending++;
+		}
+		else
+			render_scanline(m_scanline_counter);
 	}
 }
 
+static TIMER_DEVICE_CALLBACK( render_timer_callback )
+{
+	downcast<sega_genesis_vdp_device *>(timer.owner())->handle_render_timer();
+}
+
 void _32x_check_irqs(running_machine& machine)
 {
 
@@ -9128,13 +9246,13 @@ void _32x_check_irqs(running_machine& machine)
 
 
 
-static TIMER_DEVICE_CALLBACK( scanline_timer_callback )
+void sega_genesis_vdp_device::handle_scanline_timer()
 {
 	/* This function is called at the very start of every scanline starting at the very
        top-left of the screen.  The first scanline is scanline 0 (we set scanline to -1 in
        VIDEO_EOF) */
 
-	timer.machine().scheduler().synchronize();
+	machine().scheduler().synchronize();
 	/* Compensate for some rounding errors
 
        When the counter reaches 261 we should have reached the end of the frame, however due
@@ -9142,26 +9260,26 @@ static TIMER_DEVICE_CALLBACK( scanline_timer_callback )
        still in the previous scanline for now.
     */
 
-	if (genesis_scanline_counter!=(megadrive_total_scanlines-1))
+	if (m_scanline_counter!=(m_total_scanlines-1))
 	{
-		genesis_scanline_counter++;
-//      mame_printf_debug("scanline %d\n",genesis_scanline_counter);
-		scanline_timer->adjust(attotime::from_hz(megadriv_framerate) / megadrive_total_scanlines);
-		render_timer->adjust(attotime::from_usec(1));
+		m_scanline_counter++;
+//      mame_printf_debug("scanline %d\n",m_scanline_counter);
+		m_scanline_timer->adjust(attotime::from_hz(m_framerate) / m_total_scanlines);
+		m_render_timer->adjust(attotime::from_usec(1));
 
-		if (genesis_scanline_counter==megadrive_irq6_scanline )
+		if (m_scanline_counter==m_irq6_scanline )
 		{
-		//  mame_printf_debug("x %d",genesis_scanline_counter);
-			irq6_on_timer->adjust(attotime::from_usec(6));
-			megadrive_irq6_pending = 1;
-			megadrive_vblank_flag = 1;
+		//  mame_printf_debug("x %d",m_scanline_counter);
+			m_irq6_on_timer->adjust(attotime::from_usec(6));
+			m_irq6_pending = 1;
+			m_vblank_flag = 1;
 
 			// 32x interrupt!
 			if (_32x_is_connected)
 			{
 				sh2_master_vint_pending = 1;
 				sh2_slave_vint_pending = 1;
-				_32x_check_irqs(timer.machine());
+				_32x_check_irqs(machine());
 			}
 
 		}
@@ -9171,34 +9289,34 @@ static TIMER_DEVICE_CALLBACK( scanline_timer_callback )
 		_32x_check_framebuffer_swap();
 
 
-	//  if (genesis_scanline_counter==0) irq4counter = MEGADRIVE_REG0A_HINT_VALUE;
-		// irq4counter = MEGADRIVE_REG0A_HINT_VALUE;
+	//  if (m_scanline_counter==0) m_irq4counter = MEGADRIVE_REG0A_HINT_VALUE;
+		// m_irq4counter = MEGADRIVE_REG0A_HINT_VALUE;
 
-		if (genesis_scanline_counter<=224)
+		if (m_scanline_counter<=224)
 		{
-			irq4counter--;
+			m_irq4counter--;
 
-			if (irq4counter==-1)
+			if (m_irq4counter==-1)
 			{
-				if (megadrive_imode==3) irq4counter = MEGADRIVE_REG0A_HINT_VALUE*2;
-				else irq4counter=MEGADRIVE_REG0A_HINT_VALUE;
+				if (m_imode==3) m_irq4counter = MEGADRIVE_REG0A_HINT_VALUE*2;
+				else m_irq4counter=MEGADRIVE_REG0A_HINT_VALUE;
 
-				megadrive_irq4_pending = 1;
+				m_irq4_pending = 1;
 
 				if (MEGADRIVE_REG0_IRQ4_ENABLE)
 				{
-					irq4_on_timer->adjust(attotime::from_usec(1));
-					//mame_printf_debug("irq4 on scanline %d reload %d\n",genesis_scanline_counter,MEGADRIVE_REG0A_HINT_VALUE);
+					m_irq4_on_timer->adjust(attotime::from_usec(1));
+					//mame_printf_debug("irq4 on scanline %d reload %d\n",m_scanline_counter,MEGADRIVE_REG0A_HINT_VALUE);
 				}
 			}
 		}
 		else
 		{
-			if (megadrive_imode==3) irq4counter = MEGADRIVE_REG0A_HINT_VALUE*2;
-			else irq4counter=MEGADRIVE_REG0A_HINT_VALUE;
+			if (m_imode==3) m_irq4counter = MEGADRIVE_REG0A_HINT_VALUE*2;
+			else m_irq4counter=MEGADRIVE_REG0A_HINT_VALUE;
 		}
 
-		//if (genesis_scanline_counter==0) irq4_on_timer->adjust(attotime::from_usec(2));
+		//if (m_scanline_counter==0) m_irq4_on_timer->adjust(attotime::from_usec(2));
 
 		if(_32x_is_connected)
 		{
@@ -9208,7 +9326,7 @@ static TIMER_DEVICE_CALLBACK( scanline_timer_callback )
 			{
 				_32x_hcount_compare_val = -1;
 
-				if(genesis_scanline_counter < 224 || sh2_hint_in_vbl)
+				if(m_scanline_counter < 224 || sh2_hint_in_vbl)
 				{
 					if(sh2_master_hint_enable) { device_set_input_line(_32x_master_cpu,SH2_HINT_IRQ_LEVEL,ASSERT_LINE); }
 					if(sh2_slave_hint_enable) { device_set_input_line(_32x_slave_cpu,SH2_HINT_IRQ_LEVEL,ASSERT_LINE); }
@@ -9217,41 +9335,51 @@ static TIMER_DEVICE_CALLBACK( scanline_timer_callback )
 		}
 
 
-		if (timer.machine().device("genesis_snd_z80") != NULL)
+		if (machine().device("genesis_snd_z80") != NULL)
 		{
-			if (genesis_scanline_counter == megadrive_z80irq_scanline)
+			if (m_scanline_counter == m_z80irq_scanline)
 			{
 				if ((genz80.z80_has_bus == 1) && (genz80.z80_is_reset == 0))
-					cputag_set_input_line(timer.machine(), "genesis_snd_z80", 0, HOLD_LINE);
+					cputag_set_input_line(machine(), "genesis_snd_z80", 0, HOLD_LINE);
 			}
-			if (genesis_scanline_counter == megadrive_z80irq_scanline + 1)
+			if (m_scanline_counter == m_z80irq_scanline + 1)
 			{
-				cputag_set_input_line(timer.machine(), "genesis_snd_z80", 0, CLEAR_LINE);
+				cputag_set_input_line(machine(), "genesis_snd_z80", 0, CLEAR_LINE);
 			}
 		}
 
 	}
 	else /* pretend we're still on the same scanline to compensate for rounding errors */
 	{
-		genesis_scanline_counter = megadrive_total_scanlines - 1;
+		m_scanline_counter = m_total_scanlines - 1;
 	}
 
 }
 
-static TIMER_DEVICE_CALLBACK( irq6_on_callback )
+static TIMER_DEVICE_CALLBACK( scanline_timer_callback )
+{
+	downcast<sega_genesis_vdp_device *>(timer.owner())->handle_scanline_timer();
+}
+
+void sega_genesis_vdp_device::handle_irq6_timer()
 {
-	//mame_printf_debug("irq6 active on %d\n",genesis_scanline_counter);
+	//mame_printf_debug("irq6 active on %d\n",m_scanline_counter);
 
 	{
-//      megadrive_irq6_pending = 1;
+//      m_irq6_pending = 1;
 		if (MEGADRIVE_REG01_IRQ6_ENABLE || genesis_always_irq6)
-			cputag_set_input_line(timer.machine(), "maincpu", 6, HOLD_LINE);
+			cputag_set_input_line(machine(), "maincpu", 6, HOLD_LINE);
 	}
 }
 
+static TIMER_DEVICE_CALLBACK( irq6_on_callback )
+{
+	downcast<sega_genesis_vdp_device *>(timer.owner())->handle_irq6_timer();
+}
+
 static TIMER_DEVICE_CALLBACK( irq4_on_callback )
 {
-	//mame_printf_debug("irq4 active on %d\n",genesis_scanline_counter);
+	//mame_printf_debug("irq4 active on %d\n",m_scanline_counter);
 	cputag_set_input_line(timer.machine(), "maincpu", 4, HOLD_LINE);
 }
 
@@ -9269,6 +9397,10 @@ MACHINE_START( megadriv )
 
 MACHINE_RESET( megadriv )
 {
+	sega_genesis_vdp_device *vdp = megadrive_vdp(machine);
+
+	vdp->sync_render();
+
 	/* default state of z80 = reset, with bus */
 	mame_printf_debug("Resetting Megadrive / Genesis\n");
 
@@ -9278,33 +9410,33 @@ MACHINE_RESET( megadriv )
 		case 1: // US
 		megadrive_region_export = 1;
 		megadrive_region_pal = 0;
-		megadriv_framerate = 60;
+		vdp->set_framerate(60);
 		mame_printf_debug("Using Region = US\n");
 		break;
 
 		case 2: // JAPAN
 		megadrive_region_export = 0;
 		megadrive_region_pal = 0;
-		megadriv_framerate = 60;
+		vdp->set_framerate(60);
 		mame_printf_debug("Using Region = JAPAN\n");
 		break;
 
 		case 3: // EUROPE
 		megadrive_region_export = 1;
 		megadrive_region_pal = 1;
-		megadriv_framerate = 50;
+		vdp->set_framerate(50);
 		mame_printf_debug("Using Region = EUROPE\n");
 		break;
 
 		case 0: // as chosen by driver
 		megadrive_region_export = hazemdchoice_megadrive_region_export;
 		megadrive_region_pal = hazemdchoice_megadrive_region_pal;
-		megadriv_framerate = hazemdchoice_megadriv_framerate;
+		vdp->set_framerate(hazemdchoice_megadriv_framerate);
 		mame_printf_debug("Using Region = DEFAULT\n");
 		break;
 
 		default:
-		megadriv_framerate = hazemdchoice_megadriv_framerate;
+		vdp->set_framerate(hazemdchoice_megadriv_framerate);
 		break;
 	}
 
@@ -9313,38 +9445,21 @@ MACHINE_RESET( megadriv )
 		genz80.z80_is_reset = 1;
 		genz80.z80_has_bus = 1;
 		genz80.z80_bank_addr = 0;
-		genesis_scanline_counter = -1;
 		machine.scheduler().timer_set( attotime::zero, FUNC(megadriv_z80_run_state ));
 	}
 
-	megadrive_imode = 0;
-
 	megadrive_reset_io(machine);
 
-	frame_timer = machine.device<timer_device>("frame_timer");
-	scanline_timer = machine.device<timer_device>("scanline_timer");
-	render_timer = machine.device<timer_device>("render_timer");
-
-	irq6_on_timer = machine.device<timer_device>("irq6_timer");
-	irq4_on_timer = machine.device<timer_device>("irq4_timer");
-
-	frame_timer->adjust(attotime::zero);
-	scanline_timer->adjust(attotime::zero);
+	vdp->reset_timing(machine.device("genesis_snd_z80") != NULL);
 
 	if (genesis_other_hacks)
 	{
-	//  set_refresh_rate(megadriv_framerate);
+	//  set_refresh_rate(vdp->framerate());
 	//  machine.device("maincpu")->set_clock_scale(0.9950f); /* Fatal Rewind is very fussy... (and doesn't work now anyway, so don't bother with this) */
 
-		memset(megadrive_ram,0x00,0x10000);
+		memset(machine.driver_data<md_base_state>()->m_megadrive_ram,0x00,0x10000);
 	}
 
-	irq4counter = -1;
-	megadrive_total_scanlines = 262;
-	megadrive_visible_scanlines = 224;
-	megadrive_irq6_scanline = 224;
-	megadrive_z80irq_scanline = 226;
-
 
 	/* if any of these extra CPUs exist, pause them until we actually turn them on */
 	if (_32x_master_cpu != NULL)
@@ -9376,9 +9491,31 @@ MACHINE_RESET( megadriv )
 	}
 }
 
-void megadriv_stop_scanline_timer(void)
+void sega_genesis_vdp_device::reset_timing(bool reset_scanline_counter)
+{
+	if (reset_scanline_counter)
+		m_scanline_counter = -1;
+
+	m_imode = 0;
+
+	m_frame_timer->adjust(attotime::zero);
+	m_scanline_timer->adjust(attotime::zero);
+
+	m_irq4counter = -1;
+	m_total_scanlines = 262;
+	m_visible_scanlines = 224;
+	m_irq6_scanline = 224;
+	m_z80irq_scanline = 226;
+}
+
+void sega_genesis_vdp_device::stop_scanline_timer()
+{
+	m_scanline_timer->reset();
+}
+
+void megadriv_stop_scanline_timer(running_machine &machine)
 {
-	scanline_timer->reset();
+	megadrive_vdp(machine)->stop_scanline_timer();
 }
 
 /*
@@ -9391,23 +9528,26 @@ void megadriv_stop_scanline_timer(void)
 
 /* VIDEO_EOF is used to resync the scanline counters */
 
-SCREEN_EOF(megadriv)
+void sega_genesis_vdp_device::handle_eof()
 {
 	rectangle visarea;
 	int scr_width = 320;
 
-	megadrive_vblank_flag = 0;
-	//megadrive_irq6_pending = 0; /* NO! (breaks warlock) */
+	/* VBLANK: join the frame, then decide how to render the next one; the 32X
+       composites from SH2-written framebuffers, so it always stays inline */
+	sync_render();
+	m_render_deferred = (m_render_queue != NULL && !_32x_is_connected && m_raster_writes <= MEGADRIVE_RASTER_WRITE_LIMIT);
+	m_raster_writes = 0;
 
-	/* Set it to -1 here, so it becomes 0 when the first timer kicks in */
-	genesis_scanline_counter = -1;
-	megadrive_sprite_collision=0;//? when to reset this ..
-	megadrive_imode = MEGADRIVE_REG0C_INTERLEAVE; // can't change mid-frame..
-	megadrive_imode_odd_frame^=1;
-//  cputag_set_input_line(machine, "genesis_snd_z80", 0, CLEAR_LINE); // if the z80 interrupt hasn't happened by now, clear it..
+	m_vblank_flag = 0;
+	//m_irq6_pending = 0; /* NO! (breaks warlock) */
 
-	if (input_port_read_safe(machine, "RESET", 0x00) & 0x01)
-		cputag_set_input_line(machine, "maincpu", INPUT_LINE_RESET, PULSE_LINE);
+	/* Set it to -1 here, so it becomes 0 when the first timer kicks in */
+	m_scanline_counter = -1;
+	m_sprite_collision=0;//? when to reset this ..
+	m_imode = MEGADRIVE_REG0C_INTERLEAVE; // can't change mid-frame..
+	m_imode_odd_frame^=1;
+//  cputag_set_input_line(machine(), "genesis_snd_z80", 0, CLEAR_LINE); // if the z80 interrupt hasn't happened by now, clear it..
 
 /*
 int megadrive_total_scanlines = 262;
@@ -9424,43 +9564,43 @@ int megadrive_z80irq_hpos = 320;
 		if (!megadrive_region_pal)
 		{
 			/* this is invalid! */
-			megadrive_visible_scanlines = 240;
-			megadrive_total_scanlines = 262;
-			megadrive_irq6_scanline = 240;
-			megadrive_z80irq_scanline = 240;
+			m_visible_scanlines = 240;
+			m_total_scanlines = 262;
+			m_irq6_scanline = 240;
+			m_z80irq_scanline = 240;
 		}
 		else
 		{
-			megadrive_visible_scanlines = 240;
-			megadrive_total_scanlines = 313;
-			megadrive_irq6_scanline = 240;
-			megadrive_z80irq_scanline = 240;
+			m_visible_scanlines = 240;
+			m_total_scanlines = 313;
+			m_irq6_scanline = 240;
+			m_z80irq_scanline = 240;
 		}
 	}
 	else
 	{
 		if (!megadrive_region_pal)
 		{
-			megadrive_visible_scanlines = 224;
-			megadrive_total_scanlines=262;
-			megadrive_irq6_scanline = 224;
-			megadrive_z80irq_scanline = 224;
+			m_visible_scanlines = 224;
+			m_total_scanlines=262;
+			m_irq6_scanline = 224;
+			m_z80irq_scanline = 224;
 		}
 		else
 		{
-			megadrive_visible_scanlines = 224;
-			megadrive_total_scanlines=313;
-			megadrive_irq6_scanline = 224;
-			megadrive_z80irq_scanline = 224;
+			m_visible_scanlines = 224;
+			m_total_scanlines=313;
+			m_irq6_scanline = 224;
+			m_z80irq_scanline = 224;
 		}
 	}
 
-	if (megadrive_imode==3)
+	if (m_imode==3)
 	{
-		megadrive_visible_scanlines<<=1;
-		megadrive_total_scanlines<<=1;
-		megadrive_irq6_scanline <<=1;
-		megadrive_z80irq_scanline <<=1;
+		m_visible_scanlines<<=1;
+		m_total_scanlines<<=1;
+		m_irq6_scanline <<=1;
+		m_z80irq_scanline <<=1;
 	}
 
 
@@ -9468,19 +9608,19 @@ int megadrive_z80irq_hpos = 320;
 	switch (MEGADRIVE_REG0C_RS0 | (MEGADRIVE_REG0C_RS1 << 1))
 	{
 		 /* note, add 240 mode + init new timings! */
-		case 0:scr_width = 256;break;// configure_screen(0, 256-1, megadrive_visible_scanlines-1,(double)megadriv_framerate); break;
-		case 1:scr_width = 256;break;// configure_screen(0, 256-1, megadrive_visible_scanlines-1,(double)megadriv_framerate); mame_printf_debug("invalid screenmode!\n"); break;
-		case 2:scr_width = 320;break;// configure_screen(0, 320-1, megadrive_visible_scanlines-1,(double)megadriv_framerate); break; /* technically invalid, but used in rare cases */
-		case 3:scr_width = 320;break;// configure_screen(0, 320-1, megadrive_visible_scanlines-1,(double)megadriv_framerate); break;
+		case 0:scr_width = 256;break;// configure_screen(0, 256-1, m_visible_scanlines-1,(double)m_framerate); break;
+		case 1:scr_width = 256;break;// configure_screen(0, 256-1, m_visible_scanlines-1,(double)m_framerate); mame_printf_debug("invalid screenmode!\n"); break;
+		case 2:scr_width = 320;break;// configure_screen(0, 320-1, m_visible_scanlines-1,(double)m_framerate); break; /* technically invalid, but used in rare cases */
+		case 3:scr_width = 320;break;// configure_screen(0, 320-1, m_visible_scanlines-1,(double)m_framerate); break;
 	}
-//  mame_printf_debug("my mode %02x", megadrive_vdp_register[0x0c]);
+//  mame_printf_debug("my mode %02x", m_vdp_register[0x0c]);
 
 	visarea.min_x = 0;
 	visarea.max_x = scr_width-1;
 	visarea.min_y = 0;
-	visarea.max_y = megadrive_visible_scanlines-1;
+	visarea.max_y = m_visible_scanlines-1;
 
-	machine.primary_screen->configure(scr_width, megadrive_visible_scanlines, visarea, HZ_TO_ATTOSECONDS(megadriv_framerate));
+	machine().primary_screen->configure(scr_width, m_visible_scanlines, visarea, HZ_TO_ATTOSECONDS(m_framerate));
 
 	if (0)
 	{
@@ -9488,21 +9628,29 @@ int megadrive_z80irq_hpos = 320;
 //      UINT64 frametime;
 
 	//  /* reference */
-//      frametime = ATTOSECONDS_PER_SECOND/megadriv_framerate;
+//      frametime = ATTOSECONDS_PER_SECOND/m_framerate;
 
-		//time_elapsed_since_crap = frame_timer->time_elapsed();
-		//xxx = machine.device<cpudevice>("maincpu")->attotime_to_cycles(time_elapsed_since_crap);
+		//time_elapsed_since_crap = m_frame_timer->time_elapsed();
+		//xxx = machine().device<cpudevice>("maincpu")->attotime_to_cycles(time_elapsed_since_crap);
 		//mame_printf_debug("---------- cycles %d, %08x %08x\n",xxx, (UINT32)(time_elapsed_since_crap.attoseconds>>32),(UINT32)(time_elapsed_since_crap.attoseconds&0xffffffff));
 		//mame_printf_debug("---------- framet %d, %08x %08x\n",xxx, (UINT32)(frametime>>32),(UINT32)(frametime&0xffffffff));
-		frame_timer->adjust(attotime::zero);
+		m_frame_timer->adjust(attotime::zero);
 	}
 
-	scanline_timer->adjust(attotime::zero);
+	m_scanline_timer->adjust(attotime::zero);
 
 	if(_32x_is_connected)
 		_32x_hcount_compare_val = -1;
 }
 
+SCREEN_EOF(megadriv)
+{
+	if (input_port_read_safe(machine, "RESET", 0x00) & 0x01)
+		cputag_set_input_line(machine, "maincpu", INPUT_LINE_RESET, PULSE_LINE);
+
+	megadrive_vdp(machine)->handle_eof();
+}
+
 
 UINT16* megadriv_backupram;
 int megadriv_backupram_length;
@@ -9532,7 +9680,7 @@ static NVRAM_HANDLER( megadriv )
 #endif
 
 
-MACHINE_CONFIG_FRAGMENT( megadriv_timers )
+static MACHINE_CONFIG_FRAGMENT( sega_genesis_vdp )
 	MCFG_TIMER_ADD("frame_timer", frame_timer_callback)
 	MCFG_TIMER_ADD("scanline_timer", scanline_timer_callback)
 	MCFG_TIMER_ADD("render_timer", render_timer_callback)
@@ -9540,6 +9688,15 @@ MACHINE_CONFIG_FRAGMENT( megadriv_timers )
 	MCFG_TIMER_ADD("irq4_timer", irq4_on_callback)
 MACHINE_CONFIG_END
 
+machine_config_constructor sega_genesis_vdp_device::device_mconfig_additions() const
+{
+	return MACHINE_CONFIG_NAME( sega_genesis_vdp );
+}
+
+MACHINE_CONFIG_FRAGMENT( megadriv_timers )
+	MCFG_SEGA_GEN_VDP_ADD("gen_vdp")
+MACHINE_CONFIG_END
+
 
 MACHINE_CONFIG_FRAGMENT( md_ntsc )
 	MCFG_CPU_ADD("maincpu", M68000, MASTER_CLOCK_NTSC / 7) /* 7.67 MHz */
@@ -9637,7 +9794,7 @@ MACHINE_CONFIG_FRAGMENT( md_pal )
 	MCFG_SOUND_ROUTE(ALL_OUTPUTS, "rspeaker",0.25) /* 3.58 MHz */
 MACHINE_CONFIG_END
 
-MACHINE_CONFIG_START( megadpal, driver_device )
+MACHINE_CONFIG_START( megadpal, md_cons_state )
 	MCFG_FRAGMENT_ADD(md_pal)
 MACHINE_CONFIG_END
 
@@ -9827,19 +9984,24 @@ MACHINE_CONFIG_DERIVED( genesis_32x_scd, genesis_32x )
 MACHINE_CONFIG_END
 
 
-/* Callback when the genesis enters interrupt code */
-static IRQ_CALLBACK(genesis_int_callback)
+void sega_genesis_vdp_device::irq_acknowledge(int irqline)
 {
 	if (irqline==4)
 	{
-		megadrive_irq4_pending = 0;
+		m_irq4_pending = 0;
 	}
 
 	if (irqline==6)
 	{
-		megadrive_irq6_pending = 0;
+		m_irq6_pending = 0;
 	//  mame_printf_debug("clear pending!\n");
 	}
+}
+
+/* Callback when the genesis enters interrupt code */
+static IRQ_CALLBACK(genesis_int_callback)
+{
+	megadrive_vdp(device->machine())->irq_acknowledge(irqline);
 
 	return (0x60+irqline*4)/4; // vector address
 }
@@ -9912,7 +10074,6 @@ static void megadriv_init_common(running_machine &machine)
 	megadriv_backupram = NULL;
 	megadriv_backupram_length = 0;
 
-	vdp_get_word_from_68k_mem = vdp_get_word_from_68k_mem_default;
 
 	m68k_set_tas_callback(machine.device("maincpu"), megadriv_tas_callback);
 
@@ -9960,7 +10121,7 @@ static void megadriv_init_common(running_machine &machine)
 
 DRIVER_INIT( megadriv_c2 )
 {
-	genvdp_use_cram = 0;
+	megadrive_vdp(machine)->set_use_cram(0);
 	genesis_always_irq6 = 1;
 	genesis_other_hacks = 0;
 
@@ -9974,7 +10135,7 @@ DRIVER_INIT( megadriv_c2 )
 
 DRIVER_INIT( megadriv )
 {
-	genvdp_use_cram = 1;
+	megadrive_vdp(machine)->set_use_cram(1);
 	genesis_always_irq6 = 0;
 	genesis_other_hacks = 1;
 
@@ -9986,7 +10147,7 @@ DRIVER_INIT( megadriv )
 
 DRIVER_INIT( megadrij )
 {
-	genvdp_use_cram = 1;
+	megadrive_vdp(machine)->set_use_cram(1);
 	genesis_always_irq6 = 0;
 	genesis_other_hacks = 1;
 
@@ -9998,7 +10159,7 @@ DRIVER_INIT( megadrij )
 
 DRIVER_INIT( megadrie )
 {
-	genvdp_use_cram = 1;
+	megadrive_vdp(machine)->set_use_cram(1);
 	genesis_always_irq6 = 0;
 	genesis_other_hacks = 1;
 
@@ -287,6 +287,7 @@ struct _osd_directory_entry
 	const char *		name;			/* name of the entry */
 	osd_dir_entry_type	type;			/* type of the entry */
 	UINT64				size;			/* size of the entry */
+	UINT64				last_modified;	/* modification time, in OSD-defined units (0 if unknown) */
 };
 
 
@@ -72,7 +72,6 @@
 #define SDLOPTION_SCALEMODE				"scalemode"
 
 #define SDLOPTION_MULTITHREADING		"multithreading"
-#define SDLOPTION_BENCH					"bench"
 #define SDLOPTION_NUMPROCESSORS			"numprocessors"
 
 #define SDLOPTION_WAITVSYNC				"waitvsync"
@@ -159,7 +158,6 @@ public:
 	bool multithreading() const { return bool_value(SDLOPTION_MULTITHREADING); }
 	const char *numprocessors() const { return value(SDLOPTION_NUMPROCESSORS); }
 	bool video_fps() const { return bool_value(SDLOPTION_SDLVIDEOFPS); }
-	int bench() const { return int_value(SDLOPTION_BENCH); }
 
 	// video options
 	const char *video() const { return value(SDLOPTION_VIDEO); }
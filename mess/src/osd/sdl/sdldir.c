@@ -102,12 +102,14 @@ static osd_dir_entry_type get_attributes_stat(const char *file)
 }
 #endif
 
-static UINT64 osd_get_file_size(const char *file)
+static void osd_get_file_size_and_time(const char *file, UINT64 *size, UINT64 *last_modified)
 {
 	sdl_stat st;
+	*size = *last_modified = 0;
 	if(sdl_stat_fn(file, &st))
-		return 0;
-	return st.st_size;
+		return;
+	*size = st.st_size;
+	*last_modified = st.st_mtime;
 }
 
 //============================================================
@@ -197,7 +199,7 @@ const osd_directory_entry *osd_readdir(osd_directory *dir)
 	#else
 	dir->ent.type = get_attributes_stat(temp);
 	#endif
-	dir->ent.size = osd_get_file_size(temp);
+	osd_get_file_size_and_time(temp, &dir->ent.size, &dir->ent.last_modified);
 	osd_free(temp);
 	return &dir->ent;
 }
@@ -150,6 +150,7 @@ const osd_directory_entry *osd_readdir(osd_directory *dir)
 	dir->entry.name = utf8_from_tstring(dir->data.cFileName);
 	dir->entry.type = win_attributes_to_entry_type(dir->data.dwFileAttributes);
 	dir->entry.size = dir->data.nFileSizeLow | ((UINT64) dir->data.nFileSizeHigh << 32);
+	dir->entry.last_modified = dir->data.ftLastWriteTime.dwLowDateTime | ((UINT64) dir->data.ftLastWriteTime.dwHighDateTime << 32);
 	return (dir->entry.name != NULL) ? &dir->entry : NULL;
 }
 
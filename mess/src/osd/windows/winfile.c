@@ -454,6 +454,7 @@ osd_directory_entry *osd_stat(const char *path)
 	result->name = ((char *) result) + sizeof(*result);
 	result->type = win_attributes_to_entry_type(find_data.dwFileAttributes);
 	result->size = find_data.nFileSizeLow | ((UINT64) find_data.nFileSizeHigh << 32);
+	result->last_modified = find_data.ftLastWriteTime.dwLowDateTime | ((UINT64) find_data.ftLastWriteTime.dwHighDateTime << 32);
 
 done:
 	if (t_path != NULL)
@@ -58,7 +58,6 @@
 #define WINOPTION_MULTITHREADING		"multithreading"
 #define WINOPTION_NUMPROCESSORS			"numprocessors"
 #define WINOPTION_PROFILE				"profile"
-#define WINOPTION_BENCH					"bench"
 
 // video options
 #define WINOPTION_VIDEO					"video"
@@ -171,7 +170,6 @@ public:
 	bool multithreading() const { return bool_value(WINOPTION_MULTITHREADING); }
 	const char *numprocessors() const { return value(WINOPTION_NUMPROCESSORS); }
 	int profile() const { return int_value(WINOPTION_PROFILE); }
-	int bench() const { return int_value(WINOPTION_BENCH); }
 
 	// video options
 	const char *video() const { return value(WINOPTION_VIDEO); }
@@ -0,0 +1,376 @@
+#!/usr/bin/env python
+#
+# Writes the test cartridges that the golden runs boot from, so that the
+# systems that need no BIOS can be checked with nothing but what is in the
+# tree. Each one draws a picture that changes every frame and plays sound on
+# every sound chip the system has, so both hashes move all the time.
+#
+# Usage: mkcarts.py [<output directory>]
+#
+# The programs are assembled by hand below; the cartridges are written into
+# the public domain.
+#
+
+import os
+import struct
+import sys
+
+
+class Assembler(object):
+    """Collects bytes at an origin, with labels and patched branches."""
+
+    def __init__(self, origin):
+        self.origin = origin
+        self.data = bytearray()
+        self.labels = {}
+        self.fixups = []
+
+    def here(self):
+        return self.origin + len(self.data)
+
+    def label(self, name):
+        self.labels[name] = self.here()
+
+    def byte(self, *values):
+        for value in values:
+            self.data.append(value & 0xff)
+
+    def word(self, *values):
+        for value in values:
+            self.data += struct.pack('>H', value & 0xffff)
+
+    def long(self, *values):
+        for value in values:
+            self.data += struct.pack('>I', value & 0xffffffff)
+
+    def fixup(self, name, kind):
+        self.fixups.append((len(self.data), name, kind))
+
+    def link(self):
+        for offset, name, kind in self.fixups:
+            target = self.labels[name]
+            if kind == 'rel8':
+                # 6502 and Z80 relative branches count from the next instruction
+                disp = target - (self.origin + offset + 1)
+                assert -128 <= disp <= 127, name
+                self.data[offset] = disp & 0xff
+            elif kind == 'rel16':
+                # 68000 branches count from their extension word
+                disp = target - (self.origin + offset)
+                assert -32768 <= disp <= 32767, name
+                self.data[offset:offset + 2] = struct.pack('>H', disp & 0xffff)
+            elif kind == 'abs16le':
+                self.data[offset:offset + 2] = struct.pack('<H', target)
+        return self.data
+
+
+#-------------------------------------------------
+#   Atari 2600: a 4K cartridge that scrolls
+#   colour bars and a playfield, with a tone on
+#   channel 0 and noise on channel 1
+#-------------------------------------------------
+
+def atari2600():
+    VSYNC, VBLANK, WSYNC = 0x00, 0x01, 0x02
+    COLUPF, COLUBK, CTRLPF = 0x08, 0x09, 0x0a
+    PF1, PF2 = 0x0e, 0x0f
+    AUDC0, AUDC1, AUDF0, AUDF1, AUDV0, AUDV1 = 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a
+    FRAME = 0x80
+
+    a = Assembler(0xf000)
+    a.label('reset')
+    a.byte(0x78)                        # sei
+    a.byte(0xd8)                        # cld
+    a.byte(0xa2, 0x00)                  # ldx #0
+    a.byte(0x8a)                        # txa
+    a.label('clear')
+    a.byte(0x95, 0x00)                  # sta $00,x
+    a.byte(0xca)                        # dex
+    a.byte(0xd0); a.fixup('clear', 'rel8'); a.byte(0)  # bne clear
+    a.byte(0xa2, 0xff)                  # ldx #$ff
+    a.byte(0x9a)                        # txs
+    a.byte(0xa9, 0x01, 0x85, CTRLPF)    # reflected playfield
+    a.byte(0xa9, 0x04, 0x85, AUDC0)     # pure tone
+    a.byte(0xa9, 0x08, 0x85, AUDC1)     # white noise
+
+    a.label('frame')
+    a.byte(0xa9, 0x02)                  # lda #2
+    a.byte(0x85, VBLANK)
+    a.byte(0x85, VSYNC)
+    a.byte(0x85, WSYNC, 0x85, WSYNC, 0x85, WSYNC)
+    a.byte(0xa9, 0x00, 0x85, VSYNC)
+
+    # vertical blank: move the sound along with the frame counter
+    a.byte(0xe6, FRAME)                 # inc frame
+    a.byte(0xa5, FRAME)                 # lda frame
+    a.byte(0x4a, 0x4a)                  # lsr; lsr
+    a.byte(0x29, 0x1f, 0x85, AUDF0)     # and #$1f; sta audf0
+    a.byte(0x49, 0x1f, 0x85, AUDF1)     # eor #$1f; sta audf1
+    a.byte(0x29, 0x0f, 0x85, AUDV1)     # and #$0f; sta audv1
+    a.byte(0xa9, 0x08, 0x85, AUDV0)     # lda #8; sta audv0
+    a.byte(0xa5, FRAME, 0x85, PF1)      # playfield from the frame counter
+    a.byte(0x49, 0xff, 0x85, PF2)
+    a.byte(0xa2, 35)                    # ldx #35
+    a.label('vblank')
+    a.byte(0x85, WSYNC, 0xca, 0xd0); a.fixup('vblank', 'rel8'); a.byte(0)
+    a.byte(0xa9, 0x00, 0x85, VBLANK)
+
+    # picture: a new background colour on every line, offset by the frame
+    a.byte(0xa2, 192)                   # ldx #192
+    a.byte(0xa4, FRAME)                 # ldy frame
+    a.label('line')
+    a.byte(0x85, WSYNC)
+    a.byte(0x84, COLUBK)                # sty colubk
+    a.byte(0x86, COLUPF)                # stx colupf
+    a.byte(0xc8)                        # iny
+    a.byte(0xca)                        # dex
+    a.byte(0xd0); a.fixup('line', 'rel8'); a.byte(0)
+
+    # overscan
+    a.byte(0xa9, 0x02, 0x85, VBLANK)
+    a.byte(0xa2, 30)
+    a.label('overscan')
+    a.byte(0x85, WSYNC, 0xca, 0xd0); a.fixup('overscan', 'rel8'); a.byte(0)
+    a.byte(0x4c); a.fixup('frame', 'abs16le'); a.byte(0, 0)  # jmp frame
+
+    rom = a.link()
+    rom += bytearray(0x1000 - 4 - len(rom))
+    rom += struct.pack('<HH', 0xf000, 0xf000)   # reset and IRQ vectors
+    return rom
+
+
+#-------------------------------------------------
+#   Genesis: a 32K cartridge that scrolls two
+#   tiled planes and cycles the backdrop, holds
+#   an FM tone that it retunes every 32 frames,
+#   and leaves the Z80 running a PSG tone and
+#   noise sweep
+#-------------------------------------------------
+
+Z80_PROGRAM = 0x1000
+YM_TABLE = 0x1100
+VDP_TABLE = 0x1200
+PALETTE = 0x1300
+
+VDP_DATA, VDP_CTRL = 0xc00000, 0xc00004
+Z80_BUSREQ, Z80_RESET = 0xa11100, 0xa11200
+YM_ADDR, YM_DATA = 0xa04000, 0xa04001
+
+
+def genesis_z80():
+    PSG = 0x7f11
+    a = Assembler(0x0000)
+    a.byte(0xf3)                                    # di
+    a.byte(0x31, 0x00, 0x20)                        # ld sp,$2000
+    a.byte(0x3e, 0x90, 0x32, PSG & 0xff, PSG >> 8)  # tone 0 at full volume
+    a.byte(0x3e, 0xe4, 0x32, PSG & 0xff, PSG >> 8)  # white noise
+    a.byte(0x06, 0x00)                              # ld b,0
+    a.label('loop')
+    a.byte(0x78, 0xe6, 0x0f, 0xf6, 0xf0)            # noise volume from b
+    a.byte(0x32, PSG & 0xff, PSG >> 8)
+    a.byte(0x78, 0xe6, 0x0f, 0xf6, 0x80)            # tone 0 low bits from b
+    a.byte(0x32, PSG & 0xff, PSG >> 8)
+    a.byte(0x78, 0x0f, 0x0f, 0x0f, 0x0f)            # ld a,b; rrca x4
+    a.byte(0xe6, 0x0f, 0xf6, 0x10)                  # tone 0 high bits
+    a.byte(0x32, PSG & 0xff, PSG >> 8)
+    a.byte(0x04)                                    # inc b
+    a.byte(0x11, 0x00, 0x10)                        # ld de,$1000
+    a.label('delay')
+    a.byte(0x1b, 0x7a, 0xb3)                        # dec de; ld a,d; or e
+    a.byte(0x20); a.fixup('delay', 'rel8'); a.byte(0)
+    a.byte(0x18); a.fixup('loop', 'rel8'); a.byte(0)
+    return a.link()
+
+
+def genesis_68k():
+    a = Assembler(0x200)
+
+    def move_w_imm_abs(value, address):
+        a.word(0x33fc, value); a.long(address)
+
+    def move_l_imm_abs(value, address):
+        a.long(0x23fc0000 | (value >> 16)); a.word(value); a.long(address)
+
+    def bcc(opcode, name):
+        a.word(opcode); a.fixup(name, 'rel16'); a.word(0)
+
+    def dbra(reg, name):
+        a.word(0x51c8 | reg); a.fixup(name, 'rel16'); a.word(0)
+
+    a.word(0x46fc, 0x2700)                  # move.w #$2700,sr
+
+    # take the Z80 out of reset but keep its bus, then load its program
+    move_w_imm_abs(0x0100, Z80_BUSREQ)
+    move_w_imm_abs(0x0100, Z80_RESET)
+    a.word(0x41f9); a.long(Z80_PROGRAM)     # lea Z80_PROGRAM,a0
+    a.word(0x43f9); a.long(0xa00000)        # lea $a00000,a1
+    a.word(0x303c, len(genesis_z80()) - 1)  # move.w #len-1,d0
+    a.label('z80copy')
+    a.word(0x12d8)                          # move.b (a0)+,(a1)+
+    dbra(0, 'z80copy')
+
+    # set up the FM channel while we have the bus, then let the Z80 go
+    a.word(0x41f9); a.long(YM_TABLE)
+    a.word(0x303c, len(YM_REGISTERS) - 1)
+    a.label('ymloop')
+    a.word(0x13d8); a.long(YM_ADDR)         # move.b (a0)+,YM_ADDR
+    a.word(0x13d8); a.long(YM_DATA)         # move.b (a0)+,YM_DATA
+    dbra(0, 'ymloop')
+    move_w_imm_abs(0x0000, Z80_BUSREQ)
+
+    # VDP registers
+    a.word(0x41f9); a.long(VDP_TABLE)
+    a.word(0x303c, len(VDP_REGISTERS) - 1)
+    a.label('vdploop')
+    a.word(0x33d8); a.long(VDP_CTRL)        # move.w (a0)+,VDP_CTRL
+    dbra(0, 'vdploop')
+
+    # palette 0
+    move_l_imm_abs(0xc0000000, VDP_CTRL)
+    a.word(0x41f9); a.long(PALETTE)
+    a.word(0x700f)                          # moveq #15,d0
+    a.label('cramloop')
+    a.word(0x33d8); a.long(VDP_DATA)
+    dbra(0, 'cramloop')
+
+    # tile 1 uses every colour
+    move_l_imm_abs(0x40200000, VDP_CTRL)
+    a.word(0x323c, 0x1122)                  # move.w #$1122,d1
+    a.word(0x700f)
+    a.label('tileloop')
+    a.word(0x33c1); a.long(VDP_DATA)        # move.w d1,VDP_DATA
+    a.word(0x0641, 0x1111)                  # add.w #$1111,d1
+    dbra(0, 'tileloop')
+
+    # plane A at $c000: tile 1 in all four flips
+    move_l_imm_abs(0x40000003, VDP_CTRL)
+    a.word(0x7200)                          # moveq #0,d1
+    a.word(0x303c, 64 * 32 - 1)
+    a.label('planealoop')
+    a.word(0x3401)                          # move.w d1,d2
+    a.word(0x0242, 0x0003)                  # and.w #3,d2
+    a.word(0xe14a, 0xe74a)                  # lsl.w #8,d2; lsl.w #3,d2
+    a.word(0x0042, 0x0001)                  # or.w #1,d2
+    a.word(0x33c2); a.long(VDP_DATA)        # move.w d2,VDP_DATA
+    a.word(0x5241)                          # addq.w #1,d1
+    dbra(0, 'planealoop')
+
+    # plane B at $e000: tile 1 flipped vertically
+    move_l_imm_abs(0x60000003, VDP_CTRL)
+    a.word(0x303c, 64 * 32 - 1)
+    a.label('planebloop')
+    move_w_imm_abs(0x1001, VDP_DATA)
+    dbra(0, 'planebloop')
+
+    a.word(0x7e00)                          # moveq #0,d7
+
+    # once a frame, after the start of vertical blank
+    a.label('frame')
+    a.label('waitactive')
+    a.word(0x3039); a.long(VDP_CTRL)        # move.w VDP_CTRL,d0
+    a.word(0x0800, 0x0003)                  # btst #3,d0
+    bcc(0x6600, 'waitactive')               # bne
+    a.label('waitvblank')
+    a.word(0x3039); a.long(VDP_CTRL)
+    a.word(0x0800, 0x0003)
+    bcc(0x6700, 'waitvblank')               # beq
+    a.word(0x5247)                          # addq.w #1,d7
+
+    # backdrop colour
+    move_l_imm_abs(0xc0000000, VDP_CTRL)
+    a.word(0x3007)                          # move.w d7,d0
+    a.word(0x0240, 0x0eee)                  # and.w #$eee,d0
+    a.word(0x33c0); a.long(VDP_DATA)
+
+    # scroll plane A right and plane B left, and plane A down
+    move_l_imm_abs(0x7c000003, VDP_CTRL)
+    a.word(0x33c7); a.long(VDP_DATA)        # move.w d7,VDP_DATA
+    a.word(0x3007, 0x4440)                  # move.w d7,d0; neg.w d0
+    a.word(0x33c0); a.long(VDP_DATA)
+    move_l_imm_abs(0x40000010, VDP_CTRL)
+    a.word(0x3007, 0xe248)                  # move.w d7,d0; lsr.w #1,d0
+    a.word(0x33c0); a.long(VDP_DATA)
+
+    # every 32 frames, retune the FM channel
+    a.word(0x3007, 0x0240, 0x001f)          # move.w d7,d0; and.w #$1f,d0
+    bcc(0x6600, 'frame')                    # bne
+    move_w_imm_abs(0x0100, Z80_BUSREQ)
+    a.label('waitbus')
+    a.word(0x3039); a.long(Z80_BUSREQ)
+    a.word(0x0800, 0x0008)                  # btst #8,d0
+    bcc(0x6600, 'waitbus')
+    a.word(0x13fc, 0x00a4); a.long(YM_ADDR)
+    a.word(0x3007, 0xea48)                  # move.w d7,d0; lsr.w #5,d0
+    a.word(0x0240, 0x0007, 0x0040, 0x0020)  # and.w #7,d0; or.w #$20,d0
+    a.word(0x13c0); a.long(YM_DATA)         # move.b d0,YM_DATA
+    a.word(0x13fc, 0x00a0); a.long(YM_ADDR)
+    a.word(0x13fc, 0x0069); a.long(YM_DATA)
+    move_w_imm_abs(0x0000, Z80_BUSREQ)
+    bcc(0x6000, 'frame')                    # bra
+
+    a.label('exception')
+    a.word(0x4e73)                          # rte
+    return a.link(), a.labels['exception']
+
+
+# FM channel 1: algorithm 7 with only operator 1 audible, sustaining forever
+YM_REGISTERS = [
+    (0x22, 0x00), (0x27, 0x00), (0x28, 0x00), (0x2b, 0x00),
+    (0x30, 0x01), (0x34, 0x01), (0x38, 0x01), (0x3c, 0x01),
+    (0x40, 0x18), (0x44, 0x7f), (0x48, 0x7f), (0x4c, 0x7f),
+    (0x50, 0x1f), (0x54, 0x1f), (0x58, 0x1f), (0x5c, 0x1f),
+    (0x60, 0x00), (0x64, 0x00), (0x68, 0x00), (0x6c, 0x00),
+    (0x70, 0x00), (0x74, 0x00), (0x78, 0x00), (0x7c, 0x00),
+    (0x80, 0x0f), (0x84, 0x0f), (0x88, 0x0f), (0x8c, 0x0f),
+    (0x90, 0x00), (0x94, 0x00), (0x98, 0x00), (0x9c, 0x00),
+    (0xb0, 0x07), (0xb4, 0xc0), (0xa4, 0x22), (0xa0, 0x69),
+    (0x28, 0xf0),
+]
+
+# display on, H40, planes at $c000/$e000, sprites at $f800, scroll at $fc00
+VDP_REGISTERS = [
+    0x8004, 0x8144, 0x8230, 0x8334, 0x8407, 0x857c, 0x8700, 0x8aff,
+    0x8b00, 0x8c81, 0x8d3f, 0x8f02, 0x9001, 0x9100, 0x9200,
+]
+
+PALETTE_COLOURS = [
+    0x0000, 0x0eee, 0x000e, 0x00e0, 0x0e00, 0x00ee, 0x0e0e, 0x0ee0,
+    0x0888, 0x0008, 0x0080, 0x0800, 0x0088, 0x0808, 0x0880, 0x0444,
+]
+
+
+def genesis():
+    code, exception = genesis_68k()
+    rom = bytearray(0x8000)
+
+    # vectors: stack, reset, and everything else to an rte
+    struct.pack_into('>II', rom, 0, 0x00fffe00, 0x200)
+    for vector in range(2, 64):
+        struct.pack_into('>I', rom, vector * 4, exception)
+
+    # header
+    rom[0x100:0x110] = b'SEGA MEGA DRIVE '
+    rom[0x120:0x150] = b'JSMESS GOLDEN TEST'.ljust(0x30)
+    rom[0x150:0x180] = b'JSMESS GOLDEN TEST'.ljust(0x30)
+    struct.pack_into('>II', rom, 0x1a0, 0, len(rom) - 1)
+    struct.pack_into('>II', rom, 0x1a8, 0xff0000, 0xffffff)
+
+    assert 0x200 + len(code) <= Z80_PROGRAM
+    rom[0x200:0x200 + len(code)] = code
+    z80 = genesis_z80()
+    rom[Z80_PROGRAM:Z80_PROGRAM + len(z80)] = z80
+    for index, (register, value) in enumerate(YM_REGISTERS):
+        rom[YM_TABLE + index * 2] = register
+        rom[YM_TABLE + index * 2 + 1] = value
+    for index, value in enumerate(VDP_REGISTERS):
+        struct.pack_into('>H', rom, VDP_TABLE + index * 2, value)
+    for index, value in enumerate(PALETTE_COLOURS):
+        struct.pack_into('>H', rom, PALETTE + index * 2, value)
+    return rom
+
+
+if __name__ == '__main__':
+    outdir = sys.argv[1] if len(sys.argv) > 1 else os.path.dirname(os.path.abspath(__file__))
+    for name, rom in (('atari2600.a26', atari2600()), ('genesis.bin', genesis())):
+        with open(os.path.join(outdir, name), 'wb') as out:
+            out.write(rom)